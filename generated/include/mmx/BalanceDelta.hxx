@@ -0,0 +1,89 @@
+
+// AUTO GENERATED by vnxcppcodegen
+
+#ifndef INCLUDE_mmx_BalanceDelta_HXX_
+#define INCLUDE_mmx_BalanceDelta_HXX_
+
+#include <mmx/package.hxx>
+#include <mmx/addr_t.hpp>
+#include <mmx/hash_t.hpp>
+#include <mmx/txio_entry_t.hxx>
+#include <vnx/Value.h>
+
+
+namespace mmx {
+
+class MMX_EXPORT BalanceDelta : public ::vnx::Value {
+public:
+	
+	uint32_t height = 0;
+	::mmx::hash_t hash;
+	::mmx::hash_t prev;
+	std::vector<::mmx::txio_entry_t> inputs;
+	std::vector<::mmx::txio_entry_t> outputs;
+	std::vector<::mmx::addr_t> external;
+	
+	typedef ::vnx::Value Super;
+	
+	static const vnx::Hash64 VNX_TYPE_HASH;
+	static const vnx::Hash64 VNX_CODE_HASH;
+	
+	static constexpr uint64_t VNX_TYPE_ID = 0x52bf80a78e7e8601ull;
+	
+	BalanceDelta() {}
+	
+	vnx::Hash64 get_type_hash() const override;
+	std::string get_type_name() const override;
+	const vnx::TypeCode* get_type_code() const override;
+	
+	static std::shared_ptr<BalanceDelta> create();
+	std::shared_ptr<vnx::Value> clone() const override;
+	
+	void read(vnx::TypeInput& _in, const vnx::TypeCode* _type_code, const uint16_t* _code) override;
+	void write(vnx::TypeOutput& _out, const vnx::TypeCode* _type_code, const uint16_t* _code) const override;
+	
+	void read(std::istream& _in) override;
+	void write(std::ostream& _out) const override;
+	
+	template<typename T>
+	void accept_generic(T& _visitor) const;
+	void accept(vnx::Visitor& _visitor) const override;
+	
+	vnx::Object to_object() const override;
+	void from_object(const vnx::Object& object) override;
+	
+	vnx::Variant get_field(const std::string& name) const override;
+	void set_field(const std::string& name, const vnx::Variant& value) override;
+	
+	friend std::ostream& operator<<(std::ostream& _out, const BalanceDelta& _value);
+	friend std::istream& operator>>(std::istream& _in, BalanceDelta& _value);
+	
+	static const vnx::TypeCode* static_get_type_code();
+	static std::shared_ptr<vnx::TypeCode> static_create_type_code();
+	
+protected:
+	std::shared_ptr<vnx::Value> vnx_call_switch(std::shared_ptr<const vnx::Value> _method) override;
+	
+};
+
+template<typename T>
+void BalanceDelta::accept_generic(T& _visitor) const {
+	_visitor.template type_begin<BalanceDelta>(6);
+	_visitor.type_field("height", 0); _visitor.accept(height);
+	_visitor.type_field("hash", 1); _visitor.accept(hash);
+	_visitor.type_field("prev", 2); _visitor.accept(prev);
+	_visitor.type_field("inputs", 3); _visitor.accept(inputs);
+	_visitor.type_field("outputs", 4); _visitor.accept(outputs);
+	_visitor.type_field("external", 5); _visitor.accept(external);
+	_visitor.template type_end<BalanceDelta>(6);
+}
+
+
+} // namespace mmx
+
+
+namespace vnx {
+
+} // vnx
+
+#endif // INCLUDE_mmx_BalanceDelta_HXX_
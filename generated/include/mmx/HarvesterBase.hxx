@@ -38,6 +38,8 @@ public:
 	uint32_t max_recursion = 4;
 	vnx::bool_t recursive_search = true;
 	vnx::bool_t farm_virtual_plots = true;
+	uint32_t max_open_files = 0;
+	vnx::bool_t build_y_index = false;
 	
 	typedef ::vnx::Module Super;
 	
@@ -92,7 +94,7 @@ protected:
 
 template<typename T>
 void HarvesterBase::accept_generic(T& _visitor) const {
-	_visitor.template type_begin<HarvesterBase>(19);
+	_visitor.template type_begin<HarvesterBase>(21);
 	_visitor.type_field("input_challenges", 0); _visitor.accept(input_challenges);
 	_visitor.type_field("output_info", 1); _visitor.accept(output_info);
 	_visitor.type_field("output_proofs", 2); _visitor.accept(output_proofs);
@@ -112,7 +114,9 @@ void HarvesterBase::accept_generic(T& _visitor) const {
 	_visitor.type_field("max_recursion", 16); _visitor.accept(max_recursion);
 	_visitor.type_field("recursive_search", 17); _visitor.accept(recursive_search);
 	_visitor.type_field("farm_virtual_plots", 18); _visitor.accept(farm_virtual_plots);
-	_visitor.template type_end<HarvesterBase>(19);
+	_visitor.type_field("max_open_files", 19); _visitor.accept(max_open_files);
+	_visitor.type_field("build_y_index", 20); _visitor.accept(build_y_index);
+	_visitor.template type_end<HarvesterBase>(21);
 }
 
 
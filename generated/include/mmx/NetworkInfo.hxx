@@ -32,6 +32,9 @@ public:
 	std::string name;
 	std::string node_commit;
 	std::string node_version;
+	uint32_t tx_pool_size = 0;
+	uint64_t tx_pool_bytes = 0;
+	uint64_t tx_pool_evicted = 0;
 	
 	typedef ::vnx::Value Super;
 	
@@ -78,7 +81,7 @@ protected:
 
 template<typename T>
 void NetworkInfo::accept_generic(T& _visitor) const {
-	_visitor.template type_begin<NetworkInfo>(18);
+	_visitor.template type_begin<NetworkInfo>(21);
 	_visitor.type_field("is_synced", 0); _visitor.accept(is_synced);
 	_visitor.type_field("height", 1); _visitor.accept(height);
 	_visitor.type_field("vdf_height", 2); _visitor.accept(vdf_height);
@@ -97,7 +100,10 @@ void NetworkInfo::accept_generic(T& _visitor) const {
 	_visitor.type_field("name", 15); _visitor.accept(name);
 	_visitor.type_field("node_commit", 16); _visitor.accept(node_commit);
 	_visitor.type_field("node_version", 17); _visitor.accept(node_version);
-	_visitor.template type_end<NetworkInfo>(18);
+	_visitor.type_field("tx_pool_size", 18); _visitor.accept(tx_pool_size);
+	_visitor.type_field("tx_pool_bytes", 19); _visitor.accept(tx_pool_bytes);
+	_visitor.type_field("tx_pool_evicted", 20); _visitor.accept(tx_pool_evicted);
+	_visitor.template type_end<NetworkInfo>(21);
 }
 
 
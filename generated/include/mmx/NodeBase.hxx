@@ -73,6 +73,7 @@ public:
 	int32_t sync_loss_delay = 60;
 	uint32_t max_history = 1000;
 	uint32_t max_tx_pool = 100;
+	uint32_t max_tx_pool_mem = 512;
 	uint32_t max_tx_queue = 10000;
 	uint32_t max_sync_jobs = 64;
 	uint32_t max_sync_ahead = 1000;
@@ -97,6 +98,12 @@ public:
 	std::string database_path = "db/";
 	std::string router_name = "Router";
 	::mmx::addr_t mmx_usd_swap_addr;
+	uint32_t db_cache_size = 256;
+	uint32_t vm_cache_size = 256;
+	vnx::bool_t exec_optimistic = 0;
+	uint32_t checkpoint_height = 0;
+	::mmx::hash_t checkpoint_hash;
+	::vnx::TopicPtr output_balance_deltas = "node.balance_deltas";
 	
 	typedef ::vnx::Module Super;
 	
@@ -209,6 +216,7 @@ protected:
 	virtual std::tuple<::mmx::pooling_error_e, std::string> verify_partial(std::shared_ptr<const ::mmx::Partial> partial, const vnx::optional<::mmx::addr_t>& pool_target) const = 0;
 	virtual void start_sync(const vnx::bool_t& force) = 0;
 	virtual void revert_sync(const uint32_t& height) = 0;
+	virtual void watch_balances(const std::vector<::mmx::addr_t>& addresses, const ::mmx::hash_t& client) = 0;
 	virtual void handle(std::shared_ptr<const ::mmx::Block> _value) {}
 	virtual void handle(std::shared_ptr<const ::mmx::Transaction> _value) {}
 	virtual void handle(std::shared_ptr<const ::mmx::ProofOfTime> _value) {}
@@ -227,7 +235,7 @@ protected:
 
 template<typename T>
 void NodeBase::accept_generic(T& _visitor) const {
-	_visitor.template type_begin<NodeBase>(49);
+	_visitor.template type_begin<NodeBase>(56);
 	_visitor.type_field("input_vdfs", 0); _visitor.accept(input_vdfs);
 	_visitor.type_field("input_votes", 1); _visitor.accept(input_votes);
 	_visitor.type_field("input_proof", 2); _visitor.accept(input_proof);
@@ -253,31 +261,38 @@ void NodeBase::accept_generic(T& _visitor) const {
 	_visitor.type_field("sync_loss_delay", 22); _visitor.accept(sync_loss_delay);
 	_visitor.type_field("max_history", 23); _visitor.accept(max_history);
 	_visitor.type_field("max_tx_pool", 24); _visitor.accept(max_tx_pool);
-	_visitor.type_field("max_tx_queue", 25); _visitor.accept(max_tx_queue);
-	_visitor.type_field("max_sync_jobs", 26); _visitor.accept(max_sync_jobs);
-	_visitor.type_field("max_sync_ahead", 27); _visitor.accept(max_sync_ahead);
-	_visitor.type_field("num_sync_retries", 28); _visitor.accept(num_sync_retries);
-	_visitor.type_field("revert_height", 29); _visitor.accept(revert_height);
-	_visitor.type_field("num_threads", 30); _visitor.accept(num_threads);
-	_visitor.type_field("num_db_threads", 31); _visitor.accept(num_db_threads);
-	_visitor.type_field("num_api_threads", 32); _visitor.accept(num_api_threads);
-	_visitor.type_field("commit_threshold", 33); _visitor.accept(commit_threshold);
-	_visitor.type_field("max_future_sync", 34); _visitor.accept(max_future_sync);
-	_visitor.type_field("max_vdf_verify_pending", 35); _visitor.accept(max_vdf_verify_pending);
-	_visitor.type_field("opencl_device", 36); _visitor.accept(opencl_device);
-	_visitor.type_field("opencl_device_name", 37); _visitor.accept(opencl_device_name);
-	_visitor.type_field("do_sync", 38); _visitor.accept(do_sync);
-	_visitor.type_field("show_warnings", 39); _visitor.accept(show_warnings);
-	_visitor.type_field("vdf_slave_mode", 40); _visitor.accept(vdf_slave_mode);
-	_visitor.type_field("run_tests", 41); _visitor.accept(run_tests);
-	_visitor.type_field("exec_debug", 42); _visitor.accept(exec_debug);
-	_visitor.type_field("exec_profile", 43); _visitor.accept(exec_profile);
-	_visitor.type_field("exec_trace", 44); _visitor.accept(exec_trace);
-	_visitor.type_field("storage_path", 45); _visitor.accept(storage_path);
-	_visitor.type_field("database_path", 46); _visitor.accept(database_path);
-	_visitor.type_field("router_name", 47); _visitor.accept(router_name);
-	_visitor.type_field("mmx_usd_swap_addr", 48); _visitor.accept(mmx_usd_swap_addr);
-	_visitor.template type_end<NodeBase>(49);
+	_visitor.type_field("max_tx_pool_mem", 25); _visitor.accept(max_tx_pool_mem);
+	_visitor.type_field("max_tx_queue", 26); _visitor.accept(max_tx_queue);
+	_visitor.type_field("max_sync_jobs", 27); _visitor.accept(max_sync_jobs);
+	_visitor.type_field("max_sync_ahead", 28); _visitor.accept(max_sync_ahead);
+	_visitor.type_field("num_sync_retries", 29); _visitor.accept(num_sync_retries);
+	_visitor.type_field("revert_height", 30); _visitor.accept(revert_height);
+	_visitor.type_field("num_threads", 31); _visitor.accept(num_threads);
+	_visitor.type_field("num_db_threads", 32); _visitor.accept(num_db_threads);
+	_visitor.type_field("num_api_threads", 33); _visitor.accept(num_api_threads);
+	_visitor.type_field("commit_threshold", 34); _visitor.accept(commit_threshold);
+	_visitor.type_field("max_future_sync", 35); _visitor.accept(max_future_sync);
+	_visitor.type_field("max_vdf_verify_pending", 36); _visitor.accept(max_vdf_verify_pending);
+	_visitor.type_field("opencl_device", 37); _visitor.accept(opencl_device);
+	_visitor.type_field("opencl_device_name", 38); _visitor.accept(opencl_device_name);
+	_visitor.type_field("do_sync", 39); _visitor.accept(do_sync);
+	_visitor.type_field("show_warnings", 40); _visitor.accept(show_warnings);
+	_visitor.type_field("vdf_slave_mode", 41); _visitor.accept(vdf_slave_mode);
+	_visitor.type_field("run_tests", 42); _visitor.accept(run_tests);
+	_visitor.type_field("exec_debug", 43); _visitor.accept(exec_debug);
+	_visitor.type_field("exec_profile", 44); _visitor.accept(exec_profile);
+	_visitor.type_field("exec_trace", 45); _visitor.accept(exec_trace);
+	_visitor.type_field("storage_path", 46); _visitor.accept(storage_path);
+	_visitor.type_field("database_path", 47); _visitor.accept(database_path);
+	_visitor.type_field("router_name", 48); _visitor.accept(router_name);
+	_visitor.type_field("mmx_usd_swap_addr", 49); _visitor.accept(mmx_usd_swap_addr);
+	_visitor.type_field("db_cache_size", 50); _visitor.accept(db_cache_size);
+	_visitor.type_field("vm_cache_size", 51); _visitor.accept(vm_cache_size);
+	_visitor.type_field("exec_optimistic", 52); _visitor.accept(exec_optimistic);
+	_visitor.type_field("checkpoint_height", 53); _visitor.accept(checkpoint_height);
+	_visitor.type_field("checkpoint_hash", 54); _visitor.accept(checkpoint_hash);
+	_visitor.type_field("output_balance_deltas", 55); _visitor.accept(output_balance_deltas);
+	_visitor.template type_end<NodeBase>(56);
 }
 
 
@@ -211,6 +211,10 @@ public:
 	
 	void revert_sync_async(const uint32_t& height = 0);
 	
+	void watch_balances(const std::vector<::mmx::addr_t>& addresses = {}, const ::mmx::hash_t& client = ::mmx::hash_t());
+	
+	void watch_balances_async(const std::vector<::mmx::addr_t>& addresses = {}, const ::mmx::hash_t& client = ::mmx::hash_t());
+	
 	std::shared_ptr<const ::vnx::addons::HttpResponse> http_request(std::shared_ptr<const ::vnx::addons::HttpRequest> request = nullptr, const std::string& sub_path = "");
 	
 	std::shared_ptr<const ::vnx::addons::HttpData> http_request_chunk(std::shared_ptr<const ::vnx::addons::HttpRequest> request = nullptr, const std::string& sub_path = "", const int64_t& offset = 0, const int64_t& max_bytes = 0);
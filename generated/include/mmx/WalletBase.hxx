@@ -5,6 +5,7 @@
 #define INCLUDE_mmx_WalletBase_HXX_
 
 #include <mmx/package.hxx>
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/Contract.hxx>
 #include <mmx/KeyFile.hxx>
 #include <mmx/Solution.hxx>
@@ -48,6 +49,8 @@ public:
 	int32_t lock_timeout_sec = 600;
 	int32_t cache_timeout_ms = 1000;
 	std::set<::mmx::addr_t> token_whitelist;
+	::vnx::TopicPtr input_balance_deltas = "node.balance_deltas";
+	int32_t cache_refresh_ms = 60000;
 	
 	typedef ::vnx::Module Super;
 	
@@ -144,6 +147,7 @@ protected:
 	virtual std::vector<std::string> get_mnemonic_seed(const uint32_t& index) const = 0;
 	virtual std::pair<::mmx::skey_t, ::mmx::pubkey_t> get_farmer_keys(const uint32_t& index) const = 0;
 	virtual std::vector<std::pair<::mmx::skey_t, ::mmx::pubkey_t>> get_all_farmer_keys() const = 0;
+	virtual void handle(std::shared_ptr<const ::mmx::BalanceDelta> _value) {}
 	virtual void http_request_async(std::shared_ptr<const ::vnx::addons::HttpRequest> request, const std::string& sub_path, const vnx::request_id_t& _request_id) const = 0;
 	void http_request_async_return(const vnx::request_id_t& _request_id, const std::shared_ptr<const ::vnx::addons::HttpResponse>& _ret_0) const;
 	virtual void http_request_chunk_async(std::shared_ptr<const ::vnx::addons::HttpRequest> request, const std::string& sub_path, const int64_t& offset, const int64_t& max_bytes, const vnx::request_id_t& _request_id) const = 0;
@@ -156,7 +160,7 @@ protected:
 
 template<typename T>
 void WalletBase::accept_generic(T& _visitor) const {
-	_visitor.template type_begin<WalletBase>(13);
+	_visitor.template type_begin<WalletBase>(15);
 	_visitor.type_field("key_files", 0); _visitor.accept(key_files);
 	_visitor.type_field("accounts", 1); _visitor.accept(accounts);
 	_visitor.type_field("config_path", 2); _visitor.accept(config_path);
@@ -170,7 +174,9 @@ void WalletBase::accept_generic(T& _visitor) const {
 	_visitor.type_field("lock_timeout_sec", 10); _visitor.accept(lock_timeout_sec);
 	_visitor.type_field("cache_timeout_ms", 11); _visitor.accept(cache_timeout_ms);
 	_visitor.type_field("token_whitelist", 12); _visitor.accept(token_whitelist);
-	_visitor.template type_end<WalletBase>(13);
+	_visitor.type_field("input_balance_deltas", 13); _visitor.accept(input_balance_deltas);
+	_visitor.type_field("cache_refresh_ms", 14); _visitor.accept(cache_refresh_ms);
+	_visitor.template type_end<WalletBase>(15);
 }
 
 
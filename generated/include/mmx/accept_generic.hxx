@@ -4,6 +4,7 @@
 #ifndef INCLUDE_mmx_ACCEPT_GENERIC_HXX_
 #define INCLUDE_mmx_ACCEPT_GENERIC_HXX_
 
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/Block.hxx>
 #include <mmx/BlockHeader.hxx>
 #include <mmx/ChainParams.hxx>
@@ -190,6 +191,8 @@
 #include <mmx/Node_verify_partial_return.hxx>
 #include <mmx/Node_verify_plot_nft_target.hxx>
 #include <mmx/Node_verify_plot_nft_target_return.hxx>
+#include <mmx/Node_watch_balances.hxx>
+#include <mmx/Node_watch_balances_return.hxx>
 #include <mmx/Operation.hxx>
 #include <mmx/Partial.hxx>
 #include <mmx/PeerInfo.hxx>
@@ -363,6 +366,15 @@
 
 namespace vnx {
 
+template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::BalanceDelta> value) {
+	if(value) {
+		value->accept_generic(visitor);
+	} else {
+		visitor.accept(nullptr);
+	}
+}
+
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Block> value) {
 	if(value) {
@@ -2041,6 +2053,24 @@ void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_verify_plot_nf
 	}
 }
 
+template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_watch_balances> value) {
+	if(value) {
+		value->accept_generic(visitor);
+	} else {
+		visitor.accept(nullptr);
+	}
+}
+
+template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_watch_balances_return> value) {
+	if(value) {
+		value->accept_generic(visitor);
+	} else {
+		visitor.accept(nullptr);
+	}
+}
+
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Operation> value) {
 	if(value) {
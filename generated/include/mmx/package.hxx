@@ -24,6 +24,7 @@ namespace mmx {
 void register_all_types();
 
 
+class BalanceDelta;
 class Block;
 class BlockHeader;
 class ChainParams;
@@ -213,6 +214,8 @@ class Node_verify_partial;
 class Node_verify_partial_return;
 class Node_verify_plot_nft_target;
 class Node_verify_plot_nft_target_return;
+class Node_watch_balances;
+class Node_watch_balances_return;
 class Operation;
 class Partial;
 class PeerInfo;
@@ -437,6 +440,7 @@ struct uint_fraction_t;
 struct ulong_fraction_t;
 struct virtual_plot_info_t;
 
+MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_BalanceDelta; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Block; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_BlockHeader; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_ChainParams; ///< \private
@@ -626,6 +630,8 @@ MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_verify_pa
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_verify_partial_return; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_verify_plot_nft_target; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_verify_plot_nft_target_return; ///< \private
+MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_watch_balances; ///< \private
+MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Node_watch_balances_return; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Operation; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_Partial; ///< \private
 MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_PeerInfo; ///< \private
@@ -847,6 +853,7 @@ MMX_EXPORT extern const vnx::TypeCode* const vnx_native_type_code_virtual_plot_i
 
 namespace vnx {
 
+void read(TypeInput& in, ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::Block& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::BlockHeader& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::ChainParams& value, const TypeCode* type_code, const uint16_t* code); ///< \private
@@ -1036,6 +1043,8 @@ void read(TypeInput& in, ::mmx::Node_verify_partial& value, const TypeCode* type
 void read(TypeInput& in, ::mmx::Node_verify_partial_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::Node_verify_plot_nft_target& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::Node_verify_plot_nft_target_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
+void read(TypeInput& in, ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code); ///< \private
+void read(TypeInput& in, ::mmx::Node_watch_balances_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::Operation& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::Partial& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::PeerInfo& value, const TypeCode* type_code, const uint16_t* code); ///< \private
@@ -1260,6 +1269,7 @@ void read(TypeInput& in, ::mmx::uint_fraction_t& value, const TypeCode* type_cod
 void read(TypeInput& in, ::mmx::ulong_fraction_t& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void read(TypeInput& in, ::mmx::virtual_plot_info_t& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 
+void write(TypeOutput& out, const ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::Block& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::BlockHeader& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::ChainParams& value, const TypeCode* type_code, const uint16_t* code); ///< \private
@@ -1449,6 +1459,8 @@ void write(TypeOutput& out, const ::mmx::Node_verify_partial& value, const TypeC
 void write(TypeOutput& out, const ::mmx::Node_verify_partial_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::Node_verify_plot_nft_target& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::Node_verify_plot_nft_target_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
+void write(TypeOutput& out, const ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code); ///< \private
+void write(TypeOutput& out, const ::mmx::Node_watch_balances_return& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::Operation& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::Partial& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::PeerInfo& value, const TypeCode* type_code, const uint16_t* code); ///< \private
@@ -1673,6 +1685,7 @@ void write(TypeOutput& out, const ::mmx::uint_fraction_t& value, const TypeCode*
 void write(TypeOutput& out, const ::mmx::ulong_fraction_t& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 void write(TypeOutput& out, const ::mmx::virtual_plot_info_t& value, const TypeCode* type_code, const uint16_t* code); ///< \private
 
+void read(std::istream& in, ::mmx::BalanceDelta& value); ///< \private
 void read(std::istream& in, ::mmx::Block& value); ///< \private
 void read(std::istream& in, ::mmx::BlockHeader& value); ///< \private
 void read(std::istream& in, ::mmx::ChainParams& value); ///< \private
@@ -1862,6 +1875,8 @@ void read(std::istream& in, ::mmx::Node_verify_partial& value); ///< \private
 void read(std::istream& in, ::mmx::Node_verify_partial_return& value); ///< \private
 void read(std::istream& in, ::mmx::Node_verify_plot_nft_target& value); ///< \private
 void read(std::istream& in, ::mmx::Node_verify_plot_nft_target_return& value); ///< \private
+void read(std::istream& in, ::mmx::Node_watch_balances& value); ///< \private
+void read(std::istream& in, ::mmx::Node_watch_balances_return& value); ///< \private
 void read(std::istream& in, ::mmx::Operation& value); ///< \private
 void read(std::istream& in, ::mmx::Partial& value); ///< \private
 void read(std::istream& in, ::mmx::PeerInfo& value); ///< \private
@@ -2086,6 +2101,7 @@ void read(std::istream& in, ::mmx::uint_fraction_t& value); ///< \private
 void read(std::istream& in, ::mmx::ulong_fraction_t& value); ///< \private
 void read(std::istream& in, ::mmx::virtual_plot_info_t& value); ///< \private
 
+void write(std::ostream& out, const ::mmx::BalanceDelta& value); ///< \private
 void write(std::ostream& out, const ::mmx::Block& value); ///< \private
 void write(std::ostream& out, const ::mmx::BlockHeader& value); ///< \private
 void write(std::ostream& out, const ::mmx::ChainParams& value); ///< \private
@@ -2275,6 +2291,8 @@ void write(std::ostream& out, const ::mmx::Node_verify_partial& value); ///< \pr
 void write(std::ostream& out, const ::mmx::Node_verify_partial_return& value); ///< \private
 void write(std::ostream& out, const ::mmx::Node_verify_plot_nft_target& value); ///< \private
 void write(std::ostream& out, const ::mmx::Node_verify_plot_nft_target_return& value); ///< \private
+void write(std::ostream& out, const ::mmx::Node_watch_balances& value); ///< \private
+void write(std::ostream& out, const ::mmx::Node_watch_balances_return& value); ///< \private
 void write(std::ostream& out, const ::mmx::Operation& value); ///< \private
 void write(std::ostream& out, const ::mmx::Partial& value); ///< \private
 void write(std::ostream& out, const ::mmx::PeerInfo& value); ///< \private
@@ -2499,6 +2517,7 @@ void write(std::ostream& out, const ::mmx::uint_fraction_t& value); ///< \privat
 void write(std::ostream& out, const ::mmx::ulong_fraction_t& value); ///< \private
 void write(std::ostream& out, const ::mmx::virtual_plot_info_t& value); ///< \private
 
+void accept(Visitor& visitor, const ::mmx::BalanceDelta& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::Block& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::BlockHeader& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::ChainParams& value); ///< \private
@@ -2688,6 +2707,8 @@ void accept(Visitor& visitor, const ::mmx::Node_verify_partial& value); ///< \pr
 void accept(Visitor& visitor, const ::mmx::Node_verify_partial_return& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::Node_verify_plot_nft_target& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::Node_verify_plot_nft_target_return& value); ///< \private
+void accept(Visitor& visitor, const ::mmx::Node_watch_balances& value); ///< \private
+void accept(Visitor& visitor, const ::mmx::Node_watch_balances_return& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::Operation& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::Partial& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::PeerInfo& value); ///< \private
@@ -2912,6 +2933,8 @@ void accept(Visitor& visitor, const ::mmx::uint_fraction_t& value); ///< \privat
 void accept(Visitor& visitor, const ::mmx::ulong_fraction_t& value); ///< \private
 void accept(Visitor& visitor, const ::mmx::virtual_plot_info_t& value); ///< \private
 
+template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::BalanceDelta> value); ///< \private
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Block> value); ///< \private
 template<typename V>
@@ -3285,6 +3308,10 @@ void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_verify_plot_nf
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_verify_plot_nft_target_return> value); ///< \private
 template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_watch_balances> value); ///< \private
+template<typename V>
+void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Node_watch_balances_return> value); ///< \private
+template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Operation> value); ///< \private
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::Partial> value); ///< \private
@@ -3623,6 +3650,29 @@ void accept_generic(V& visitor, std::shared_ptr<const ::mmx::WebAPI_shutdown_ret
 template<typename V>
 void accept_generic(V& visitor, std::shared_ptr<const ::mmx::tx_info_t> value); ///< \private
 
+/// \private
+template<>
+struct type<::mmx::BalanceDelta> {
+	void read(TypeInput& in, ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::read(in, value, type_code, code);
+	}
+	void write(TypeOutput& out, const ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::write(out, value, type_code, code);
+	}
+	void read(std::istream& in, ::mmx::BalanceDelta& value) {
+		vnx::read(in, value);
+	}
+	void write(std::ostream& out, const ::mmx::BalanceDelta& value) {
+		vnx::write(out, value);
+	}
+	void accept(Visitor& visitor, const ::mmx::BalanceDelta& value) {
+		vnx::accept(visitor, value);
+	}
+	const TypeCode* get_type_code();
+	void create_dynamic_code(std::vector<uint16_t>& code);
+	void create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::BalanceDelta& value, bool special = false);
+};
+
 /// \private
 template<>
 struct type<::mmx::Block> {
@@ -7961,6 +8011,52 @@ struct type<::mmx::Node_verify_plot_nft_target_return> {
 	void create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::Node_verify_plot_nft_target_return& value, bool special = false);
 };
 
+/// \private
+template<>
+struct type<::mmx::Node_watch_balances> {
+	void read(TypeInput& in, ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::read(in, value, type_code, code);
+	}
+	void write(TypeOutput& out, const ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::write(out, value, type_code, code);
+	}
+	void read(std::istream& in, ::mmx::Node_watch_balances& value) {
+		vnx::read(in, value);
+	}
+	void write(std::ostream& out, const ::mmx::Node_watch_balances& value) {
+		vnx::write(out, value);
+	}
+	void accept(Visitor& visitor, const ::mmx::Node_watch_balances& value) {
+		vnx::accept(visitor, value);
+	}
+	const TypeCode* get_type_code();
+	void create_dynamic_code(std::vector<uint16_t>& code);
+	void create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::Node_watch_balances& value, bool special = false);
+};
+
+/// \private
+template<>
+struct type<::mmx::Node_watch_balances_return> {
+	void read(TypeInput& in, ::mmx::Node_watch_balances_return& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::read(in, value, type_code, code);
+	}
+	void write(TypeOutput& out, const ::mmx::Node_watch_balances_return& value, const TypeCode* type_code, const uint16_t* code) {
+		vnx::write(out, value, type_code, code);
+	}
+	void read(std::istream& in, ::mmx::Node_watch_balances_return& value) {
+		vnx::read(in, value);
+	}
+	void write(std::ostream& out, const ::mmx::Node_watch_balances_return& value) {
+		vnx::write(out, value);
+	}
+	void accept(Visitor& visitor, const ::mmx::Node_watch_balances_return& value) {
+		vnx::accept(visitor, value);
+	}
+	const TypeCode* get_type_code();
+	void create_dynamic_code(std::vector<uint16_t>& code);
+	void create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::Node_watch_balances_return& value, bool special = false);
+};
+
 /// \private
 template<>
 struct type<::mmx::Operation> {
@@ -0,0 +1,312 @@
+
+// AUTO GENERATED by vnxcppcodegen
+
+#include <mmx/package.hxx>
+#include <mmx/BalanceDelta.hxx>
+#include <mmx/addr_t.hpp>
+#include <mmx/hash_t.hpp>
+#include <mmx/txio_entry_t.hxx>
+#include <vnx/Value.h>
+
+#include <vnx/vnx.h>
+
+
+namespace mmx {
+
+
+const vnx::Hash64 BalanceDelta::VNX_TYPE_HASH(0x52bf80a78e7e8601ull);
+const vnx::Hash64 BalanceDelta::VNX_CODE_HASH(0x5c14e8b3d9a7206full);
+
+vnx::Hash64 BalanceDelta::get_type_hash() const {
+	return VNX_TYPE_HASH;
+}
+
+std::string BalanceDelta::get_type_name() const {
+	return "mmx.BalanceDelta";
+}
+
+const vnx::TypeCode* BalanceDelta::get_type_code() const {
+	return mmx::vnx_native_type_code_BalanceDelta;
+}
+
+std::shared_ptr<BalanceDelta> BalanceDelta::create() {
+	return std::make_shared<BalanceDelta>();
+}
+
+std::shared_ptr<vnx::Value> BalanceDelta::clone() const {
+	return std::make_shared<BalanceDelta>(*this);
+}
+
+void BalanceDelta::read(vnx::TypeInput& _in, const vnx::TypeCode* _type_code, const uint16_t* _code) {
+	vnx::read(_in, *this, _type_code, _code);
+}
+
+void BalanceDelta::write(vnx::TypeOutput& _out, const vnx::TypeCode* _type_code, const uint16_t* _code) const {
+	vnx::write(_out, *this, _type_code, _code);
+}
+
+void BalanceDelta::accept(vnx::Visitor& _visitor) const {
+	const vnx::TypeCode* _type_code = mmx::vnx_native_type_code_BalanceDelta;
+	_visitor.type_begin(*_type_code);
+	_visitor.type_field(_type_code->fields[0], 0); vnx::accept(_visitor, height);
+	_visitor.type_field(_type_code->fields[1], 1); vnx::accept(_visitor, hash);
+	_visitor.type_field(_type_code->fields[2], 2); vnx::accept(_visitor, prev);
+	_visitor.type_field(_type_code->fields[3], 3); vnx::accept(_visitor, inputs);
+	_visitor.type_field(_type_code->fields[4], 4); vnx::accept(_visitor, outputs);
+	_visitor.type_field(_type_code->fields[5], 5); vnx::accept(_visitor, external);
+	_visitor.type_end(*_type_code);
+}
+
+void BalanceDelta::write(std::ostream& _out) const {
+	_out << "{\"__type\": \"mmx.BalanceDelta\"";
+	_out << ", \"height\": "; vnx::write(_out, height);
+	_out << ", \"hash\": "; vnx::write(_out, hash);
+	_out << ", \"prev\": "; vnx::write(_out, prev);
+	_out << ", \"inputs\": "; vnx::write(_out, inputs);
+	_out << ", \"outputs\": "; vnx::write(_out, outputs);
+	_out << ", \"external\": "; vnx::write(_out, external);
+	_out << "}";
+}
+
+void BalanceDelta::read(std::istream& _in) {
+	if(auto _json = vnx::read_json(_in)) {
+		from_object(_json->to_object());
+	}
+}
+
+vnx::Object BalanceDelta::to_object() const {
+	vnx::Object _object;
+	_object["__type"] = "mmx.BalanceDelta";
+	_object["height"] = height;
+	_object["hash"] = hash;
+	_object["prev"] = prev;
+	_object["inputs"] = inputs;
+	_object["outputs"] = outputs;
+	_object["external"] = external;
+	return _object;
+}
+
+void BalanceDelta::from_object(const vnx::Object& _object) {
+	for(const auto& _entry : _object.field) {
+		if(_entry.first == "external") {
+			_entry.second.to(external);
+		} else if(_entry.first == "hash") {
+			_entry.second.to(hash);
+		} else if(_entry.first == "height") {
+			_entry.second.to(height);
+		} else if(_entry.first == "inputs") {
+			_entry.second.to(inputs);
+		} else if(_entry.first == "outputs") {
+			_entry.second.to(outputs);
+		} else if(_entry.first == "prev") {
+			_entry.second.to(prev);
+		}
+	}
+}
+
+vnx::Variant BalanceDelta::get_field(const std::string& _name) const {
+	if(_name == "height") {
+		return vnx::Variant(height);
+	}
+	if(_name == "hash") {
+		return vnx::Variant(hash);
+	}
+	if(_name == "prev") {
+		return vnx::Variant(prev);
+	}
+	if(_name == "inputs") {
+		return vnx::Variant(inputs);
+	}
+	if(_name == "outputs") {
+		return vnx::Variant(outputs);
+	}
+	if(_name == "external") {
+		return vnx::Variant(external);
+	}
+	return vnx::Variant();
+}
+
+void BalanceDelta::set_field(const std::string& _name, const vnx::Variant& _value) {
+	if(_name == "height") {
+		_value.to(height);
+	} else if(_name == "hash") {
+		_value.to(hash);
+	} else if(_name == "prev") {
+		_value.to(prev);
+	} else if(_name == "inputs") {
+		_value.to(inputs);
+	} else if(_name == "outputs") {
+		_value.to(outputs);
+	} else if(_name == "external") {
+		_value.to(external);
+	}
+}
+
+/// \private
+std::ostream& operator<<(std::ostream& _out, const BalanceDelta& _value) {
+	_value.write(_out);
+	return _out;
+}
+
+/// \private
+std::istream& operator>>(std::istream& _in, BalanceDelta& _value) {
+	_value.read(_in);
+	return _in;
+}
+
+const vnx::TypeCode* BalanceDelta::static_get_type_code() {
+	const vnx::TypeCode* type_code = vnx::get_type_code(VNX_TYPE_HASH);
+	if(!type_code) {
+		type_code = vnx::register_type_code(static_create_type_code());
+	}
+	return type_code;
+}
+
+std::shared_ptr<vnx::TypeCode> BalanceDelta::static_create_type_code() {
+	auto type_code = std::make_shared<vnx::TypeCode>();
+	type_code->name = "mmx.BalanceDelta";
+	type_code->type_hash = vnx::Hash64(0x52bf80a78e7e8601ull);
+	type_code->code_hash = vnx::Hash64(0x5c14e8b3d9a7206full);
+	type_code->is_native = true;
+	type_code->is_class = true;
+	type_code->native_size = sizeof(::mmx::BalanceDelta);
+	type_code->create_value = []() -> std::shared_ptr<vnx::Value> { return std::make_shared<BalanceDelta>(); };
+	type_code->depends.resize(1);
+	type_code->depends[0] = ::mmx::txio_entry_t::static_get_type_code();
+	type_code->fields.resize(6);
+	{
+		auto& field = type_code->fields[0];
+		field.data_size = 4;
+		field.name = "height";
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[1];
+		field.is_extended = true;
+		field.name = "hash";
+		field.code = {11, 32, 1};
+	}
+	{
+		auto& field = type_code->fields[2];
+		field.is_extended = true;
+		field.name = "prev";
+		field.code = {11, 32, 1};
+	}
+	{
+		auto& field = type_code->fields[3];
+		field.is_extended = true;
+		field.name = "inputs";
+		field.code = {12, 19, 0};
+	}
+	{
+		auto& field = type_code->fields[4];
+		field.is_extended = true;
+		field.name = "outputs";
+		field.code = {12, 19, 0};
+	}
+	{
+		auto& field = type_code->fields[5];
+		field.is_extended = true;
+		field.name = "external";
+		field.code = {12, 11, 32, 1};
+	}
+	type_code->build();
+	return type_code;
+}
+
+std::shared_ptr<vnx::Value> BalanceDelta::vnx_call_switch(std::shared_ptr<const vnx::Value> _method) {
+	switch(_method->get_type_hash()) {
+	}
+	return nullptr;
+}
+
+
+} // namespace mmx
+
+
+namespace vnx {
+
+void read(TypeInput& in, ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code) {
+	TypeInput::recursion_t tag(in);
+	if(code) {
+		switch(code[0]) {
+			case CODE_OBJECT:
+			case CODE_ALT_OBJECT: {
+				Object tmp;
+				vnx::read(in, tmp, type_code, code);
+				value.from_object(tmp);
+				return;
+			}
+			case CODE_DYNAMIC:
+			case CODE_ALT_DYNAMIC:
+				vnx::read_dynamic(in, value);
+				return;
+		}
+	}
+	if(!type_code) {
+		vnx::skip(in, type_code, code);
+		return;
+	}
+	if(code) {
+		switch(code[0]) {
+			case CODE_STRUCT: type_code = type_code->depends[code[1]]; break;
+			case CODE_ALT_STRUCT: type_code = type_code->depends[vnx::flip_bytes(code[1])]; break;
+			default: {
+				vnx::skip(in, type_code, code);
+				return;
+			}
+		}
+	}
+	const auto* const _buf = in.read(type_code->total_field_size);
+	if(type_code->is_matched) {
+		if(const auto* const _field = type_code->field_map[0]) {
+			vnx::read_value(_buf + _field->offset, value.height, _field->code.data());
+		}
+	}
+	for(const auto* _field : type_code->ext_fields) {
+		switch(_field->native_index) {
+			case 1: vnx::read(in, value.hash, type_code, _field->code.data()); break;
+			case 2: vnx::read(in, value.prev, type_code, _field->code.data()); break;
+			case 3: vnx::read(in, value.inputs, type_code, _field->code.data()); break;
+			case 4: vnx::read(in, value.outputs, type_code, _field->code.data()); break;
+			case 5: vnx::read(in, value.external, type_code, _field->code.data()); break;
+			default: vnx::skip(in, type_code, _field->code.data());
+		}
+	}
+}
+
+void write(TypeOutput& out, const ::mmx::BalanceDelta& value, const TypeCode* type_code, const uint16_t* code) {
+	if(code && code[0] == CODE_OBJECT) {
+		vnx::write(out, value.to_object(), nullptr, code);
+		return;
+	}
+	if(!type_code || (code && code[0] == CODE_ANY)) {
+		type_code = mmx::vnx_native_type_code_BalanceDelta;
+		out.write_type_code(type_code);
+		vnx::write_class_header<::mmx::BalanceDelta>(out);
+	}
+	else if(code && code[0] == CODE_STRUCT) {
+		type_code = type_code->depends[code[1]];
+	}
+	auto* const _buf = out.write(4);
+	vnx::write_value(_buf + 0, value.height);
+	vnx::write(out, value.hash, type_code, type_code->fields[1].code.data());
+	vnx::write(out, value.prev, type_code, type_code->fields[2].code.data());
+	vnx::write(out, value.inputs, type_code, type_code->fields[3].code.data());
+	vnx::write(out, value.outputs, type_code, type_code->fields[4].code.data());
+	vnx::write(out, value.external, type_code, type_code->fields[5].code.data());
+}
+
+void read(std::istream& in, ::mmx::BalanceDelta& value) {
+	value.read(in);
+}
+
+void write(std::ostream& out, const ::mmx::BalanceDelta& value) {
+	value.write(out);
+}
+
+void accept(Visitor& visitor, const ::mmx::BalanceDelta& value) {
+	value.accept(visitor);
+}
+
+} // vnx
@@ -51,7 +51,7 @@ namespace mmx {
 
 
 const vnx::Hash64 HarvesterBase::VNX_TYPE_HASH(0xc17118896cde1555ull);
-const vnx::Hash64 HarvesterBase::VNX_CODE_HASH(0x58f3117ab806b859ull);
+const vnx::Hash64 HarvesterBase::VNX_CODE_HASH(0x9c4e1f7b2d60a3e5ull);
 
 HarvesterBase::HarvesterBase(const std::string& _vnx_name)
 	:	Module::Module(_vnx_name)
@@ -75,6 +75,8 @@ HarvesterBase::HarvesterBase(const std::string& _vnx_name)
 	vnx::read_config(vnx_name + ".max_recursion", max_recursion);
 	vnx::read_config(vnx_name + ".recursive_search", recursive_search);
 	vnx::read_config(vnx_name + ".farm_virtual_plots", farm_virtual_plots);
+	vnx::read_config(vnx_name + ".max_open_files", max_open_files);
+	vnx::read_config(vnx_name + ".build_y_index", build_y_index);
 }
 
 vnx::Hash64 HarvesterBase::get_type_hash() const {
@@ -111,6 +113,8 @@ void HarvesterBase::accept(vnx::Visitor& _visitor) const {
 	_visitor.type_field(_type_code->fields[16], 16); vnx::accept(_visitor, max_recursion);
 	_visitor.type_field(_type_code->fields[17], 17); vnx::accept(_visitor, recursive_search);
 	_visitor.type_field(_type_code->fields[18], 18); vnx::accept(_visitor, farm_virtual_plots);
+	_visitor.type_field(_type_code->fields[19], 19); vnx::accept(_visitor, max_open_files);
+	_visitor.type_field(_type_code->fields[20], 20); vnx::accept(_visitor, build_y_index);
 	_visitor.type_end(*_type_code);
 }
 
@@ -135,6 +139,8 @@ void HarvesterBase::write(std::ostream& _out) const {
 	_out << ", \"max_recursion\": "; vnx::write(_out, max_recursion);
 	_out << ", \"recursive_search\": "; vnx::write(_out, recursive_search);
 	_out << ", \"farm_virtual_plots\": "; vnx::write(_out, farm_virtual_plots);
+	_out << ", \"max_open_files\": "; vnx::write(_out, max_open_files);
+	_out << ", \"build_y_index\": "; vnx::write(_out, build_y_index);
 	_out << "}";
 }
 
@@ -166,12 +172,16 @@ vnx::Object HarvesterBase::to_object() const {
 	_object["max_recursion"] = max_recursion;
 	_object["recursive_search"] = recursive_search;
 	_object["farm_virtual_plots"] = farm_virtual_plots;
+	_object["max_open_files"] = max_open_files;
+	_object["build_y_index"] = build_y_index;
 	return _object;
 }
 
 void HarvesterBase::from_object(const vnx::Object& _object) {
 	for(const auto& _entry : _object.field) {
-		if(_entry.first == "config_path") {
+		if(_entry.first == "build_y_index") {
+			_entry.second.to(build_y_index);
+		} else if(_entry.first == "config_path") {
 			_entry.second.to(config_path);
 		} else if(_entry.first == "dir_blacklist") {
 			_entry.second.to(dir_blacklist);
@@ -181,6 +191,8 @@ void HarvesterBase::from_object(const vnx::Object& _object) {
 			_entry.second.to(farmer_server);
 		} else if(_entry.first == "input_challenges") {
 			_entry.second.to(input_challenges);
+		} else if(_entry.first == "max_open_files") {
+			_entry.second.to(max_open_files);
 		} else if(_entry.first == "max_queue_ms") {
 			_entry.second.to(max_queue_ms);
 		} else if(_entry.first == "max_recursion") {
@@ -271,6 +283,12 @@ vnx::Variant HarvesterBase::get_field(const std::string& _name) const {
 	if(_name == "farm_virtual_plots") {
 		return vnx::Variant(farm_virtual_plots);
 	}
+	if(_name == "max_open_files") {
+		return vnx::Variant(max_open_files);
+	}
+	if(_name == "build_y_index") {
+		return vnx::Variant(build_y_index);
+	}
 	return vnx::Variant();
 }
 
@@ -313,6 +331,10 @@ void HarvesterBase::set_field(const std::string& _name, const vnx::Variant& _val
 		_value.to(recursive_search);
 	} else if(_name == "farm_virtual_plots") {
 		_value.to(farm_virtual_plots);
+	} else if(_name == "max_open_files") {
+		_value.to(max_open_files);
+	} else if(_name == "build_y_index") {
+		_value.to(build_y_index);
 	}
 }
 
@@ -340,7 +362,7 @@ std::shared_ptr<vnx::TypeCode> HarvesterBase::static_create_type_code() {
 	auto type_code = std::make_shared<vnx::TypeCode>();
 	type_code->name = "mmx.Harvester";
 	type_code->type_hash = vnx::Hash64(0xc17118896cde1555ull);
-	type_code->code_hash = vnx::Hash64(0x58f3117ab806b859ull);
+	type_code->code_hash = vnx::Hash64(0x9c4e1f7b2d60a3e5ull);
 	type_code->is_native = true;
 	type_code->native_size = sizeof(::mmx::HarvesterBase);
 	type_code->methods.resize(16);
@@ -360,7 +382,7 @@ std::shared_ptr<vnx::TypeCode> HarvesterBase::static_create_type_code() {
 	type_code->methods[13] = ::vnx::ModuleInterface_vnx_stop::static_get_type_code();
 	type_code->methods[14] = ::vnx::addons::HttpComponent_http_request::static_get_type_code();
 	type_code->methods[15] = ::vnx::addons::HttpComponent_http_request_chunk::static_get_type_code();
-	type_code->fields.resize(19);
+	type_code->fields.resize(21);
 	{
 		auto& field = type_code->fields[0];
 		field.is_extended = true;
@@ -489,6 +511,20 @@ std::shared_ptr<vnx::TypeCode> HarvesterBase::static_create_type_code() {
 		field.value = vnx::to_string(true);
 		field.code = {31};
 	}
+	{
+		auto& field = type_code->fields[19];
+		field.data_size = 4;
+		field.name = "max_open_files";
+		field.value = vnx::to_string(0);
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[20];
+		field.data_size = 1;
+		field.name = "build_y_index";
+		field.value = vnx::to_string(false);
+		field.code = {31};
+	}
 	type_code->build();
 	return type_code;
 }
@@ -681,6 +717,12 @@ void read(TypeInput& in, ::mmx::HarvesterBase& value, const TypeCode* type_code,
 		if(const auto* const _field = type_code->field_map[18]) {
 			vnx::read_value(_buf + _field->offset, value.farm_virtual_plots, _field->code.data());
 		}
+		if(const auto* const _field = type_code->field_map[19]) {
+			vnx::read_value(_buf + _field->offset, value.max_open_files, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[20]) {
+			vnx::read_value(_buf + _field->offset, value.build_y_index, _field->code.data());
+		}
 	}
 	for(const auto* _field : type_code->ext_fields) {
 		switch(_field->native_index) {
@@ -714,7 +756,7 @@ void write(TypeOutput& out, const ::mmx::HarvesterBase& value, const TypeCode* t
 	else if(code && code[0] == CODE_STRUCT) {
 		type_code = type_code->depends[code[1]];
 	}
-	auto* const _buf = out.write(22);
+	auto* const _buf = out.write(27);
 	vnx::write_value(_buf + 0, value.max_queue_ms);
 	vnx::write_value(_buf + 4, value.reload_interval);
 	vnx::write_value(_buf + 8, value.nft_query_interval);
@@ -722,6 +764,8 @@ void write(TypeOutput& out, const ::mmx::HarvesterBase& value, const TypeCode* t
 	vnx::write_value(_buf + 16, value.max_recursion);
 	vnx::write_value(_buf + 20, value.recursive_search);
 	vnx::write_value(_buf + 21, value.farm_virtual_plots);
+	vnx::write_value(_buf + 22, value.max_open_files);
+	vnx::write_value(_buf + 26, value.build_y_index);
 	vnx::write(out, value.input_challenges, type_code, type_code->fields[0].code.data());
 	vnx::write(out, value.output_info, type_code, type_code->fields[1].code.data());
 	vnx::write(out, value.output_proofs, type_code, type_code->fields[2].code.data());
@@ -13,7 +13,7 @@ namespace mmx {
 
 
 const vnx::Hash64 NetworkInfo::VNX_TYPE_HASH(0xd984018819746101ull);
-const vnx::Hash64 NetworkInfo::VNX_CODE_HASH(0xb17f3fd89a5445bfull);
+const vnx::Hash64 NetworkInfo::VNX_CODE_HASH(0x321d7694a2ed96d4ull);
 
 vnx::Hash64 NetworkInfo::get_type_hash() const {
 	return VNX_TYPE_HASH;
@@ -64,6 +64,9 @@ void NetworkInfo::accept(vnx::Visitor& _visitor) const {
 	_visitor.type_field(_type_code->fields[15], 15); vnx::accept(_visitor, name);
 	_visitor.type_field(_type_code->fields[16], 16); vnx::accept(_visitor, node_commit);
 	_visitor.type_field(_type_code->fields[17], 17); vnx::accept(_visitor, node_version);
+	_visitor.type_field(_type_code->fields[18], 18); vnx::accept(_visitor, tx_pool_size);
+	_visitor.type_field(_type_code->fields[19], 19); vnx::accept(_visitor, tx_pool_bytes);
+	_visitor.type_field(_type_code->fields[20], 20); vnx::accept(_visitor, tx_pool_evicted);
 	_visitor.type_end(*_type_code);
 }
 
@@ -87,6 +90,9 @@ void NetworkInfo::write(std::ostream& _out) const {
 	_out << ", \"name\": "; vnx::write(_out, name);
 	_out << ", \"node_commit\": "; vnx::write(_out, node_commit);
 	_out << ", \"node_version\": "; vnx::write(_out, node_version);
+	_out << ", \"tx_pool_size\": "; vnx::write(_out, tx_pool_size);
+	_out << ", \"tx_pool_bytes\": "; vnx::write(_out, tx_pool_bytes);
+	_out << ", \"tx_pool_evicted\": "; vnx::write(_out, tx_pool_evicted);
 	_out << "}";
 }
 
@@ -117,6 +123,9 @@ vnx::Object NetworkInfo::to_object() const {
 	_object["name"] = name;
 	_object["node_commit"] = node_commit;
 	_object["node_version"] = node_version;
+	_object["tx_pool_size"] = tx_pool_size;
+	_object["tx_pool_bytes"] = tx_pool_bytes;
+	_object["tx_pool_evicted"] = tx_pool_evicted;
 	return _object;
 }
 
@@ -154,6 +163,12 @@ void NetworkInfo::from_object(const vnx::Object& _object) {
 			_entry.second.to(total_space);
 		} else if(_entry.first == "total_supply") {
 			_entry.second.to(total_supply);
+		} else if(_entry.first == "tx_pool_bytes") {
+			_entry.second.to(tx_pool_bytes);
+		} else if(_entry.first == "tx_pool_evicted") {
+			_entry.second.to(tx_pool_evicted);
+		} else if(_entry.first == "tx_pool_size") {
+			_entry.second.to(tx_pool_size);
 		} else if(_entry.first == "vdf_height") {
 			_entry.second.to(vdf_height);
 		} else if(_entry.first == "vdf_speed") {
@@ -217,6 +232,15 @@ vnx::Variant NetworkInfo::get_field(const std::string& _name) const {
 	if(_name == "node_version") {
 		return vnx::Variant(node_version);
 	}
+	if(_name == "tx_pool_size") {
+		return vnx::Variant(tx_pool_size);
+	}
+	if(_name == "tx_pool_bytes") {
+		return vnx::Variant(tx_pool_bytes);
+	}
+	if(_name == "tx_pool_evicted") {
+		return vnx::Variant(tx_pool_evicted);
+	}
 	return vnx::Variant();
 }
 
@@ -257,6 +281,12 @@ void NetworkInfo::set_field(const std::string& _name, const vnx::Variant& _value
 		_value.to(node_commit);
 	} else if(_name == "node_version") {
 		_value.to(node_version);
+	} else if(_name == "tx_pool_size") {
+		_value.to(tx_pool_size);
+	} else if(_name == "tx_pool_bytes") {
+		_value.to(tx_pool_bytes);
+	} else if(_name == "tx_pool_evicted") {
+		_value.to(tx_pool_evicted);
 	}
 }
 
@@ -284,12 +314,12 @@ std::shared_ptr<vnx::TypeCode> NetworkInfo::static_create_type_code() {
 	auto type_code = std::make_shared<vnx::TypeCode>();
 	type_code->name = "mmx.NetworkInfo";
 	type_code->type_hash = vnx::Hash64(0xd984018819746101ull);
-	type_code->code_hash = vnx::Hash64(0xb17f3fd89a5445bfull);
+	type_code->code_hash = vnx::Hash64(0x321d7694a2ed96d4ull);
 	type_code->is_native = true;
 	type_code->is_class = true;
 	type_code->native_size = sizeof(::mmx::NetworkInfo);
 	type_code->create_value = []() -> std::shared_ptr<vnx::Value> { return std::make_shared<NetworkInfo>(); };
-	type_code->fields.resize(18);
+	type_code->fields.resize(21);
 	{
 		auto& field = type_code->fields[0];
 		field.data_size = 1;
@@ -398,6 +428,24 @@ std::shared_ptr<vnx::TypeCode> NetworkInfo::static_create_type_code() {
 		field.name = "node_version";
 		field.code = {32};
 	}
+	{
+		auto& field = type_code->fields[18];
+		field.data_size = 4;
+		field.name = "tx_pool_size";
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[19];
+		field.data_size = 8;
+		field.name = "tx_pool_bytes";
+		field.code = {4};
+	}
+	{
+		auto& field = type_code->fields[20];
+		field.data_size = 8;
+		field.name = "tx_pool_evicted";
+		field.code = {4};
+	}
 	type_code->build();
 	return type_code;
 }
@@ -489,6 +537,15 @@ void read(TypeInput& in, ::mmx::NetworkInfo& value, const TypeCode* type_code, c
 		if(const auto* const _field = type_code->field_map[13]) {
 			vnx::read_value(_buf + _field->offset, value.average_txfee, _field->code.data());
 		}
+		if(const auto* const _field = type_code->field_map[18]) {
+			vnx::read_value(_buf + _field->offset, value.tx_pool_size, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[19]) {
+			vnx::read_value(_buf + _field->offset, value.tx_pool_bytes, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[20]) {
+			vnx::read_value(_buf + _field->offset, value.tx_pool_evicted, _field->code.data());
+		}
 	}
 	for(const auto* _field : type_code->ext_fields) {
 		switch(_field->native_index) {
@@ -514,7 +571,7 @@ void write(TypeOutput& out, const ::mmx::NetworkInfo& value, const TypeCode* typ
 	else if(code && code[0] == CODE_STRUCT) {
 		type_code = type_code->depends[code[1]];
 	}
-	auto* const _buf = out.write(93);
+	auto* const _buf = out.write(113);
 	vnx::write_value(_buf + 0, value.is_synced);
 	vnx::write_value(_buf + 1, value.height);
 	vnx::write_value(_buf + 5, value.vdf_height);
@@ -529,6 +586,9 @@ void write(TypeOutput& out, const ::mmx::NetworkInfo& value, const TypeCode* typ
 	vnx::write_value(_buf + 69, value.vdf_speed);
 	vnx::write_value(_buf + 77, value.block_size);
 	vnx::write_value(_buf + 85, value.average_txfee);
+	vnx::write_value(_buf + 93, value.tx_pool_size);
+	vnx::write_value(_buf + 97, value.tx_pool_bytes);
+	vnx::write_value(_buf + 105, value.tx_pool_evicted);
 	vnx::write(out, value.genesis_hash, type_code, type_code->fields[14].code.data());
 	vnx::write(out, value.name, type_code, type_code->fields[15].code.data());
 	vnx::write(out, value.node_commit, type_code, type_code->fields[16].code.data());
@@ -161,6 +161,8 @@
 #include <mmx/Node_verify_partial_return.hxx>
 #include <mmx/Node_verify_plot_nft_target.hxx>
 #include <mmx/Node_verify_plot_nft_target_return.hxx>
+#include <mmx/Node_watch_balances.hxx>
+#include <mmx/Node_watch_balances_return.hxx>
 #include <mmx/Partial.hxx>
 #include <mmx/ProofOfTime.hxx>
 #include <mmx/ProofResponse.hxx>
@@ -222,7 +224,7 @@ namespace mmx {
 
 
 const vnx::Hash64 NodeBase::VNX_TYPE_HASH(0x289d7651582d76a3ull);
-const vnx::Hash64 NodeBase::VNX_CODE_HASH(0x68aed6efdea2cf00ull);
+const vnx::Hash64 NodeBase::VNX_CODE_HASH(0x3b7d52c90e41a6f8ull);
 
 NodeBase::NodeBase(const std::string& _vnx_name)
 	:	Module::Module(_vnx_name)
@@ -252,6 +254,7 @@ NodeBase::NodeBase(const std::string& _vnx_name)
 	vnx::read_config(vnx_name + ".sync_loss_delay", sync_loss_delay);
 	vnx::read_config(vnx_name + ".max_history", max_history);
 	vnx::read_config(vnx_name + ".max_tx_pool", max_tx_pool);
+	vnx::read_config(vnx_name + ".max_tx_pool_mem", max_tx_pool_mem);
 	vnx::read_config(vnx_name + ".max_tx_queue", max_tx_queue);
 	vnx::read_config(vnx_name + ".max_sync_jobs", max_sync_jobs);
 	vnx::read_config(vnx_name + ".max_sync_ahead", max_sync_ahead);
@@ -276,6 +279,12 @@ NodeBase::NodeBase(const std::string& _vnx_name)
 	vnx::read_config(vnx_name + ".database_path", database_path);
 	vnx::read_config(vnx_name + ".router_name", router_name);
 	vnx::read_config(vnx_name + ".mmx_usd_swap_addr", mmx_usd_swap_addr);
+	vnx::read_config(vnx_name + ".db_cache_size", db_cache_size);
+	vnx::read_config(vnx_name + ".vm_cache_size", vm_cache_size);
+	vnx::read_config(vnx_name + ".exec_optimistic", exec_optimistic);
+	vnx::read_config(vnx_name + ".checkpoint_height", checkpoint_height);
+	vnx::read_config(vnx_name + ".checkpoint_hash", checkpoint_hash);
+	vnx::read_config(vnx_name + ".output_balance_deltas", output_balance_deltas);
 }
 
 vnx::Hash64 NodeBase::get_type_hash() const {
@@ -318,30 +327,37 @@ void NodeBase::accept(vnx::Visitor& _visitor) const {
 	_visitor.type_field(_type_code->fields[22], 22); vnx::accept(_visitor, sync_loss_delay);
 	_visitor.type_field(_type_code->fields[23], 23); vnx::accept(_visitor, max_history);
 	_visitor.type_field(_type_code->fields[24], 24); vnx::accept(_visitor, max_tx_pool);
-	_visitor.type_field(_type_code->fields[25], 25); vnx::accept(_visitor, max_tx_queue);
-	_visitor.type_field(_type_code->fields[26], 26); vnx::accept(_visitor, max_sync_jobs);
-	_visitor.type_field(_type_code->fields[27], 27); vnx::accept(_visitor, max_sync_ahead);
-	_visitor.type_field(_type_code->fields[28], 28); vnx::accept(_visitor, num_sync_retries);
-	_visitor.type_field(_type_code->fields[29], 29); vnx::accept(_visitor, revert_height);
-	_visitor.type_field(_type_code->fields[30], 30); vnx::accept(_visitor, num_threads);
-	_visitor.type_field(_type_code->fields[31], 31); vnx::accept(_visitor, num_db_threads);
-	_visitor.type_field(_type_code->fields[32], 32); vnx::accept(_visitor, num_api_threads);
-	_visitor.type_field(_type_code->fields[33], 33); vnx::accept(_visitor, commit_threshold);
-	_visitor.type_field(_type_code->fields[34], 34); vnx::accept(_visitor, max_future_sync);
-	_visitor.type_field(_type_code->fields[35], 35); vnx::accept(_visitor, max_vdf_verify_pending);
-	_visitor.type_field(_type_code->fields[36], 36); vnx::accept(_visitor, opencl_device);
-	_visitor.type_field(_type_code->fields[37], 37); vnx::accept(_visitor, opencl_device_name);
-	_visitor.type_field(_type_code->fields[38], 38); vnx::accept(_visitor, do_sync);
-	_visitor.type_field(_type_code->fields[39], 39); vnx::accept(_visitor, show_warnings);
-	_visitor.type_field(_type_code->fields[40], 40); vnx::accept(_visitor, vdf_slave_mode);
-	_visitor.type_field(_type_code->fields[41], 41); vnx::accept(_visitor, run_tests);
-	_visitor.type_field(_type_code->fields[42], 42); vnx::accept(_visitor, exec_debug);
-	_visitor.type_field(_type_code->fields[43], 43); vnx::accept(_visitor, exec_profile);
-	_visitor.type_field(_type_code->fields[44], 44); vnx::accept(_visitor, exec_trace);
-	_visitor.type_field(_type_code->fields[45], 45); vnx::accept(_visitor, storage_path);
-	_visitor.type_field(_type_code->fields[46], 46); vnx::accept(_visitor, database_path);
-	_visitor.type_field(_type_code->fields[47], 47); vnx::accept(_visitor, router_name);
-	_visitor.type_field(_type_code->fields[48], 48); vnx::accept(_visitor, mmx_usd_swap_addr);
+	_visitor.type_field(_type_code->fields[25], 25); vnx::accept(_visitor, max_tx_pool_mem);
+	_visitor.type_field(_type_code->fields[26], 26); vnx::accept(_visitor, max_tx_queue);
+	_visitor.type_field(_type_code->fields[27], 27); vnx::accept(_visitor, max_sync_jobs);
+	_visitor.type_field(_type_code->fields[28], 28); vnx::accept(_visitor, max_sync_ahead);
+	_visitor.type_field(_type_code->fields[29], 29); vnx::accept(_visitor, num_sync_retries);
+	_visitor.type_field(_type_code->fields[30], 30); vnx::accept(_visitor, revert_height);
+	_visitor.type_field(_type_code->fields[31], 31); vnx::accept(_visitor, num_threads);
+	_visitor.type_field(_type_code->fields[32], 32); vnx::accept(_visitor, num_db_threads);
+	_visitor.type_field(_type_code->fields[33], 33); vnx::accept(_visitor, num_api_threads);
+	_visitor.type_field(_type_code->fields[34], 34); vnx::accept(_visitor, commit_threshold);
+	_visitor.type_field(_type_code->fields[35], 35); vnx::accept(_visitor, max_future_sync);
+	_visitor.type_field(_type_code->fields[36], 36); vnx::accept(_visitor, max_vdf_verify_pending);
+	_visitor.type_field(_type_code->fields[37], 37); vnx::accept(_visitor, opencl_device);
+	_visitor.type_field(_type_code->fields[38], 38); vnx::accept(_visitor, opencl_device_name);
+	_visitor.type_field(_type_code->fields[39], 39); vnx::accept(_visitor, do_sync);
+	_visitor.type_field(_type_code->fields[40], 40); vnx::accept(_visitor, show_warnings);
+	_visitor.type_field(_type_code->fields[41], 41); vnx::accept(_visitor, vdf_slave_mode);
+	_visitor.type_field(_type_code->fields[42], 42); vnx::accept(_visitor, run_tests);
+	_visitor.type_field(_type_code->fields[43], 43); vnx::accept(_visitor, exec_debug);
+	_visitor.type_field(_type_code->fields[44], 44); vnx::accept(_visitor, exec_profile);
+	_visitor.type_field(_type_code->fields[45], 45); vnx::accept(_visitor, exec_trace);
+	_visitor.type_field(_type_code->fields[46], 46); vnx::accept(_visitor, storage_path);
+	_visitor.type_field(_type_code->fields[47], 47); vnx::accept(_visitor, database_path);
+	_visitor.type_field(_type_code->fields[48], 48); vnx::accept(_visitor, router_name);
+	_visitor.type_field(_type_code->fields[49], 49); vnx::accept(_visitor, mmx_usd_swap_addr);
+	_visitor.type_field(_type_code->fields[50], 50); vnx::accept(_visitor, db_cache_size);
+	_visitor.type_field(_type_code->fields[51], 51); vnx::accept(_visitor, vm_cache_size);
+	_visitor.type_field(_type_code->fields[52], 52); vnx::accept(_visitor, exec_optimistic);
+	_visitor.type_field(_type_code->fields[53], 53); vnx::accept(_visitor, checkpoint_height);
+	_visitor.type_field(_type_code->fields[54], 54); vnx::accept(_visitor, checkpoint_hash);
+	_visitor.type_field(_type_code->fields[55], 55); vnx::accept(_visitor, output_balance_deltas);
 	_visitor.type_end(*_type_code);
 }
 
@@ -372,6 +388,7 @@ void NodeBase::write(std::ostream& _out) const {
 	_out << ", \"sync_loss_delay\": "; vnx::write(_out, sync_loss_delay);
 	_out << ", \"max_history\": "; vnx::write(_out, max_history);
 	_out << ", \"max_tx_pool\": "; vnx::write(_out, max_tx_pool);
+	_out << ", \"max_tx_pool_mem\": "; vnx::write(_out, max_tx_pool_mem);
 	_out << ", \"max_tx_queue\": "; vnx::write(_out, max_tx_queue);
 	_out << ", \"max_sync_jobs\": "; vnx::write(_out, max_sync_jobs);
 	_out << ", \"max_sync_ahead\": "; vnx::write(_out, max_sync_ahead);
@@ -396,6 +413,12 @@ void NodeBase::write(std::ostream& _out) const {
 	_out << ", \"database_path\": "; vnx::write(_out, database_path);
 	_out << ", \"router_name\": "; vnx::write(_out, router_name);
 	_out << ", \"mmx_usd_swap_addr\": "; vnx::write(_out, mmx_usd_swap_addr);
+	_out << ", \"db_cache_size\": "; vnx::write(_out, db_cache_size);
+	_out << ", \"vm_cache_size\": "; vnx::write(_out, vm_cache_size);
+	_out << ", \"exec_optimistic\": "; vnx::write(_out, exec_optimistic);
+	_out << ", \"checkpoint_height\": "; vnx::write(_out, checkpoint_height);
+	_out << ", \"checkpoint_hash\": "; vnx::write(_out, checkpoint_hash);
+	_out << ", \"output_balance_deltas\": "; vnx::write(_out, output_balance_deltas);
 	_out << "}";
 }
 
@@ -433,6 +456,7 @@ vnx::Object NodeBase::to_object() const {
 	_object["sync_loss_delay"] = sync_loss_delay;
 	_object["max_history"] = max_history;
 	_object["max_tx_pool"] = max_tx_pool;
+	_object["max_tx_pool_mem"] = max_tx_pool_mem;
 	_object["max_tx_queue"] = max_tx_queue;
 	_object["max_sync_jobs"] = max_sync_jobs;
 	_object["max_sync_ahead"] = max_sync_ahead;
@@ -457,19 +481,33 @@ vnx::Object NodeBase::to_object() const {
 	_object["database_path"] = database_path;
 	_object["router_name"] = router_name;
 	_object["mmx_usd_swap_addr"] = mmx_usd_swap_addr;
+	_object["db_cache_size"] = db_cache_size;
+	_object["vm_cache_size"] = vm_cache_size;
+	_object["exec_optimistic"] = exec_optimistic;
+	_object["checkpoint_height"] = checkpoint_height;
+	_object["checkpoint_hash"] = checkpoint_hash;
+	_object["output_balance_deltas"] = output_balance_deltas;
 	return _object;
 }
 
 void NodeBase::from_object(const vnx::Object& _object) {
 	for(const auto& _entry : _object.field) {
-		if(_entry.first == "commit_threshold") {
+		if(_entry.first == "checkpoint_hash") {
+			_entry.second.to(checkpoint_hash);
+		} else if(_entry.first == "checkpoint_height") {
+			_entry.second.to(checkpoint_height);
+		} else if(_entry.first == "commit_threshold") {
 			_entry.second.to(commit_threshold);
 		} else if(_entry.first == "database_path") {
 			_entry.second.to(database_path);
+		} else if(_entry.first == "db_cache_size") {
+			_entry.second.to(db_cache_size);
 		} else if(_entry.first == "do_sync") {
 			_entry.second.to(do_sync);
 		} else if(_entry.first == "exec_debug") {
 			_entry.second.to(exec_debug);
+		} else if(_entry.first == "exec_optimistic") {
+			_entry.second.to(exec_optimistic);
 		} else if(_entry.first == "exec_profile") {
 			_entry.second.to(exec_profile);
 		} else if(_entry.first == "exec_trace") {
@@ -502,6 +540,8 @@ void NodeBase::from_object(const vnx::Object& _object) {
 			_entry.second.to(max_sync_jobs);
 		} else if(_entry.first == "max_tx_pool") {
 			_entry.second.to(max_tx_pool);
+		} else if(_entry.first == "max_tx_pool_mem") {
+			_entry.second.to(max_tx_pool_mem);
 		} else if(_entry.first == "max_tx_queue") {
 			_entry.second.to(max_tx_queue);
 		} else if(_entry.first == "max_vdf_verify_pending") {
@@ -520,6 +560,8 @@ void NodeBase::from_object(const vnx::Object& _object) {
 			_entry.second.to(opencl_device);
 		} else if(_entry.first == "opencl_device_name") {
 			_entry.second.to(opencl_device_name);
+		} else if(_entry.first == "output_balance_deltas") {
+			_entry.second.to(output_balance_deltas);
 		} else if(_entry.first == "output_challenges") {
 			_entry.second.to(output_challenges);
 		} else if(_entry.first == "output_committed_blocks") {
@@ -560,6 +602,8 @@ void NodeBase::from_object(const vnx::Object& _object) {
 			_entry.second.to(validate_interval_ms);
 		} else if(_entry.first == "vdf_slave_mode") {
 			_entry.second.to(vdf_slave_mode);
+		} else if(_entry.first == "vm_cache_size") {
+			_entry.second.to(vm_cache_size);
 		}
 	}
 }
@@ -640,6 +684,9 @@ vnx::Variant NodeBase::get_field(const std::string& _name) const {
 	if(_name == "max_tx_pool") {
 		return vnx::Variant(max_tx_pool);
 	}
+	if(_name == "max_tx_pool_mem") {
+		return vnx::Variant(max_tx_pool_mem);
+	}
 	if(_name == "max_tx_queue") {
 		return vnx::Variant(max_tx_queue);
 	}
@@ -712,6 +759,24 @@ vnx::Variant NodeBase::get_field(const std::string& _name) const {
 	if(_name == "mmx_usd_swap_addr") {
 		return vnx::Variant(mmx_usd_swap_addr);
 	}
+	if(_name == "db_cache_size") {
+		return vnx::Variant(db_cache_size);
+	}
+	if(_name == "vm_cache_size") {
+		return vnx::Variant(vm_cache_size);
+	}
+	if(_name == "exec_optimistic") {
+		return vnx::Variant(exec_optimistic);
+	}
+	if(_name == "checkpoint_height") {
+		return vnx::Variant(checkpoint_height);
+	}
+	if(_name == "checkpoint_hash") {
+		return vnx::Variant(checkpoint_hash);
+	}
+	if(_name == "output_balance_deltas") {
+		return vnx::Variant(output_balance_deltas);
+	}
 	return vnx::Variant();
 }
 
@@ -766,6 +831,8 @@ void NodeBase::set_field(const std::string& _name, const vnx::Variant& _value) {
 		_value.to(max_history);
 	} else if(_name == "max_tx_pool") {
 		_value.to(max_tx_pool);
+	} else if(_name == "max_tx_pool_mem") {
+		_value.to(max_tx_pool_mem);
 	} else if(_name == "max_tx_queue") {
 		_value.to(max_tx_queue);
 	} else if(_name == "max_sync_jobs") {
@@ -814,6 +881,18 @@ void NodeBase::set_field(const std::string& _name, const vnx::Variant& _value) {
 		_value.to(router_name);
 	} else if(_name == "mmx_usd_swap_addr") {
 		_value.to(mmx_usd_swap_addr);
+	} else if(_name == "db_cache_size") {
+		_value.to(db_cache_size);
+	} else if(_name == "vm_cache_size") {
+		_value.to(vm_cache_size);
+	} else if(_name == "exec_optimistic") {
+		_value.to(exec_optimistic);
+	} else if(_name == "checkpoint_height") {
+		_value.to(checkpoint_height);
+	} else if(_name == "checkpoint_hash") {
+		_value.to(checkpoint_hash);
+	} else if(_name == "output_balance_deltas") {
+		_value.to(output_balance_deltas);
 	}
 }
 
@@ -841,10 +920,10 @@ std::shared_ptr<vnx::TypeCode> NodeBase::static_create_type_code() {
 	auto type_code = std::make_shared<vnx::TypeCode>();
 	type_code->name = "mmx.Node";
 	type_code->type_hash = vnx::Hash64(0x289d7651582d76a3ull);
-	type_code->code_hash = vnx::Hash64(0x68aed6efdea2cf00ull);
+	type_code->code_hash = vnx::Hash64(0x3b7d52c90e41a6f8ull);
 	type_code->is_native = true;
 	type_code->native_size = sizeof(::mmx::NodeBase);
-	type_code->methods.resize(87);
+	type_code->methods.resize(88);
 	type_code->methods[0] = ::mmx::Node_add_block::static_get_type_code();
 	type_code->methods[1] = ::mmx::Node_add_transaction::static_get_type_code();
 	type_code->methods[2] = ::mmx::Node_call_contract::static_get_type_code();
@@ -921,18 +1000,19 @@ std::shared_ptr<vnx::TypeCode> NodeBase::static_create_type_code() {
 	type_code->methods[73] = ::mmx::Node_validate::static_get_type_code();
 	type_code->methods[74] = ::mmx::Node_verify_partial::static_get_type_code();
 	type_code->methods[75] = ::mmx::Node_verify_plot_nft_target::static_get_type_code();
-	type_code->methods[76] = ::vnx::ModuleInterface_vnx_get_config::static_get_type_code();
-	type_code->methods[77] = ::vnx::ModuleInterface_vnx_get_config_object::static_get_type_code();
-	type_code->methods[78] = ::vnx::ModuleInterface_vnx_get_module_info::static_get_type_code();
-	type_code->methods[79] = ::vnx::ModuleInterface_vnx_get_type_code::static_get_type_code();
-	type_code->methods[80] = ::vnx::ModuleInterface_vnx_restart::static_get_type_code();
-	type_code->methods[81] = ::vnx::ModuleInterface_vnx_self_test::static_get_type_code();
-	type_code->methods[82] = ::vnx::ModuleInterface_vnx_set_config::static_get_type_code();
-	type_code->methods[83] = ::vnx::ModuleInterface_vnx_set_config_object::static_get_type_code();
-	type_code->methods[84] = ::vnx::ModuleInterface_vnx_stop::static_get_type_code();
-	type_code->methods[85] = ::vnx::addons::HttpComponent_http_request::static_get_type_code();
-	type_code->methods[86] = ::vnx::addons::HttpComponent_http_request_chunk::static_get_type_code();
-	type_code->fields.resize(49);
+	type_code->methods[76] = ::mmx::Node_watch_balances::static_get_type_code();
+	type_code->methods[77] = ::vnx::ModuleInterface_vnx_get_config::static_get_type_code();
+	type_code->methods[78] = ::vnx::ModuleInterface_vnx_get_config_object::static_get_type_code();
+	type_code->methods[79] = ::vnx::ModuleInterface_vnx_get_module_info::static_get_type_code();
+	type_code->methods[80] = ::vnx::ModuleInterface_vnx_get_type_code::static_get_type_code();
+	type_code->methods[81] = ::vnx::ModuleInterface_vnx_restart::static_get_type_code();
+	type_code->methods[82] = ::vnx::ModuleInterface_vnx_self_test::static_get_type_code();
+	type_code->methods[83] = ::vnx::ModuleInterface_vnx_set_config::static_get_type_code();
+	type_code->methods[84] = ::vnx::ModuleInterface_vnx_set_config_object::static_get_type_code();
+	type_code->methods[85] = ::vnx::ModuleInterface_vnx_stop::static_get_type_code();
+	type_code->methods[86] = ::vnx::addons::HttpComponent_http_request::static_get_type_code();
+	type_code->methods[87] = ::vnx::addons::HttpComponent_http_request_chunk::static_get_type_code();
+	type_code->fields.resize(56);
 	{
 		auto& field = type_code->fields[0];
 		field.is_extended = true;
@@ -1111,162 +1191,208 @@ std::shared_ptr<vnx::TypeCode> NodeBase::static_create_type_code() {
 	{
 		auto& field = type_code->fields[25];
 		field.data_size = 4;
+		field.name = "max_tx_pool_mem";
+		field.value = vnx::to_string(512);
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[26];
+		field.data_size = 4;
 		field.name = "max_tx_queue";
 		field.value = vnx::to_string(10000);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[26];
+		auto& field = type_code->fields[27];
 		field.data_size = 4;
 		field.name = "max_sync_jobs";
 		field.value = vnx::to_string(64);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[27];
+		auto& field = type_code->fields[28];
 		field.data_size = 4;
 		field.name = "max_sync_ahead";
 		field.value = vnx::to_string(1000);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[28];
+		auto& field = type_code->fields[29];
 		field.data_size = 4;
 		field.name = "num_sync_retries";
 		field.value = vnx::to_string(3);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[29];
+		auto& field = type_code->fields[30];
 		field.data_size = 4;
 		field.name = "revert_height";
 		field.value = vnx::to_string(-1);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[30];
+		auto& field = type_code->fields[31];
 		field.data_size = 4;
 		field.name = "num_threads";
 		field.value = vnx::to_string(24);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[31];
+		auto& field = type_code->fields[32];
 		field.data_size = 4;
 		field.name = "num_db_threads";
 		field.value = vnx::to_string(8);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[32];
+		auto& field = type_code->fields[33];
 		field.data_size = 4;
 		field.name = "num_api_threads";
 		field.value = vnx::to_string(8);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[33];
+		auto& field = type_code->fields[34];
 		field.data_size = 4;
 		field.name = "commit_threshold";
 		field.value = vnx::to_string(80);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[34];
+		auto& field = type_code->fields[35];
 		field.data_size = 4;
 		field.name = "max_future_sync";
 		field.value = vnx::to_string(100);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[35];
+		auto& field = type_code->fields[36];
 		field.data_size = 4;
 		field.name = "max_vdf_verify_pending";
 		field.value = vnx::to_string(2);
 		field.code = {3};
 	}
 	{
-		auto& field = type_code->fields[36];
+		auto& field = type_code->fields[37];
 		field.data_size = 4;
 		field.name = "opencl_device";
 		field.value = vnx::to_string(0);
 		field.code = {7};
 	}
 	{
-		auto& field = type_code->fields[37];
+		auto& field = type_code->fields[38];
 		field.is_extended = true;
 		field.name = "opencl_device_name";
 		field.code = {32};
 	}
 	{
-		auto& field = type_code->fields[38];
+		auto& field = type_code->fields[39];
 		field.data_size = 1;
 		field.name = "do_sync";
 		field.value = vnx::to_string(true);
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[39];
+		auto& field = type_code->fields[40];
 		field.data_size = 1;
 		field.name = "show_warnings";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[40];
+		auto& field = type_code->fields[41];
 		field.data_size = 1;
 		field.name = "vdf_slave_mode";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[41];
+		auto& field = type_code->fields[42];
 		field.data_size = 1;
 		field.name = "run_tests";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[42];
+		auto& field = type_code->fields[43];
 		field.data_size = 1;
 		field.name = "exec_debug";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[43];
+		auto& field = type_code->fields[44];
 		field.data_size = 1;
 		field.name = "exec_profile";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[44];
+		auto& field = type_code->fields[45];
 		field.data_size = 1;
 		field.name = "exec_trace";
 		field.code = {31};
 	}
 	{
-		auto& field = type_code->fields[45];
+		auto& field = type_code->fields[46];
 		field.is_extended = true;
 		field.name = "storage_path";
 		field.code = {32};
 	}
 	{
-		auto& field = type_code->fields[46];
+		auto& field = type_code->fields[47];
 		field.is_extended = true;
 		field.name = "database_path";
 		field.value = vnx::to_string("db/");
 		field.code = {32};
 	}
 	{
-		auto& field = type_code->fields[47];
+		auto& field = type_code->fields[48];
 		field.is_extended = true;
 		field.name = "router_name";
 		field.value = vnx::to_string("Router");
 		field.code = {32};
 	}
 	{
-		auto& field = type_code->fields[48];
+		auto& field = type_code->fields[49];
 		field.is_extended = true;
 		field.name = "mmx_usd_swap_addr";
 		field.code = {11, 32, 1};
 	}
+	{
+		auto& field = type_code->fields[50];
+		field.data_size = 4;
+		field.name = "db_cache_size";
+		field.value = vnx::to_string(256);
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[51];
+		field.data_size = 4;
+		field.name = "vm_cache_size";
+		field.value = vnx::to_string(256);
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[52];
+		field.data_size = 1;
+		field.name = "exec_optimistic";
+		field.code = {31};
+	}
+	{
+		auto& field = type_code->fields[53];
+		field.data_size = 4;
+		field.name = "checkpoint_height";
+		field.code = {3};
+	}
+	{
+		auto& field = type_code->fields[54];
+		field.is_extended = true;
+		field.name = "checkpoint_hash";
+		field.code = {11, 32, 1};
+	}
+	{
+		auto& field = type_code->fields[55];
+		field.is_extended = true;
+		field.name = "output_balance_deltas";
+		field.value = vnx::to_string("node.balance_deltas");
+		field.code = {12, 5};
+	}
 	type_code->build();
 	return type_code;
 }
@@ -1758,6 +1884,12 @@ std::shared_ptr<vnx::Value> NodeBase::vnx_call_switch(std::shared_ptr<const vnx:
 			_return_value->_ret_0 = verify_plot_nft_target(_args->address, _args->pool_target);
 			return _return_value;
 		}
+		case 0x8b62c44bc8b48162ull: {
+			auto _args = std::static_pointer_cast<const ::mmx::Node_watch_balances>(_method);
+			auto _return_value = ::mmx::Node_watch_balances_return::create();
+			watch_balances(_args->addresses, _args->client);
+			return _return_value;
+		}
 		case 0xbbc7f1a01044d294ull: {
 			auto _args = std::static_pointer_cast<const ::vnx::ModuleInterface_vnx_get_config>(_method);
 			auto _return_value = ::vnx::ModuleInterface_vnx_get_config_return::create();
@@ -1898,62 +2030,77 @@ void read(TypeInput& in, ::mmx::NodeBase& value, const TypeCode* type_code, cons
 			vnx::read_value(_buf + _field->offset, value.max_tx_pool, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[25]) {
-			vnx::read_value(_buf + _field->offset, value.max_tx_queue, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.max_tx_pool_mem, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[26]) {
-			vnx::read_value(_buf + _field->offset, value.max_sync_jobs, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.max_tx_queue, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[27]) {
-			vnx::read_value(_buf + _field->offset, value.max_sync_ahead, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.max_sync_jobs, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[28]) {
-			vnx::read_value(_buf + _field->offset, value.num_sync_retries, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.max_sync_ahead, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[29]) {
-			vnx::read_value(_buf + _field->offset, value.revert_height, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.num_sync_retries, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[30]) {
-			vnx::read_value(_buf + _field->offset, value.num_threads, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.revert_height, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[31]) {
-			vnx::read_value(_buf + _field->offset, value.num_db_threads, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.num_threads, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[32]) {
-			vnx::read_value(_buf + _field->offset, value.num_api_threads, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.num_db_threads, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[33]) {
-			vnx::read_value(_buf + _field->offset, value.commit_threshold, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.num_api_threads, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[34]) {
-			vnx::read_value(_buf + _field->offset, value.max_future_sync, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.commit_threshold, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[35]) {
-			vnx::read_value(_buf + _field->offset, value.max_vdf_verify_pending, _field->code.data());
+			vnx::read_value(_buf + _field->offset, value.max_future_sync, _field->code.data());
 		}
 		if(const auto* const _field = type_code->field_map[36]) {
+			vnx::read_value(_buf + _field->offset, value.max_vdf_verify_pending, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[37]) {
 			vnx::read_value(_buf + _field->offset, value.opencl_device, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[38]) {
+		if(const auto* const _field = type_code->field_map[39]) {
 			vnx::read_value(_buf + _field->offset, value.do_sync, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[39]) {
+		if(const auto* const _field = type_code->field_map[40]) {
 			vnx::read_value(_buf + _field->offset, value.show_warnings, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[40]) {
+		if(const auto* const _field = type_code->field_map[41]) {
 			vnx::read_value(_buf + _field->offset, value.vdf_slave_mode, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[41]) {
+		if(const auto* const _field = type_code->field_map[42]) {
 			vnx::read_value(_buf + _field->offset, value.run_tests, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[42]) {
+		if(const auto* const _field = type_code->field_map[43]) {
 			vnx::read_value(_buf + _field->offset, value.exec_debug, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[43]) {
+		if(const auto* const _field = type_code->field_map[44]) {
 			vnx::read_value(_buf + _field->offset, value.exec_profile, _field->code.data());
 		}
-		if(const auto* const _field = type_code->field_map[44]) {
+		if(const auto* const _field = type_code->field_map[45]) {
 			vnx::read_value(_buf + _field->offset, value.exec_trace, _field->code.data());
 		}
+		if(const auto* const _field = type_code->field_map[50]) {
+			vnx::read_value(_buf + _field->offset, value.db_cache_size, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[51]) {
+			vnx::read_value(_buf + _field->offset, value.vm_cache_size, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[52]) {
+			vnx::read_value(_buf + _field->offset, value.exec_optimistic, _field->code.data());
+		}
+		if(const auto* const _field = type_code->field_map[53]) {
+			vnx::read_value(_buf + _field->offset, value.checkpoint_height, _field->code.data());
+		}
 	}
 	for(const auto* _field : type_code->ext_fields) {
 		switch(_field->native_index) {
@@ -1976,11 +2123,13 @@ void read(TypeInput& in, ::mmx::NodeBase& value, const TypeCode* type_code, cons
 			case 16: vnx::read(in, value.output_challenges, type_code, _field->code.data()); break;
 			case 17: vnx::read(in, value.output_vdf_points, type_code, _field->code.data()); break;
 			case 18: vnx::read(in, value.output_votes, type_code, _field->code.data()); break;
-			case 37: vnx::read(in, value.opencl_device_name, type_code, _field->code.data()); break;
-			case 45: vnx::read(in, value.storage_path, type_code, _field->code.data()); break;
-			case 46: vnx::read(in, value.database_path, type_code, _field->code.data()); break;
-			case 47: vnx::read(in, value.router_name, type_code, _field->code.data()); break;
-			case 48: vnx::read(in, value.mmx_usd_swap_addr, type_code, _field->code.data()); break;
+			case 38: vnx::read(in, value.opencl_device_name, type_code, _field->code.data()); break;
+			case 46: vnx::read(in, value.storage_path, type_code, _field->code.data()); break;
+			case 47: vnx::read(in, value.database_path, type_code, _field->code.data()); break;
+			case 48: vnx::read(in, value.router_name, type_code, _field->code.data()); break;
+			case 49: vnx::read(in, value.mmx_usd_swap_addr, type_code, _field->code.data()); break;
+			case 54: vnx::read(in, value.checkpoint_hash, type_code, _field->code.data()); break;
+			case 55: vnx::read(in, value.output_balance_deltas, type_code, _field->code.data()); break;
 			default: vnx::skip(in, type_code, _field->code.data());
 		}
 	}
@@ -1999,32 +2148,37 @@ void write(TypeOutput& out, const ::mmx::NodeBase& value, const TypeCode* type_c
 	else if(code && code[0] == CODE_STRUCT) {
 		type_code = type_code->depends[code[1]];
 	}
-	auto* const _buf = out.write(79);
+	auto* const _buf = out.write(96);
 	vnx::write_value(_buf + 0, value.max_queue_ms);
 	vnx::write_value(_buf + 4, value.update_interval_ms);
 	vnx::write_value(_buf + 8, value.validate_interval_ms);
 	vnx::write_value(_buf + 12, value.sync_loss_delay);
 	vnx::write_value(_buf + 16, value.max_history);
 	vnx::write_value(_buf + 20, value.max_tx_pool);
-	vnx::write_value(_buf + 24, value.max_tx_queue);
-	vnx::write_value(_buf + 28, value.max_sync_jobs);
-	vnx::write_value(_buf + 32, value.max_sync_ahead);
-	vnx::write_value(_buf + 36, value.num_sync_retries);
-	vnx::write_value(_buf + 40, value.revert_height);
-	vnx::write_value(_buf + 44, value.num_threads);
-	vnx::write_value(_buf + 48, value.num_db_threads);
-	vnx::write_value(_buf + 52, value.num_api_threads);
-	vnx::write_value(_buf + 56, value.commit_threshold);
-	vnx::write_value(_buf + 60, value.max_future_sync);
-	vnx::write_value(_buf + 64, value.max_vdf_verify_pending);
-	vnx::write_value(_buf + 68, value.opencl_device);
-	vnx::write_value(_buf + 72, value.do_sync);
-	vnx::write_value(_buf + 73, value.show_warnings);
-	vnx::write_value(_buf + 74, value.vdf_slave_mode);
-	vnx::write_value(_buf + 75, value.run_tests);
-	vnx::write_value(_buf + 76, value.exec_debug);
-	vnx::write_value(_buf + 77, value.exec_profile);
-	vnx::write_value(_buf + 78, value.exec_trace);
+	vnx::write_value(_buf + 24, value.max_tx_pool_mem);
+	vnx::write_value(_buf + 28, value.max_tx_queue);
+	vnx::write_value(_buf + 32, value.max_sync_jobs);
+	vnx::write_value(_buf + 36, value.max_sync_ahead);
+	vnx::write_value(_buf + 40, value.num_sync_retries);
+	vnx::write_value(_buf + 44, value.revert_height);
+	vnx::write_value(_buf + 48, value.num_threads);
+	vnx::write_value(_buf + 52, value.num_db_threads);
+	vnx::write_value(_buf + 56, value.num_api_threads);
+	vnx::write_value(_buf + 60, value.commit_threshold);
+	vnx::write_value(_buf + 64, value.max_future_sync);
+	vnx::write_value(_buf + 68, value.max_vdf_verify_pending);
+	vnx::write_value(_buf + 72, value.opencl_device);
+	vnx::write_value(_buf + 76, value.do_sync);
+	vnx::write_value(_buf + 77, value.show_warnings);
+	vnx::write_value(_buf + 78, value.vdf_slave_mode);
+	vnx::write_value(_buf + 79, value.run_tests);
+	vnx::write_value(_buf + 80, value.exec_debug);
+	vnx::write_value(_buf + 81, value.exec_profile);
+	vnx::write_value(_buf + 82, value.exec_trace);
+	vnx::write_value(_buf + 83, value.db_cache_size);
+	vnx::write_value(_buf + 87, value.vm_cache_size);
+	vnx::write_value(_buf + 91, value.exec_optimistic);
+	vnx::write_value(_buf + 92, value.checkpoint_height);
 	vnx::write(out, value.input_vdfs, type_code, type_code->fields[0].code.data());
 	vnx::write(out, value.input_votes, type_code, type_code->fields[1].code.data());
 	vnx::write(out, value.input_proof, type_code, type_code->fields[2].code.data());
@@ -2044,11 +2198,13 @@ void write(TypeOutput& out, const ::mmx::NodeBase& value, const TypeCode* type_c
 	vnx::write(out, value.output_challenges, type_code, type_code->fields[16].code.data());
 	vnx::write(out, value.output_vdf_points, type_code, type_code->fields[17].code.data());
 	vnx::write(out, value.output_votes, type_code, type_code->fields[18].code.data());
-	vnx::write(out, value.opencl_device_name, type_code, type_code->fields[37].code.data());
-	vnx::write(out, value.storage_path, type_code, type_code->fields[45].code.data());
-	vnx::write(out, value.database_path, type_code, type_code->fields[46].code.data());
-	vnx::write(out, value.router_name, type_code, type_code->fields[47].code.data());
-	vnx::write(out, value.mmx_usd_swap_addr, type_code, type_code->fields[48].code.data());
+	vnx::write(out, value.opencl_device_name, type_code, type_code->fields[38].code.data());
+	vnx::write(out, value.storage_path, type_code, type_code->fields[46].code.data());
+	vnx::write(out, value.database_path, type_code, type_code->fields[47].code.data());
+	vnx::write(out, value.router_name, type_code, type_code->fields[48].code.data());
+	vnx::write(out, value.mmx_usd_swap_addr, type_code, type_code->fields[49].code.data());
+	vnx::write(out, value.checkpoint_hash, type_code, type_code->fields[54].code.data());
+	vnx::write(out, value.output_balance_deltas, type_code, type_code->fields[55].code.data());
 }
 
 void read(std::istream& in, ::mmx::NodeBase& value) {
@@ -160,6 +160,8 @@
 #include <mmx/Node_verify_partial_return.hxx>
 #include <mmx/Node_verify_plot_nft_target.hxx>
 #include <mmx/Node_verify_plot_nft_target_return.hxx>
+#include <mmx/Node_watch_balances.hxx>
+#include <mmx/Node_watch_balances_return.hxx>
 #include <mmx/Partial.hxx>
 #include <mmx/ProofOfTime.hxx>
 #include <mmx/ProofResponse.hxx>
@@ -1281,6 +1283,20 @@ void NodeClient::revert_sync_async(const uint32_t& height) {
 	vnx_request(_method, true);
 }
 
+void NodeClient::watch_balances(const std::vector<::mmx::addr_t>& addresses, const ::mmx::hash_t& client) {
+	auto _method = ::mmx::Node_watch_balances::create();
+	_method->addresses = addresses;
+	_method->client = client;
+	vnx_request(_method, false);
+}
+
+void NodeClient::watch_balances_async(const std::vector<::mmx::addr_t>& addresses, const ::mmx::hash_t& client) {
+	auto _method = ::mmx::Node_watch_balances::create();
+	_method->addresses = addresses;
+	_method->client = client;
+	vnx_request(_method, true);
+}
+
 std::shared_ptr<const ::vnx::addons::HttpResponse> NodeClient::http_request(std::shared_ptr<const ::vnx::addons::HttpRequest> request, const std::string& sub_path) {
 	auto _method = ::vnx::addons::HttpComponent_http_request::create();
 	_method->request = request;
@@ -0,0 +1,232 @@
+
+// AUTO GENERATED by vnxcppcodegen
+
+#include <mmx/package.hxx>
+#include <mmx/Node_watch_balances.hxx>
+#include <mmx/Node_watch_balances_return.hxx>
+#include <mmx/addr_t.hpp>
+#include <mmx/hash_t.hpp>
+#include <vnx/Value.h>
+
+#include <vnx/vnx.h>
+
+
+namespace mmx {
+
+
+const vnx::Hash64 Node_watch_balances::VNX_TYPE_HASH(0x8b62c44bc8b48162ull);
+const vnx::Hash64 Node_watch_balances::VNX_CODE_HASH(0x5c0e7a3b19d4f862ull);
+
+vnx::Hash64 Node_watch_balances::get_type_hash() const {
+	return VNX_TYPE_HASH;
+}
+
+std::string Node_watch_balances::get_type_name() const {
+	return "mmx.Node.watch_balances";
+}
+
+const vnx::TypeCode* Node_watch_balances::get_type_code() const {
+	return mmx::vnx_native_type_code_Node_watch_balances;
+}
+
+std::shared_ptr<Node_watch_balances> Node_watch_balances::create() {
+	return std::make_shared<Node_watch_balances>();
+}
+
+std::shared_ptr<vnx::Value> Node_watch_balances::clone() const {
+	return std::make_shared<Node_watch_balances>(*this);
+}
+
+void Node_watch_balances::read(vnx::TypeInput& _in, const vnx::TypeCode* _type_code, const uint16_t* _code) {
+	vnx::read(_in, *this, _type_code, _code);
+}
+
+void Node_watch_balances::write(vnx::TypeOutput& _out, const vnx::TypeCode* _type_code, const uint16_t* _code) const {
+	vnx::write(_out, *this, _type_code, _code);
+}
+
+void Node_watch_balances::accept(vnx::Visitor& _visitor) const {
+	const vnx::TypeCode* _type_code = mmx::vnx_native_type_code_Node_watch_balances;
+	_visitor.type_begin(*_type_code);
+	_visitor.type_field(_type_code->fields[0], 0); vnx::accept(_visitor, addresses);
+	_visitor.type_field(_type_code->fields[1], 1); vnx::accept(_visitor, client);
+	_visitor.type_end(*_type_code);
+}
+
+void Node_watch_balances::write(std::ostream& _out) const {
+	_out << "{\"__type\": \"mmx.Node.watch_balances\"";
+	_out << ", \"addresses\": "; vnx::write(_out, addresses);
+	_out << ", \"client\": "; vnx::write(_out, client);
+	_out << "}";
+}
+
+void Node_watch_balances::read(std::istream& _in) {
+	if(auto _json = vnx::read_json(_in)) {
+		from_object(_json->to_object());
+	}
+}
+
+vnx::Object Node_watch_balances::to_object() const {
+	vnx::Object _object;
+	_object["__type"] = "mmx.Node.watch_balances";
+	_object["addresses"] = addresses;
+	_object["client"] = client;
+	return _object;
+}
+
+void Node_watch_balances::from_object(const vnx::Object& _object) {
+	for(const auto& _entry : _object.field) {
+		if(_entry.first == "addresses") {
+			_entry.second.to(addresses);
+		} else if(_entry.first == "client") {
+			_entry.second.to(client);
+		}
+	}
+}
+
+vnx::Variant Node_watch_balances::get_field(const std::string& _name) const {
+	if(_name == "addresses") {
+		return vnx::Variant(addresses);
+	}
+	if(_name == "client") {
+		return vnx::Variant(client);
+	}
+	return vnx::Variant();
+}
+
+void Node_watch_balances::set_field(const std::string& _name, const vnx::Variant& _value) {
+	if(_name == "addresses") {
+		_value.to(addresses);
+	} else if(_name == "client") {
+		_value.to(client);
+	}
+}
+
+/// \private
+std::ostream& operator<<(std::ostream& _out, const Node_watch_balances& _value) {
+	_value.write(_out);
+	return _out;
+}
+
+/// \private
+std::istream& operator>>(std::istream& _in, Node_watch_balances& _value) {
+	_value.read(_in);
+	return _in;
+}
+
+const vnx::TypeCode* Node_watch_balances::static_get_type_code() {
+	const vnx::TypeCode* type_code = vnx::get_type_code(VNX_TYPE_HASH);
+	if(!type_code) {
+		type_code = vnx::register_type_code(static_create_type_code());
+	}
+	return type_code;
+}
+
+std::shared_ptr<vnx::TypeCode> Node_watch_balances::static_create_type_code() {
+	auto type_code = std::make_shared<vnx::TypeCode>();
+	type_code->name = "mmx.Node.watch_balances";
+	type_code->type_hash = vnx::Hash64(0x8b62c44bc8b48162ull);
+	type_code->code_hash = vnx::Hash64(0x5c0e7a3b19d4f862ull);
+	type_code->is_native = true;
+	type_code->is_class = true;
+	type_code->is_method = true;
+	type_code->native_size = sizeof(::mmx::Node_watch_balances);
+	type_code->create_value = []() -> std::shared_ptr<vnx::Value> { return std::make_shared<Node_watch_balances>(); };
+	type_code->return_type = ::mmx::Node_watch_balances_return::static_get_type_code();
+	type_code->fields.resize(2);
+	{
+		auto& field = type_code->fields[0];
+		field.is_extended = true;
+		field.name = "addresses";
+		field.code = {12, 11, 32, 1};
+	}
+	{
+		auto& field = type_code->fields[1];
+		field.is_extended = true;
+		field.name = "client";
+		field.code = {11, 32, 1};
+	}
+	type_code->permission = "mmx.permission_e.REMOTE";
+	type_code->build();
+	return type_code;
+}
+
+
+} // namespace mmx
+
+
+namespace vnx {
+
+void read(TypeInput& in, ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code) {
+	TypeInput::recursion_t tag(in);
+	if(code) {
+		switch(code[0]) {
+			case CODE_OBJECT:
+			case CODE_ALT_OBJECT: {
+				Object tmp;
+				vnx::read(in, tmp, type_code, code);
+				value.from_object(tmp);
+				return;
+			}
+			case CODE_DYNAMIC:
+			case CODE_ALT_DYNAMIC:
+				vnx::read_dynamic(in, value);
+				return;
+		}
+	}
+	if(!type_code) {
+		vnx::skip(in, type_code, code);
+		return;
+	}
+	if(code) {
+		switch(code[0]) {
+			case CODE_STRUCT: type_code = type_code->depends[code[1]]; break;
+			case CODE_ALT_STRUCT: type_code = type_code->depends[vnx::flip_bytes(code[1])]; break;
+			default: {
+				vnx::skip(in, type_code, code);
+				return;
+			}
+		}
+	}
+	in.read(type_code->total_field_size);
+	if(type_code->is_matched) {
+	}
+	for(const auto* _field : type_code->ext_fields) {
+		switch(_field->native_index) {
+			case 0: vnx::read(in, value.addresses, type_code, _field->code.data()); break;
+			case 1: vnx::read(in, value.client, type_code, _field->code.data()); break;
+			default: vnx::skip(in, type_code, _field->code.data());
+		}
+	}
+}
+
+void write(TypeOutput& out, const ::mmx::Node_watch_balances& value, const TypeCode* type_code, const uint16_t* code) {
+	if(code && code[0] == CODE_OBJECT) {
+		vnx::write(out, value.to_object(), nullptr, code);
+		return;
+	}
+	if(!type_code || (code && code[0] == CODE_ANY)) {
+		type_code = mmx::vnx_native_type_code_Node_watch_balances;
+		out.write_type_code(type_code);
+		vnx::write_class_header<::mmx::Node_watch_balances>(out);
+	}
+	else if(code && code[0] == CODE_STRUCT) {
+		type_code = type_code->depends[code[1]];
+	}
+	vnx::write(out, value.addresses, type_code, type_code->fields[0].code.data());
+	vnx::write(out, value.client, type_code, type_code->fields[1].code.data());
+}
+
+void read(std::istream& in, ::mmx::Node_watch_balances& value) {
+	value.read(in);
+}
+
+void write(std::ostream& out, const ::mmx::Node_watch_balances& value) {
+	value.write(out);
+}
+
+void accept(Visitor& visitor, const ::mmx::Node_watch_balances& value) {
+	value.accept(visitor);
+}
+
+} // vnx
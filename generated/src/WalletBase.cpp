@@ -4,6 +4,7 @@
 #include <mmx/package.hxx>
 #include <mmx/WalletBase.hxx>
 #include <vnx/NoSuchMethod.hxx>
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/Contract.hxx>
 #include <mmx/KeyFile.hxx>
 #include <mmx/Solution.hxx>
@@ -177,7 +178,7 @@ namespace mmx {
 
 
 const vnx::Hash64 WalletBase::VNX_TYPE_HASH(0x62207fd96d3aead7ull);
-const vnx::Hash64 WalletBase::VNX_CODE_HASH(0xb77c4f1e4e419a4ull);
+const vnx::Hash64 WalletBase::VNX_CODE_HASH(0xc50d9dc11fad8071ull);
 
 WalletBase::WalletBase(const std::string& _vnx_name)
 	:	Module::Module(_vnx_name)
@@ -195,6 +196,8 @@ WalletBase::WalletBase(const std::string& _vnx_name)
 	vnx::read_config(vnx_name + ".lock_timeout_sec", lock_timeout_sec);
 	vnx::read_config(vnx_name + ".cache_timeout_ms", cache_timeout_ms);
 	vnx::read_config(vnx_name + ".token_whitelist", token_whitelist);
+	vnx::read_config(vnx_name + ".input_balance_deltas", input_balance_deltas);
+	vnx::read_config(vnx_name + ".cache_refresh_ms", cache_refresh_ms);
 }
 
 vnx::Hash64 WalletBase::get_type_hash() const {
@@ -225,6 +228,8 @@ void WalletBase::accept(vnx::Visitor& _visitor) const {
 	_visitor.type_field(_type_code->fields[10], 10); vnx::accept(_visitor, lock_timeout_sec);
 	_visitor.type_field(_type_code->fields[11], 11); vnx::accept(_visitor, cache_timeout_ms);
 	_visitor.type_field(_type_code->fields[12], 12); vnx::accept(_visitor, token_whitelist);
+	_visitor.type_field(_type_code->fields[13], 13); vnx::accept(_visitor, input_balance_deltas);
+	_visitor.type_field(_type_code->fields[14], 14); vnx::accept(_visitor, cache_refresh_ms);
 	_visitor.type_end(*_type_code);
 }
 
@@ -243,6 +248,8 @@ void WalletBase::write(std::ostream& _out) const {
 	_out << ", \"lock_timeout_sec\": "; vnx::write(_out, lock_timeout_sec);
 	_out << ", \"cache_timeout_ms\": "; vnx::write(_out, cache_timeout_ms);
 	_out << ", \"token_whitelist\": "; vnx::write(_out, token_whitelist);
+	_out << ", \"input_balance_deltas\": "; vnx::write(_out, input_balance_deltas);
+	_out << ", \"cache_refresh_ms\": "; vnx::write(_out, cache_refresh_ms);
 	_out << "}";
 }
 
@@ -268,6 +275,8 @@ vnx::Object WalletBase::to_object() const {
 	_object["lock_timeout_sec"] = lock_timeout_sec;
 	_object["cache_timeout_ms"] = cache_timeout_ms;
 	_object["token_whitelist"] = token_whitelist;
+	_object["input_balance_deltas"] = input_balance_deltas;
+	_object["cache_refresh_ms"] = cache_refresh_ms;
 	return _object;
 }
 
@@ -275,6 +284,8 @@ void WalletBase::from_object(const vnx::Object& _object) {
 	for(const auto& _entry : _object.field) {
 		if(_entry.first == "accounts") {
 			_entry.second.to(accounts);
+		} else if(_entry.first == "cache_refresh_ms") {
+			_entry.second.to(cache_refresh_ms);
 		} else if(_entry.first == "cache_timeout_ms") {
 			_entry.second.to(cache_timeout_ms);
 		} else if(_entry.first == "config_path") {
@@ -283,6 +294,8 @@ void WalletBase::from_object(const vnx::Object& _object) {
 			_entry.second.to(database_path);
 		} else if(_entry.first == "default_expire") {
 			_entry.second.to(default_expire);
+		} else if(_entry.first == "input_balance_deltas") {
+			_entry.second.to(input_balance_deltas);
 		} else if(_entry.first == "key_files") {
 			_entry.second.to(key_files);
 		} else if(_entry.first == "lock_timeout_sec") {
@@ -343,6 +356,12 @@ vnx::Variant WalletBase::get_field(const std::string& _name) const {
 	if(_name == "token_whitelist") {
 		return vnx::Variant(token_whitelist);
 	}
+	if(_name == "input_balance_deltas") {
+		return vnx::Variant(input_balance_deltas);
+	}
+	if(_name == "cache_refresh_ms") {
+		return vnx::Variant(cache_refresh_ms);
+	}
 	return vnx::Variant();
 }
 
@@ -373,6 +392,10 @@ void WalletBase::set_field(const std::string& _name, const vnx::Variant& _value)
 		_value.to(cache_timeout_ms);
 	} else if(_name == "token_whitelist") {
 		_value.to(token_whitelist);
+	} else if(_name == "input_balance_deltas") {
+		_value.to(input_balance_deltas);
+	} else if(_name == "cache_refresh_ms") {
+		_value.to(cache_refresh_ms);
 	}
 }
 
@@ -400,7 +423,7 @@ std::shared_ptr<vnx::TypeCode> WalletBase::static_create_type_code() {
 	auto type_code = std::make_shared<vnx::TypeCode>();
 	type_code->name = "mmx.Wallet";
 	type_code->type_hash = vnx::Hash64(0x62207fd96d3aead7ull);
-	type_code->code_hash = vnx::Hash64(0xb77c4f1e4e419a4ull);
+	type_code->code_hash = vnx::Hash64(0xc50d9dc11fad8071ull);
 	type_code->is_native = true;
 	type_code->native_size = sizeof(::mmx::WalletBase);
 	type_code->depends.resize(1);
@@ -477,7 +500,7 @@ std::shared_ptr<vnx::TypeCode> WalletBase::static_create_type_code() {
 	type_code->methods[68] = ::vnx::ModuleInterface_vnx_stop::static_get_type_code();
 	type_code->methods[69] = ::vnx::addons::HttpComponent_http_request::static_get_type_code();
 	type_code->methods[70] = ::vnx::addons::HttpComponent_http_request_chunk::static_get_type_code();
-	type_code->fields.resize(13);
+	type_code->fields.resize(15);
 	{
 		auto& field = type_code->fields[0];
 		field.is_extended = true;
@@ -564,6 +587,20 @@ std::shared_ptr<vnx::TypeCode> WalletBase::static_create_type_code() {
 		field.name = "token_whitelist";
 		field.code = {12, 11, 32, 1};
 	}
+	{
+		auto& field = type_code->fields[13];
+		field.is_extended = true;
+		field.name = "input_balance_deltas";
+		field.value = vnx::to_string("node.balance_deltas");
+		field.code = {12, 5};
+	}
+	{
+		auto& field = type_code->fields[14];
+		field.data_size = 4;
+		field.name = "cache_refresh_ms";
+		field.value = vnx::to_string(60000);
+		field.code = {7};
+	}
 	type_code->build();
 	return type_code;
 }
@@ -572,6 +609,9 @@ void WalletBase::vnx_handle_switch(std::shared_ptr<const vnx::Value> _value) {
 	const auto* _type_code = _value->get_type_code();
 	while(_type_code) {
 		switch(_type_code->type_hash) {
+			case 0x52bf80a78e7e8601ull:
+				handle(std::static_pointer_cast<const ::mmx::BalanceDelta>(_value));
+				return;
 			default:
 				_type_code = _type_code->super;
 		}
@@ -1080,6 +1120,9 @@ void read(TypeInput& in, ::mmx::WalletBase& value, const TypeCode* type_code, co
 		if(const auto* const _field = type_code->field_map[11]) {
 			vnx::read_value(_buf + _field->offset, value.cache_timeout_ms, _field->code.data());
 		}
+		if(const auto* const _field = type_code->field_map[14]) {
+			vnx::read_value(_buf + _field->offset, value.cache_refresh_ms, _field->code.data());
+		}
 	}
 	for(const auto* _field : type_code->ext_fields) {
 		switch(_field->native_index) {
@@ -1090,6 +1133,7 @@ void read(TypeInput& in, ::mmx::WalletBase& value, const TypeCode* type_code, co
 			case 4: vnx::read(in, value.database_path, type_code, _field->code.data()); break;
 			case 5: vnx::read(in, value.node_server, type_code, _field->code.data()); break;
 			case 12: vnx::read(in, value.token_whitelist, type_code, _field->code.data()); break;
+			case 13: vnx::read(in, value.input_balance_deltas, type_code, _field->code.data()); break;
 			default: vnx::skip(in, type_code, _field->code.data());
 		}
 	}
@@ -1108,13 +1152,14 @@ void write(TypeOutput& out, const ::mmx::WalletBase& value, const TypeCode* type
 	else if(code && code[0] == CODE_STRUCT) {
 		type_code = type_code->depends[code[1]];
 	}
-	auto* const _buf = out.write(24);
+	auto* const _buf = out.write(28);
 	vnx::write_value(_buf + 0, value.max_key_files);
 	vnx::write_value(_buf + 4, value.num_addresses);
 	vnx::write_value(_buf + 8, value.max_addresses);
 	vnx::write_value(_buf + 12, value.default_expire);
 	vnx::write_value(_buf + 16, value.lock_timeout_sec);
 	vnx::write_value(_buf + 20, value.cache_timeout_ms);
+	vnx::write_value(_buf + 24, value.cache_refresh_ms);
 	vnx::write(out, value.key_files, type_code, type_code->fields[0].code.data());
 	vnx::write(out, value.accounts, type_code, type_code->fields[1].code.data());
 	vnx::write(out, value.config_path, type_code, type_code->fields[2].code.data());
@@ -1122,6 +1167,7 @@ void write(TypeOutput& out, const ::mmx::WalletBase& value, const TypeCode* type
 	vnx::write(out, value.database_path, type_code, type_code->fields[4].code.data());
 	vnx::write(out, value.node_server, type_code, type_code->fields[5].code.data());
 	vnx::write(out, value.token_whitelist, type_code, type_code->fields[12].code.data());
+	vnx::write(out, value.input_balance_deltas, type_code, type_code->fields[13].code.data());
 }
 
 void read(std::istream& in, ::mmx::WalletBase& value) {
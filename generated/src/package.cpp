@@ -1,6 +1,7 @@
 
 // AUTO GENERATED by vnxcppcodegen
 
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/Block.hxx>
 #include <mmx/BlockHeader.hxx>
 #include <mmx/ChainParams.hxx>
@@ -190,6 +191,8 @@
 #include <mmx/Node_verify_partial_return.hxx>
 #include <mmx/Node_verify_plot_nft_target.hxx>
 #include <mmx/Node_verify_plot_nft_target_return.hxx>
+#include <mmx/Node_watch_balances.hxx>
+#include <mmx/Node_watch_balances_return.hxx>
 #include <mmx/Operation.hxx>
 #include <mmx/Partial.hxx>
 #include <mmx/PeerInfo.hxx>
@@ -421,6 +424,18 @@
 
 namespace vnx {
 
+const TypeCode* type<::mmx::BalanceDelta>::get_type_code() {
+	return mmx::vnx_native_type_code_BalanceDelta;
+}
+
+void type<::mmx::BalanceDelta>::create_dynamic_code(std::vector<uint16_t>& code) {
+	create_dynamic_code(code, ::mmx::BalanceDelta());
+}
+
+void type<::mmx::BalanceDelta>::create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::BalanceDelta& value, bool special) {
+	code.push_back(CODE_OBJECT);
+}
+
 const TypeCode* type<::mmx::Block>::get_type_code() {
 	return mmx::vnx_native_type_code_Block;
 }
@@ -2653,6 +2668,30 @@ void type<::mmx::Node_verify_plot_nft_target_return>::create_dynamic_code(std::v
 	code.push_back(CODE_OBJECT);
 }
 
+const TypeCode* type<::mmx::Node_watch_balances>::get_type_code() {
+	return mmx::vnx_native_type_code_Node_watch_balances;
+}
+
+void type<::mmx::Node_watch_balances>::create_dynamic_code(std::vector<uint16_t>& code) {
+	create_dynamic_code(code, ::mmx::Node_watch_balances());
+}
+
+void type<::mmx::Node_watch_balances>::create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::Node_watch_balances& value, bool special) {
+	code.push_back(CODE_OBJECT);
+}
+
+const TypeCode* type<::mmx::Node_watch_balances_return>::get_type_code() {
+	return mmx::vnx_native_type_code_Node_watch_balances_return;
+}
+
+void type<::mmx::Node_watch_balances_return>::create_dynamic_code(std::vector<uint16_t>& code) {
+	create_dynamic_code(code, ::mmx::Node_watch_balances_return());
+}
+
+void type<::mmx::Node_watch_balances_return>::create_dynamic_code(std::vector<uint16_t>& code, const ::mmx::Node_watch_balances_return& value, bool special) {
+	code.push_back(CODE_OBJECT);
+}
+
 const TypeCode* type<::mmx::Operation>::get_type_code() {
 	return mmx::vnx_native_type_code_Operation;
 }
@@ -5301,6 +5340,7 @@ namespace mmx {
 
 
 void register_all_types() {
+	vnx::register_type_code(::mmx::BalanceDelta::static_create_type_code());
 	vnx::register_type_code(::mmx::Block::static_create_type_code());
 	vnx::register_type_code(::mmx::BlockHeader::static_create_type_code());
 	vnx::register_type_code(::mmx::ChainParams::static_create_type_code());
@@ -5490,6 +5530,8 @@ void register_all_types() {
 	vnx::register_type_code(::mmx::Node_verify_partial_return::static_create_type_code());
 	vnx::register_type_code(::mmx::Node_verify_plot_nft_target::static_create_type_code());
 	vnx::register_type_code(::mmx::Node_verify_plot_nft_target_return::static_create_type_code());
+	vnx::register_type_code(::mmx::Node_watch_balances::static_create_type_code());
+	vnx::register_type_code(::mmx::Node_watch_balances_return::static_create_type_code());
 	vnx::register_type_code(::mmx::Operation::static_create_type_code());
 	vnx::register_type_code(::mmx::Partial::static_create_type_code());
 	vnx::register_type_code(::mmx::PeerInfo::static_create_type_code());
@@ -5713,6 +5755,7 @@ static struct vnx_static_init {
 	}
 } vnx_static_init_;
 
+const vnx::TypeCode* const vnx_native_type_code_BalanceDelta = vnx::get_type_code(vnx::Hash64(0x52bf80a78e7e8601ull));
 const vnx::TypeCode* const vnx_native_type_code_Block = vnx::get_type_code(vnx::Hash64(0x94965d816d328467ull));
 const vnx::TypeCode* const vnx_native_type_code_BlockHeader = vnx::get_type_code(vnx::Hash64(0xcaae941a2fc712a6ull));
 const vnx::TypeCode* const vnx_native_type_code_ChainParams = vnx::get_type_code(vnx::Hash64(0x51bba8d28881e8e7ull));
@@ -5902,6 +5945,8 @@ const vnx::TypeCode* const vnx_native_type_code_Node_verify_partial = vnx::get_t
 const vnx::TypeCode* const vnx_native_type_code_Node_verify_partial_return = vnx::get_type_code(vnx::Hash64(0xb64fb769c6ffcf36ull));
 const vnx::TypeCode* const vnx_native_type_code_Node_verify_plot_nft_target = vnx::get_type_code(vnx::Hash64(0xf3ac786edcae50e1ull));
 const vnx::TypeCode* const vnx_native_type_code_Node_verify_plot_nft_target_return = vnx::get_type_code(vnx::Hash64(0x82f0f6ed43a0c4bull));
+const vnx::TypeCode* const vnx_native_type_code_Node_watch_balances = vnx::get_type_code(vnx::Hash64(0x8b62c44bc8b48162ull));
+const vnx::TypeCode* const vnx_native_type_code_Node_watch_balances_return = vnx::get_type_code(vnx::Hash64(0xeb753537dcd7a72eull));
 const vnx::TypeCode* const vnx_native_type_code_Operation = vnx::get_type_code(vnx::Hash64(0xfd69dd82e906e619ull));
 const vnx::TypeCode* const vnx_native_type_code_Partial = vnx::get_type_code(vnx::Hash64(0x2c849b13a7efd71aull));
 const vnx::TypeCode* const vnx_native_type_code_PeerInfo = vnx::get_type_code(vnx::Hash64(0xf7a37f624c94a121ull));
@@ -11,8 +11,15 @@
 #include <vnx/File.h>
 #include <vnx/ThreadPool.h>
 
+#include <list>
+#include <cstddef>
 #include <fstream>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
 
 
 namespace mmx {
@@ -77,19 +84,159 @@ struct db_val_t {
 	}
 };
 
+struct bloom_filter_t {
+	uint32_t num_hashes = 0;
+	std::vector<uint8_t> bits;
+
+	void init(const uint64_t num_keys, const uint32_t bits_per_key);
+
+	void add(const db_val_t& key);
+
+	bool may_contain(const db_val_t& key) const;
+
+	bool empty() const {
+		return bits.empty();
+	}
+};
+
+/*
+ * Sharded LRU cache of decoded keys / values read from disk, shared by all tables of a DataBase.
+ */
+class BlockCache {
+public:
+	struct entry_t {
+		uint32_t version = 0;
+		std::shared_ptr<db_val_t> data;
+	};
+
+	const size_t max_size;
+
+	BlockCache(const size_t max_size, const size_t num_shards = 16);
+
+	bool find(const uint64_t block_id, const int64_t offset, entry_t& entry);
+
+	void insert(const uint64_t block_id, const int64_t offset, const entry_t& entry);
+
+	size_t get_size() const;
+
+	size_t get_num_entries() const;
+
+private:
+	static constexpr size_t entry_overhead = 96;
+
+	struct key_t {
+		uint64_t block_id = 0;
+		int64_t offset = 0;
+		bool operator==(const key_t& other) const {
+			return block_id == other.block_id && offset == other.offset;
+		}
+	};
+
+	struct key_hash_t {
+		size_t operator()(const key_t& key) const {
+			return std::hash<uint64_t>{}(key.block_id * 0x9e3779b97f4a7c15ull + key.offset);
+		}
+	};
+
+	struct shard_t {
+		mutable std::mutex mutex;
+		size_t size = 0;
+		std::list<std::pair<key_t, entry_t>> list;
+		std::unordered_map<key_t, std::list<std::pair<key_t, entry_t>>::iterator, key_hash_t> map;
+	};
+
+	shard_t& get_shard(const key_t& key);
+
+	std::vector<shard_t> shards;
+
+};
+
+/*
+ * Bump allocator for the memtable, memory is only released as a whole.
+ */
+class MemArena {
+public:
+	static constexpr size_t chunk_size = 1024 * 1024;
+
+	MemArena() = default;
+	MemArena(const MemArena&) = delete;
+	MemArena& operator=(const MemArena&) = delete;
+
+	void* allocate(const size_t num_bytes, const size_t align = alignof(std::max_align_t));
+
+	db_val_t* copy(const db_val_t& value);		// returned object must not be deleted
+
+	void reset();		// re-uses first chunk
+
+	size_t get_size() const {
+		return total_size;
+	}
+
+private:
+	std::vector<std::pair<std::unique_ptr<uint8_t[]>, size_t>> chunks;
+	size_t chunk_left = 0;
+	uint8_t* chunk_pos = nullptr;
+	size_t total_size = 0;
+
+};
+
+template<typename T>
+struct arena_allocator_t {
+	typedef T value_type;
+
+	MemArena* arena = nullptr;
+
+	arena_allocator_t(MemArena* arena) : arena(arena) {}
+
+	template<typename U>
+	arena_allocator_t(const arena_allocator_t<U>& other) : arena(other.arena) {}
+
+	T* allocate(const size_t n) {
+		return (T*)arena->allocate(n * sizeof(T), alignof(T));
+	}
+	void deallocate(T* p, const size_t n) {}
+
+	template<typename U>
+	bool operator==(const arena_allocator_t<U>& other) const {
+		return arena == other.arena;
+	}
+	template<typename U>
+	bool operator!=(const arena_allocator_t<U>& other) const {
+		return arena != other.arena;
+	}
+};
+
 class Table {
 protected:
 	struct block_t {
+		uint64_t id = 0;					// unique in-memory id (for caching)
+		uint16_t format = 0;
 		uint32_t level = 0;
 		uint32_t min_version = 0;
 		uint32_t max_version = 0;
 		uint64_t total_count = 0;
+		uint64_t key_count = 0;				// number of distinct keys
 		int64_t index_offset = 0;
+		uint32_t fence_interval = 0;		// 0 = full index, otherwise index has one entry every N keys
 		vnx::File file;
 		std::string name;
 		std::vector<int64_t> index;
+		std::vector<uint64_t> fence_prefix;	// first 8 bytes of each fence key (big endian)
+		std::vector<uint32_t> fence_size;	// size of each fence key
+		std::vector<int64_t> chunk_offset;	// format 4: file offset of each compressed chunk (one per fence), plus end
+		std::vector<uint8_t> chunk;			// format 4: entries of the last fence, not yet compressed (while writing)
+		bloom_filter_t bloom;
+		bool remove_on_close = false;		// delete file once no longer referenced
+
+		~block_t() {
+			if(remove_on_close) {
+				file.remove();
+			}
+		}
 	};
 
+	typedef std::list<std::shared_ptr<block_t>> block_list_t;
+
 	struct key_compare_t {
 		const Table* table = nullptr;
 		key_compare_t(const Table* table) : table(table) {}
@@ -112,24 +259,45 @@ protected:
 		}
 	};
 
+	typedef std::map<std::shared_ptr<db_val_t>, std::pair<std::shared_ptr<db_val_t>, uint32_t>, key_compare_t,
+			arena_allocator_t<std::pair<const std::shared_ptr<db_val_t>, std::pair<std::shared_ptr<db_val_t>, uint32_t>>>> mem_index_t;
+
+	typedef std::map<std::pair<std::shared_ptr<db_val_t>, uint32_t>, std::shared_ptr<db_val_t>, mem_compare_t,
+			arena_allocator_t<std::pair<const std::pair<std::shared_ptr<db_val_t>, uint32_t>, std::shared_ptr<db_val_t>>>> mem_block_t;
+
 public:
 	struct options_t {
 		size_t level_factor = 4;
 		size_t max_block_size = 4 * 1024 * 1024;
 		size_t force_flush_threshold = 100000;
+		size_t bloom_bits_per_key = 10;			// 0 = disable bloom filters for new blocks
+		size_t fence_interval = 0;				// 0 = full index for new blocks, otherwise sparse index with one key every N
+		bool prefix_keys = false;				// prefix compress keys in new blocks (requires fence_interval)
+		int compress_level = 0;					// zstd compress entries of new blocks, 0 = off (requires prefix_keys)
+		bool auto_compact = true;				// merge blocks in the background (shared pool), otherwise only in compact()
 		std::function<int(const db_val_t&, const db_val_t&)> comparator = default_comparator;
 	};
 
 	const options_t options;
 	const std::string root_path;
 
+	const bool is_default_order;
+
 	Table(const std::string& file_path, const options_t& options = default_options);
 
+	~Table();
+
 	void insert(std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value);
 
 	std::shared_ptr<db_val_t> find(std::shared_ptr<db_val_t> key, const uint32_t max_version = -1) const;
 
-	bool commit(const uint32_t new_version, const bool auto_flush = true);
+	// returns values in same order as keys (nullptr if not found), batches of adjacent keys run in parallel if threads given
+	std::vector<std::shared_ptr<db_val_t>> find_many(
+			const std::vector<std::shared_ptr<db_val_t>>& keys, const uint32_t max_version = -1, vnx::ThreadPool* threads = nullptr) const;
+
+	bool commit(const uint32_t new_version, const bool auto_flush = true, const bool flush_log = true);
+
+	void flush_log();
 
 	void revert(const uint32_t new_version);
 
@@ -137,10 +305,18 @@ public:
 
 	void flush();
 
+	void schedule_flush();		// modifications wait until the next flush() is done
+
+	void compact();		// merge level blocks now, blocks until done
+
 	uint32_t current_version() const {
 		return curr_version;
 	}
 
+	void set_cache(std::shared_ptr<BlockCache> cache);
+
+	size_t get_mem_size() const;		// memory held by the memtable arenas
+
 	class Iterator {
 	public:
 		Iterator() = default;
@@ -164,9 +340,10 @@ public:
 	private:
 		struct pointer_t {
 			size_t pos = -1;
+			int64_t offset = -1;
 			std::shared_ptr<const block_t> block;
 			std::shared_ptr<db_val_t> value;
-			std::map<std::shared_ptr<db_val_t>, std::pair<std::shared_ptr<db_val_t>, uint32_t>, key_compare_t>::const_iterator iter;
+			mem_index_t::const_iterator iter;
 		};
 
 		struct compare_t {
@@ -176,7 +353,7 @@ public:
 		};
 
 		void seek(std::shared_ptr<db_val_t> key, const int mode);
-		void seek(const std::list<std::shared_ptr<block_t>>& blocks, std::shared_ptr<db_val_t> key, const int mode);
+		void seek(const block_list_t& blocks, std::shared_ptr<db_val_t> key, const int mode);
 		std::map<std::pair<std::shared_ptr<db_val_t>, uint32_t>, pointer_t, key_compare_t>::const_iterator current() const;
 
 		int direction = 0;
@@ -192,23 +369,74 @@ public:
 private:
 	static constexpr uint32_t entry_overhead = 20;
 	static constexpr uint32_t block_header_size = 30;
+	static constexpr uint16_t block_format = 4;
+	static constexpr size_t find_batch_size = 64;		// keys per task in find_many()
+	static constexpr size_t find_max_tasks = 16;		// max tasks per find_many() call
 
 	void insert_entry(uint32_t version, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value);
 
 	std::shared_ptr<block_t> read_block(const std::string& name) const;
 
-	std::shared_ptr<db_val_t> find(std::shared_ptr<const block_t> block, std::shared_ptr<db_val_t> key, const uint32_t max_version = -1) const;
+	void read_key_at(std::shared_ptr<const block_t> block, const int64_t offset, uint32_t& version, std::shared_ptr<db_val_t>& key) const;
+
+	void read_value_at(std::shared_ptr<const block_t> block, const int64_t offset, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t>& value) const;
+
+	// returns a stream over the entries of a block, starting at offset (as if not compressed)
+	std::unique_ptr<vnx::InputStream> open_stream(std::shared_ptr<const block_t> block, const int64_t offset, const size_t buffer_size) const;
+
+	std::shared_ptr<db_val_t> find_mem(std::shared_ptr<db_val_t> key, const uint32_t max_version) const;
+
+	std::shared_ptr<db_val_t> find(std::shared_ptr<const block_t> block, std::shared_ptr<db_val_t> key, const uint32_t max_version = -1, size_t* hint = nullptr) const;
+
+	void find_sorted(	std::shared_ptr<const block_list_t> blocks, const std::vector<std::shared_ptr<db_val_t>>& keys,
+						std::vector<size_t> pending, std::vector<std::shared_ptr<db_val_t>>& out, const uint32_t max_version) const;
+
+	size_t lower_bound(std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match, int64_t& offset, const size_t begin = 0) const;
+
+	size_t lower_bound_sparse(std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match, int64_t& offset, const size_t begin = 0) const;
+
+	int compare_fence(std::shared_ptr<const block_t> block, const size_t index, const db_val_t& key) const;
+
+	int64_t get_offset(std::shared_ptr<const block_t> block, const size_t pos) const;
+
+	int64_t get_next_offset(std::shared_ptr<const block_t> block, const size_t pos, const int64_t offset) const;
 
-	size_t lower_bound(std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match) const;
+	void append_key(std::shared_ptr<block_t> block, const db_val_t& key) const;
 
-	std::shared_ptr<block_t> rewrite(std::list<std::shared_ptr<block_t>> blocks, const uint32_t level) const;
+	void write_block_entry(std::shared_ptr<block_t> block, uint32_t version, const db_val_t& key, const db_val_t& value, const db_val_t* prev) const;
 
-	void check_rewrite();
+	void write_block_chunk(std::shared_ptr<block_t> block) const;
+
+	std::shared_ptr<block_t> rewrite(const block_list_t& blocks, const uint32_t level) const;
+
+	bool check_rewrite(block_list_t& selected, uint32_t& level) const;
+
+	void flush_memtable();
+
+	void clear_memtable();
+
+	void wait_flush(std::unique_lock<std::mutex>& lock) const;
+
+	bool compact_step(std::unique_lock<std::mutex>& lock);
+
+	void schedule_compact();
+
+	void compact_task();
+
+	std::shared_ptr<const block_list_t> get_blocks() const;
+
+	void set_blocks(std::shared_ptr<const block_list_t> list);
 
 	void write_block_header(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const;
 
 	void write_block_index(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const;
 
+	void write_block_fences(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const;
+
+	void write_block_chunks(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const;
+
+	void write_block_bloom(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const;
+
 	std::shared_ptr<block_t> create_block(const uint32_t level, const std::string& name) const;
 
 	void finish_block(std::shared_ptr<block_t> block) const;
@@ -222,22 +450,50 @@ private:
 	uint64_t next_block_id = 0;
 
 	vnx::File write_log;
-	std::list<std::shared_ptr<block_t>> blocks;
+	std::shared_ptr<const block_list_t> blocks = std::make_shared<block_list_t>();		// copy-on-write
 
 	size_t mem_block_size = 0;
-	std::map<std::shared_ptr<db_val_t>, std::pair<std::shared_ptr<db_val_t>, uint32_t>, key_compare_t> mem_index;
-	std::map<std::pair<std::shared_ptr<db_val_t>, uint32_t>, std::shared_ptr<db_val_t>, mem_compare_t> mem_block;
+	size_t mem_waste_size = 0;								// arena bytes of overwritten / reverted entries
+	MemArena mem_nodes;										// map nodes, reset on flush
+	std::shared_ptr<MemArena> mem_data;						// keys / values, may outlive flush via find()
+	mem_index_t mem_index;
+	mem_block_t mem_block;
 
 	mutable std::mutex mutex;
+	mutable std::shared_mutex mem_mutex;					// protects memtable against readers
 	mutable int64_t write_lock = 0;
 
+	bool flush_pending = false;
+	mutable std::condition_variable flush_done;
+
+	bool do_exit = false;
+	bool do_compact = false;
+	bool is_compacting = false;
+	bool compact_queued = false;							// task pending or running in compact pool
+	std::condition_variable compact_done;
+
 	std::ofstream debug_log;
 
+	std::shared_ptr<BlockCache> cache;
+
+	mutable std::atomic<uint64_t> cache_hits {0};
+	mutable std::atomic<uint64_t> cache_misses {0};
+	mutable std::atomic<uint64_t> bloom_hits {0};			// block lookups skipped by bloom filter
+	mutable std::atomic<uint64_t> bloom_false_hits {0};		// bloom filter false positives
+
 };
 
 class DataBase {
 public:
-	DataBase(const int num_threads = 0);
+	struct commit_stats_t {
+		std::string name;
+		uint64_t num_commit = 0;
+		uint64_t num_flush = 0;
+		int64_t commit_time_us = 0;			// writing commit record (and log flush)
+		int64_t flush_time_us = 0;			// writing memtable to disk
+	};
+
+	DataBase(const int num_threads = 0, std::shared_ptr<BlockCache> cache = nullptr);
 
 	~DataBase();
 
@@ -253,10 +509,20 @@ public:
 
 	uint32_t recover();
 
+	// flush write logs every N versions and / or every N ms (0 = off), default is every version
+	void set_durability(const uint32_t sync_versions, const int64_t sync_interval_ms = 0);
+
+	void flush_log();
+
+	// don't wait for memtable flushes in commit(), tables being flushed block writers until done
+	void set_pipelined(const bool enable);
+
+	std::vector<commit_stats_t> get_commit_stats(const bool reset = false) const;
+
 	template<typename T>
-	void open_async(T& table, const std::string& path) {
-		threads.add_task([this, &table, path]() {
-			add(table.open(path));
+	void open_async(T& table, const std::string& path, const Table::options_t& options = Table::default_options) {
+		threads.add_task([this, &table, path, options]() {
+			add(table.open(path, options));
 		});
 	}
 
@@ -267,7 +533,17 @@ public:
 private:
 	mutable std::mutex mutex;
 	vnx::ThreadPool threads;
+	std::shared_ptr<BlockCache> cache;
 	std::vector<std::shared_ptr<Table>> tables;
+	std::vector<std::shared_ptr<commit_stats_t>> stats;
+
+	mutable std::mutex stats_mutex;
+
+	bool pipelined = false;
+	uint32_t sync_versions = 1;
+	int64_t sync_interval_ms = 0;
+	uint32_t last_sync_version = 0;
+	int64_t last_sync_ms = 0;
 
 };
 
@@ -9,6 +9,7 @@
 #define INCLUDE_MMX_ECDSA_WALLET_H_
 
 #include <mmx/Transaction.hxx>
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/ChainParams.hxx>
 #include <mmx/operation/Execute.hxx>
 #include <mmx/operation/Deposit.hxx>
@@ -192,9 +193,61 @@ public:
 						const std::vector<hash_t>& history, const uint32_t height)
 	{
 		this->height = height;
-		balance_map.clear();
-		balance_map.insert(balances.begin(), balances.end());
+		confirmed_map.clear();
+		confirmed_map.insert(balances.begin(), balances.end());
+
+		for(const auto& txid : history) {
+			pending_tx.erase(txid);
+			pending_map.erase(txid);
+		}
+		update_balances();
+	}
 
+	// returns false if delta does not connect to the current balances (need full update)
+	bool update_cache(std::shared_ptr<const BalanceDelta> delta, const std::set<addr_t>& whitelist)
+	{
+		if(!block_hash || delta->prev != *block_hash) {
+			return false;
+		}
+		for(const auto& address : delta->external) {
+			if(find_address(address) >= 0) {
+				return false;	// new contract or swap liquidity, need to update external_balance_map
+			}
+		}
+		const auto is_listed = [&whitelist](const txio_entry_t& entry) -> bool {
+			return whitelist.empty() || whitelist.count(entry.contract);
+		};
+		// same order as Node::apply()
+		for(const auto& out : delta->outputs) {
+			if(!is_listed(out)) {
+				continue;
+			}
+			if(find_address(out.address) >= 0) {
+				confirmed_map[std::make_pair(out.address, out.contract)] += out.amount;
+			} else if(contract_set.count(out.address)) {
+				external_balance_map[out.contract] += out.amount;
+			}
+		}
+		for(const auto& in : delta->inputs) {
+			if(is_listed(in)) {
+				if(find_address(in.address) >= 0) {
+					clamped_sub_assign(confirmed_map[std::make_pair(in.address, in.contract)], in.amount);
+				} else if(contract_set.count(in.address)) {
+					clamped_sub_assign(external_balance_map[in.contract], in.amount);
+				}
+			}
+			pending_tx.erase(in.txid);
+			pending_map.erase(in.txid);
+		}
+		height = delta->height;
+		block_hash = delta->hash;
+		update_balances();
+		return true;
+	}
+
+	// balance_map = confirmed_map - reserved_map - pending_map
+	void update_balances()
+	{
 		std::vector<hash_t> expired;
 		for(const auto& entry : pending_tx) {
 			if(entry.second < height) {
@@ -205,9 +258,11 @@ public:
 			pending_tx.erase(txid);
 			pending_map.erase(txid);
 		}
-		for(const auto& txid : history) {
-			pending_tx.erase(txid);
-			pending_map.erase(txid);
+		balance_map.clear();
+		for(const auto& entry : confirmed_map) {
+			if(entry.second) {
+				balance_map.insert(entry);
+			}
 		}
 		for(const auto& entry : reserved_map) {
 			clamped_sub_assign(balance_map[entry.first], entry.second);
@@ -542,18 +597,26 @@ public:
 	void reset_cache()
 	{
 		last_update = 0;
+		last_refresh = 0;
+		block_hash = nullptr;
 		balance_map.clear();
+		confirmed_map.clear();
 		reserved_map.clear();
 		external_balance_map.clear();
+		contract_set.clear();
 		pending_tx.clear();
 		pending_map.clear();
 	}
 
 	uint32_t height = 0;
 	int64_t last_update = 0;
+	int64_t last_refresh = 0;																	// last full update
+	vnx::optional<hash_t> block_hash;															// block confirmed_map is at (if known)
 	std::map<std::pair<addr_t, addr_t>, uint128_t> balance_map;									// [[address, currency] => balance]
+	std::map<std::pair<addr_t, addr_t>, uint128_t> confirmed_map;								// [[address, currency] => balance]
 	std::map<std::pair<addr_t, addr_t>, uint128_t> reserved_map;								// [[address, currency] => balance]
 	std::map<addr_t, uint128_t> external_balance_map;											// [currency => balance]
+	std::set<addr_t> contract_set;																// contracts owned by wallet addresses
 	std::unordered_map<hash_t, uint32_t> pending_tx;											// [txid => expired height]
 	std::unordered_map<hash_t, std::map<std::pair<addr_t, addr_t>, uint128_t>> pending_map;		// [txid => [[address, currency] => balance]]
 
@@ -38,6 +38,9 @@
 #include <unordered_map>
 #include <shared_mutex>
 #include <functional>
+#include <array>
+#include <atomic>
+#include <tuple>
 
 
 namespace mmx {
@@ -215,6 +218,8 @@ protected:
 
 	void revert_sync(const uint32_t& height) override;
 
+	void watch_balances(const std::vector<addr_t>& addresses, const hash_t& client) override;
+
 	void http_request_async(std::shared_ptr<const vnx::addons::HttpRequest> request, const std::string& sub_path,
 							const vnx::request_id_t& request_id) const override;
 
@@ -274,6 +279,24 @@ private:
 		std::shared_ptr<const execution_context_t> context;
 	};
 
+	enum sync_stage_e {
+		SYNC_VERIFY,			// block pre-validation (hashes + signature)
+		SYNC_PROOF,				// proof verification
+		SYNC_EXECUTE,			// transaction execution
+		SYNC_COMMIT,			// apply + commit
+		SYNC_NUM_STAGES
+	};
+
+	struct sync_stage_t {
+		uint64_t num_blocks = 0;
+		int64_t busy_time_us = 0;				// summed over threads
+	};
+
+	struct sig_verify_t {
+		std::vector<std::tuple<signature_t, pubkey_t, hash_t>> list;
+		std::atomic<int64_t> left {0};			// entries are taken from the back, execution starts at the front
+	};
+
 	struct tx_map_t {
 		uint32_t height = -1;
 		std::shared_ptr<const Transaction> tx;
@@ -285,6 +308,7 @@ private:
 		uint32_t cost = 0;
 		uint32_t fee = 0;
 		uint32_t luck = 0;	// random value
+		uint64_t num_bytes = 0;	// estimated memory usage
 		std::shared_ptr<const Transaction> tx;
 	};
 
@@ -308,20 +332,36 @@ private:
 
 	void print_stats();
 
+	void print_sync_stats();
+
+	void add_sync_stats(const sync_stage_e stage, const uint64_t num_blocks, const int64_t time_us);
+
+	bool pre_validate(std::shared_ptr<const Block> block) const;
+
+	void add_valid_block(std::shared_ptr<const Block> block);
+
 	void add_fork(std::shared_ptr<fork_t> fork);
 
 	bool tx_pool_update(const tx_pool_t& entry, const bool force_add = false);
 
 	void tx_pool_erase(const hash_t& txid);
 
+	size_t tx_pool_evict();
+
 	void purge_tx_pool();
 
+	bool is_template_tx(std::shared_ptr<const Transaction> tx) const;
+
+	void tx_template_update(std::shared_ptr<const Block> block, const std::vector<txio_entry_t>& block_inputs);
+
 	void validate_new();
 
 	void on_sync_done(const uint32_t height);
 
 	void on_stuck_timeout();
 
+	void on_checkpoint_failed(const std::string& reason);
+
 	std::vector<tx_pool_t> validate_for_block(const int64_t deadline_ms);
 
 	std::shared_ptr<const Block> make_block(
@@ -341,6 +381,8 @@ private:
 
 	void sync_result(const uint32_t& height, const std::vector<std::shared_ptr<const Block>>& blocks);
 
+	void sync_verified(const uint32_t& height, const size_t num_blocks, const std::vector<std::shared_ptr<const Block>>& blocks);
+
 	void fetch_block(const hash_t& hash);
 
 	void fetch_result(const hash_t& hash, std::shared_ptr<const Block> block);
@@ -383,7 +425,12 @@ private:
 					const std::function<void(std::shared_ptr<vm::Engine>)>& setup) const;
 
 	std::shared_ptr<const exec_result_t> validate(
-			std::shared_ptr<const Transaction> tx, std::shared_ptr<const execution_context_t> context) const;
+			std::shared_ptr<const Transaction> tx, std::shared_ptr<const execution_context_t> context,
+			std::shared_ptr<vm::Storage> backend = nullptr, std::shared_ptr<vm::StorageCache>* pending = nullptr) const;
+
+	void validate_optimistic(std::shared_ptr<const Block> block, std::shared_ptr<execution_context_t> context) const;
+
+	std::shared_ptr<sig_verify_t> verify_signatures(std::shared_ptr<const Block> block) const;
 
 	void validate_diff_adjust(const uint64_t& block, const uint64_t& prev) const;
 
@@ -395,12 +442,12 @@ private:
 
 	void verify(std::shared_ptr<const ProofResponse> value) const;
 
-	void verify_proof(std::shared_ptr<const BlockHeader> block) const;
+	void verify_proof(std::shared_ptr<const BlockHeader> block, const bool skip_pos = false) const;
 
 	template<typename T>
-	void verify_proof_impl(std::shared_ptr<const T> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height) const;
+	void verify_proof_impl(std::shared_ptr<const T> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height, const bool skip_pos = false) const;
 
-	void verify_proof(std::shared_ptr<const ProofOfSpace> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height) const;
+	void verify_proof(std::shared_ptr<const ProofOfSpace> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height, const bool skip_pos = false) const;
 
 	void verify_vdf(std::shared_ptr<const ProofOfTime> proof, const int64_t recv_time);
 
@@ -410,14 +457,20 @@ private:
 
 	void verify_vdf_task(std::shared_ptr<const ProofOfTime> proof, const int64_t recv_time) noexcept;
 
-	size_t prefetch_balances(const std::set<std::pair<addr_t, addr_t>>& keys) const;
-
 	void apply(	std::shared_ptr<const Block> block,
 				std::shared_ptr<const execution_context_t> context);
 
 	void apply(	std::shared_ptr<const Block> block,
 				std::shared_ptr<const Transaction> tx,
-				uint32_t& counter);
+				uint32_t& counter,
+				std::set<addr_t>& external);
+
+	void purge_balance_watch(const bool force = false);
+
+	void publish_balance_deltas(std::shared_ptr<const Block> block,
+								const std::vector<txio_entry_t>& inputs,
+								const std::vector<txio_entry_t>& outputs,
+								const std::set<addr_t>& external);
 
 	void revert(const uint32_t height);
 
@@ -495,6 +548,7 @@ private:
 	hash_t state_hash;
 	std::shared_ptr<DataBase> db;
 	std::shared_ptr<DataBase> db_blocks;
+	std::shared_ptr<BlockCache> db_cache;
 
 	hash_uint_uint_table<addr_t, uint32_t, uint32_t, txio_entry_t> txio_log;	// [[address, height, counter] => entry]
 	hash_uint_uint_table<addr_t, uint32_t, uint32_t, exec_entry_t> exec_log;	// [[address, height, counter] => entry]
@@ -517,7 +571,14 @@ private:
 
 	std::unordered_map<hash_t, tx_pool_t> tx_pool;									// [txid => transaction] (non-executed only)
 	std::unordered_map<addr_t, uint64_t> tx_pool_fees;								// [address => total pending fees]
+	std::set<std::pair<uint32_t, hash_t>> tx_pool_fee_index;						// [[fee ratio, txid]] (lowest first)
+	std::set<std::tuple<addr_t, uint32_t, hash_t>> tx_pool_sender_index;			// [[sender, fee ratio, txid]]
 	std::map<std::pair<hash_t, hash_t>, std::shared_ptr<const Transaction>> tx_pool_index;		// [[key, txid] => tx]
+	std::unordered_map<hash_t, tx_pool_t> tx_template;								// [txid => executed transaction] (for tx_template_hash)
+	hash_t tx_template_hash;														// state the template was executed against
+	uint32_t tx_template_height = 0;												// height the template was executed for
+	std::unordered_map<hash_t, std::pair<int64_t, std::vector<addr_t>>> balance_watch;	// [client => [last update ms, addresses]]
+	std::unordered_set<addr_t> balance_watch_set;									// union of all balance_watch addresses
 	std::unordered_map<hash_t, std::shared_ptr<fork_t>> fork_tree;					// [block hash => fork] (pending only)
 	std::multimap<uint32_t, std::shared_ptr<fork_t>> fork_index;					// [height => fork] (pending only)
 	std::unordered_map<hash_t, std::shared_ptr<const BlockHeader>> history;			// cache [hash => block header]
@@ -540,6 +601,9 @@ private:
 	bool is_synced = false;
 	bool update_pending = false;
 	uint32_t min_pool_fee_ratio = 0;
+	uint64_t tx_pool_cost = 0;						// total static cost of tx pool
+	uint64_t tx_pool_bytes = 0;						// estimated memory usage of tx pool
+	uint64_t tx_pool_evicted = 0;					// total evicted due to max_tx_pool / max_tx_pool_mem
 	uint64_t mmx_address_count = 0;
 
 	std::shared_ptr<vnx::File> blocks;
@@ -561,7 +625,8 @@ private:
 	uint32_t synced_since = 0;								// height of last sync done
 	int64_t sync_finish_ms = 0;								// when peak was reached
 	double max_sync_pending = 0;
-	std::set<uint32_t> sync_pending;						// set of heights
+	std::set<uint32_t> sync_pending;						// set of heights (until pre-validated)
+	size_t sync_verify_pending = 0;							// number of blocks in pre-validation
 	vnx::optional<uint32_t> sync_peak;						// max height we can sync
 	std::unordered_set<hash_t> fetch_pending;				// block hash
 
@@ -599,6 +664,16 @@ private:
 	std::set<std::string> failed_fetch;
 	std::shared_ptr<vnx::ThreadPool> fetch_threads;
 
+	std::mutex sync_stats_mutex;
+	int64_t sync_stats_begin_us = 0;
+	std::array<sync_stage_t, SYNC_NUM_STAGES> sync_stats;
+	std::shared_ptr<vnx::ThreadPool> sync_threads;			// block pre-validation during sync
+	std::shared_ptr<vnx::ThreadPool> sig_threads;			// signature pre-verification, see verify_signatures()
+	int num_sig_threads = 0;
+
+	mutable std::atomic<uint64_t> sig_verify_count {0};		// see verify_signatures()
+	mutable std::atomic<int64_t> sig_verify_time_us {0};
+
 	friend class vnx::addons::HttpInterface<Node>;
 
 };
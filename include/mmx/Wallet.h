@@ -183,6 +183,8 @@ protected:
 	void http_request_chunk_async(	std::shared_ptr<const vnx::addons::HttpRequest> request, const std::string& sub_path,
 									const int64_t& offset, const int64_t& max_bytes, const vnx::request_id_t& request_id) const override;
 
+	void handle(std::shared_ptr<const BalanceDelta> value) override;
+
 private:
 	std::shared_ptr<ECDSA_Wallet> get_wallet(const uint32_t& index) const;
 
@@ -191,6 +193,8 @@ private:
 private:
 	std::shared_ptr<NodeClient> node;
 
+	hash_t watch_id;		// for Node::watch_balances()
+
 	std::vector<std::shared_ptr<ECDSA_Wallet>> wallets;
 
 	std::map<uint32_t, std::weak_ptr<vnx::Timer>> lock_timers;
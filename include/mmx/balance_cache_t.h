@@ -13,6 +13,7 @@
 #include <mmx/table.h>
 
 #include <map>
+#include <set>
 
 
 namespace mmx {
@@ -32,6 +33,9 @@ public:
 		const auto key = std::make_pair(address, contract);
 		auto iter = balance.find(key);
 		if(iter == balance.end()) {
+			if(missing.count(key)) {
+				return nullptr;
+			}
 			if(source) {
 				uint128 value = 0;
 				if(source->find(key, value)) {
@@ -59,6 +63,27 @@ public:
 		return balance[std::make_pair(address, contract)] = 0;
 	}
 
+	// load many balances from source at once (in parallel if threads given)
+	void prefetch(const std::set<std::pair<addr_t, addr_t>>& keys, vnx::ThreadPool* threads = nullptr)
+	{
+		if(!source) {
+			return;
+		}
+		std::vector<std::pair<addr_t, addr_t>> list;
+		for(const auto& key : keys) {
+			if(!balance.count(key) && !missing.count(key)) {
+				list.push_back(key);
+			}
+		}
+		source->find_many(list, balance, -1, threads);
+
+		for(const auto& key : list) {
+			if(!balance.count(key)) {
+				missing.insert(key);
+			}
+		}
+	}
+
 	void apply(const balance_cache_t& cache)
 	{
 		for(const auto& entry : cache.balance) {
@@ -69,6 +94,7 @@ public:
 	std::map<std::pair<addr_t, addr_t>, uint128> balance;
 
 private:
+	std::set<std::pair<addr_t, addr_t>> missing;		// known to not exist in source
 	balance_cache_t* parent = nullptr;
 	const balance_table_t<uint128>* source = nullptr;
 
@@ -33,6 +33,16 @@ public:
 
 	Prover(const std::string& file_path);
 
+	~Prover();
+
+	// reads first Y of each park, so that a lookup only needs to read the parks it needs
+	void load_index();
+
+	// RAM used by Y index [bytes]
+	size_t get_index_size() const {
+		return park_y_index.size() * sizeof(uint32_t);
+	}
+
 	std::vector<proof_data_t> get_qualities(const hash_t& challenge, const int plot_filter) const;
 
 	proof_data_t get_full_proof(const uint64_t final_index) const;
@@ -74,8 +84,13 @@ private:
 
 	std::shared_ptr<const PlotHeader> header;
 
+	std::vector<uint32_t> park_y_index;		// first Y of each park (optional)
+
 };
 
+// limit for cached plot file handles (shared by all provers), 0 = half the soft limit of open files
+size_t set_max_open_files(size_t count);
+
 
 } // pos
 } // mmx
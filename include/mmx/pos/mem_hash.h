@@ -26,6 +26,25 @@ void gen_mem_array(uint32_t* mem, const uint8_t* key, const uint32_t mem_size);
  */
 void calc_mem_hash(uint32_t* mem, uint8_t* hash, const int num_iter);
 
+/*
+ * Multi-lane versions, computing 8 / 16 independent hashes at once.
+ * mem = interleaved array of size mem_size x lanes (mem[i * lanes + lane])
+ * key = lanes x 64 bytes
+ * hash = lanes x 128 bytes
+ */
+void gen_mem_array_avx2_x8(uint32_t* mem, const uint8_t* key, const uint32_t mem_size);
+
+void calc_mem_hash_avx2_x8(uint32_t* mem, uint8_t* hash, const int num_iter);
+
+void gen_mem_array_avx512_x16(uint32_t* mem, const uint8_t* key, const uint32_t mem_size);
+
+void calc_mem_hash_avx512_x16(uint32_t* mem, uint8_t* hash, const int num_iter);
+
+/*
+ * Returns number of lanes for the fastest kernel available (16, 8 or 1).
+ */
+int get_mem_hash_lanes();
+
 
 } // pos
 } // mmx
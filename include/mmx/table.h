@@ -45,10 +45,10 @@ public:
 		close();
 	}
 
-	std::shared_ptr<Table> open(const std::string& file_path)
+	std::shared_ptr<Table> open(const std::string& file_path, const Table::options_t& options = Table::default_options)
 	{
 		close();
-		return db = std::make_shared<Table>(file_path);
+		return db = std::make_shared<Table>(file_path, options);
 	}
 
 	void close() {
@@ -76,6 +76,24 @@ public:
 		return false;
 	}
 
+	size_t find_many(const std::vector<K>& keys, std::map<K, V>& values, const uint32_t max_version = -1, vnx::ThreadPool* threads = nullptr) const
+	{
+		std::vector<std::shared_ptr<db_val_t>> list;
+		list.reserve(keys.size());
+		for(const auto& key : keys) {
+			list.push_back(write(key));
+		}
+		size_t count = 0;
+		const auto entries = db->find_many(list, max_version, threads);
+		for(size_t i = 0; i < entries.size(); ++i) {
+			if(const auto& entry = entries[i]) {
+				read(entry, values[keys[i]], value_type, value_code);
+				count++;
+			}
+		}
+		return count;
+	}
+
 	bool find_first(V& value) const
 	{
 		K dummy;
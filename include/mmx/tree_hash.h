@@ -9,6 +9,7 @@
 #define INCLUDE_MMX_TREE_HASH_H_
 
 #include <mmx/hash_t.hpp>
+#include <sha256_avx2.h>
 
 #include <vector>
 
@@ -18,23 +19,26 @@ namespace mmx {
 inline
 hash_t calc_btree_hash(const std::vector<hash_t>& input)
 {
+	static_assert(sizeof(hash_t) == 32, "sizeof(hash_t) != 32");
+
+	if(input.empty()) {
+		return hash_t();
+	}
+	// hash each level in-place, pairs of adjacent hashes are one 64 byte message
 	auto tmp = input;
-	while(tmp.size() > 1) {
-		std::vector<hash_t> next;
-		for(size_t i = 0; i < tmp.size(); i += 2)
-		{
-			if(i + 1 < tmp.size()) {
-				next.emplace_back(tmp[i] + tmp[i + 1]);
-			} else {
-				next.push_back(tmp[i]);
-			}
+	auto* data = (uint8_t*)tmp.data();
+	size_t count = tmp.size();
+	while(count > 1) {
+		const size_t num_pairs = count / 2;
+		sha256_64b_batch(data, data, num_pairs);
+		if(count % 2) {
+			tmp[num_pairs] = tmp[count - 1];
 		}
-		tmp = next;
+		count = num_pairs + (count % 2);
 	}
-	return tmp.empty() ? hash_t() : tmp[0];
+	return tmp[0];
 }
 
-
 } // mmx
 
 #endif /* INCLUDE_MMX_TREE_HASH_H_ */
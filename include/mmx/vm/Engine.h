@@ -13,6 +13,7 @@
 #include <mmx/vm/var_t.h>
 #include <mmx/vm/varptr_t.hpp>
 #include <mmx/vm/instr_t.h>
+#include <mmx/vm/Memory.h>
 #include <mmx/vm/Storage.h>
 #include <mmx/vm/StorageProxy.h>
 
@@ -78,6 +79,28 @@ enum globalvar_e : uint32_t {
 
 };
 
+static constexpr uint8_t OPMODE_STACK = (1 << 0);		// relative to stack frame
+static constexpr uint8_t OPMODE_REF = (1 << 1);		// dereference
+
+/*
+ * Instruction with operand modes resolved ahead of time, see decode().
+ */
+struct decoded_instr_t {
+
+	opcode_e code = OP_NOP;
+
+	uint8_t flags = 0;
+
+	uint8_t mode[4] = {};
+
+	uint32_t arg[4] = {};
+
+};
+
+decoded_instr_t decode(const instr_t& instr);
+
+std::vector<decoded_instr_t> decode(const std::vector<instr_t>& code);
+
 
 class Engine {
 public:
@@ -87,6 +110,7 @@ public:
 	};
 
 	std::vector<instr_t> code;
+	std::shared_ptr<const std::vector<decoded_instr_t>> shared_code;		// overrides code when set (see vm::load())
 	std::vector<frame_t> call_stack;
 
 	std::vector<txout_t> outputs;
@@ -191,6 +215,7 @@ public:
 	void call(const uint64_t instr_ptr, const uint64_t stack_ptr);
 	bool ret();
 	void exec(const instr_t& instr);
+	void exec(const decoded_instr_t& instr);
 
 	void commit();
 
@@ -221,15 +246,20 @@ private:
 	void erase(std::unique_ptr<var_t>& var);
 	void erase_entries(const uint64_t dst);
 
-	uint64_t deref_addr(uint32_t src, const bool flag);
-	uint64_t deref_value(uint32_t src, const bool flag);
+	uint64_t deref_addr(const decoded_instr_t& instr, const uint32_t i);
+	uint64_t deref_value(const decoded_instr_t& instr, const uint32_t i);
+
+	const decoded_instr_t* fetch(uint64_t* p_instr_ptr, const bool check = true);
+	void dispatch(const decoded_instr_t* instr, uint64_t* p_instr_ptr);
 
 	bool is_true(const uint64_t src);
 	bool is_true(const var_t& var);
 
 private:
 	bool have_init = false;
-	std::map<uint64_t, std::unique_ptr<var_t>> memory;
+	std::vector<decoded_instr_t> decoded;
+	const std::vector<decoded_instr_t>* program = nullptr;
+	Memory memory;
 	std::map<std::pair<uint64_t, uint64_t>, std::unique_ptr<var_t>> entries;
 	std::map<const var_t*, uint64_t, varptr_less_t> key_map;
 	std::map<addr_t, uint128_t> balance_map;
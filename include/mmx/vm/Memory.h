@@ -0,0 +1,176 @@
+#ifndef INCLUDE_MMX_VM_MEMORY_H_
+#define INCLUDE_MMX_VM_MEMORY_H_
+
+#include <mmx/vm/var_t.h>
+
+#include <map>
+#include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace mmx {
+namespace vm {
+
+/*
+ * Engine memory: const, extern and stack segments are stored in pages indexed by offset,
+ * static and heap addresses (which map to storage) are kept in a hash map.
+ * Addresses below MEM_STATIC that are too far into a segment fall back to an ordered map.
+ */
+class Memory {
+public:
+	static constexpr uint64_t PAGE_BITS = 8;
+	static constexpr uint64_t PAGE_SIZE = uint64_t(1) << PAGE_BITS;
+	static constexpr uint64_t MAX_PAGES = 4096;		// per segment
+
+	Memory() = default;
+	Memory(const Memory&) = delete;
+	Memory& operator=(const Memory&) = delete;
+
+	// returns nullptr if there is no slot, below MEM_STATIC an empty slot counts as no slot
+	std::unique_ptr<var_t>* find(const uint64_t addr)
+	{
+		if(addr < MEM_STATIC) {
+			const auto& seg = get_segment(addr);
+			const auto offset = addr - seg.base;
+			const auto index = offset >> PAGE_BITS;
+			if(index < MAX_PAGES) {
+				if(index < seg.pages.size()) {
+					if(auto page = seg.pages[index].get()) {
+						auto& var = (*page)[offset & (PAGE_SIZE - 1)];
+						return var ? &var : nullptr;
+					}
+				}
+				return nullptr;
+			}
+			auto iter = overflow.find(addr);
+			return iter != overflow.end() && iter->second ? &iter->second : nullptr;
+		}
+		auto iter = heap.find(addr);
+		return iter != heap.end() ? &iter->second : nullptr;
+	}
+
+	// creates slot if needed, returned reference stays valid until the slot is erased
+	std::unique_ptr<var_t>& operator[](const uint64_t addr)
+	{
+		if(addr < MEM_STATIC) {
+			auto& seg = get_segment(addr);
+			const auto offset = addr - seg.base;
+			const auto index = offset >> PAGE_BITS;
+			if(index < MAX_PAGES) {
+				if(index >= seg.pages.size()) {
+					seg.pages.resize(index + 1);
+				}
+				auto& page = seg.pages[index];
+				if(!page) {
+					page = std::make_unique<page_t>();
+				}
+				return (*page)[offset & (PAGE_SIZE - 1)];
+			}
+			return overflow[addr];
+		}
+		const auto res = heap.try_emplace(addr);
+		if(res.second) {
+			heap_added.emplace_back(addr, &res.first->second);
+		}
+		return res.first->second;
+	}
+
+	// calls func(addr, var) for every non-empty slot in [begin, end) in ascending order,
+	// func may reset var to erase it (but must not erase other slots or call for_each())
+	template<typename F>
+	void for_each(const uint64_t begin, const uint64_t end, const F& func)
+	{
+		for(auto& seg : segments) {
+			const auto seg_begin = std::max(begin, seg.base);
+			const auto seg_end = std::min(end, seg.end);
+			if(seg_begin >= seg_end) {
+				continue;
+			}
+			const auto dense_end = std::min(seg_end, seg.base + MAX_PAGES * PAGE_SIZE);
+			for(auto addr = seg_begin; addr < dense_end;) {
+				const auto offset = addr - seg.base;
+				const auto index = offset >> PAGE_BITS;
+				if(index >= seg.pages.size()) {
+					break;
+				}
+				const auto page_end = std::min(seg.base + ((index + 1) << PAGE_BITS), dense_end);
+				if(seg.pages[index]) {
+					for(; addr < page_end; ++addr) {
+						// page lookup again since func() may add pages
+						auto& var = (*seg.pages[index])[(addr - seg.base) & (PAGE_SIZE - 1)];
+						if(var) {
+							func(addr, var);
+						}
+					}
+				}
+				addr = page_end;
+			}
+			for(auto iter = overflow.lower_bound(std::max(seg_begin, dense_end)); iter != overflow.end() && iter->first < seg_end;) {
+				if(iter->second) {
+					func(iter->first, iter->second);
+				}
+				if(iter->second) {
+					iter++;
+				} else {
+					iter = overflow.erase(iter);
+				}
+			}
+		}
+		if(end > MEM_STATIC) {
+			// heap slots are never erased, only new ones need to be sorted in
+			if(!heap_added.empty()) {
+				std::sort(heap_added.begin(), heap_added.end());
+				const auto mid = heap_order.size();
+				heap_order.insert(heap_order.end(), heap_added.begin(), heap_added.end());
+				std::inplace_merge(heap_order.begin(), heap_order.begin() + mid, heap_order.end());
+				heap_added.clear();
+			}
+			const auto count = heap_order.size();
+			auto i = std::lower_bound(heap_order.begin(), heap_order.end(),
+					std::make_pair(std::max(begin, MEM_STATIC), (std::unique_ptr<var_t>*)nullptr)) - heap_order.begin();
+			for(; i < count && heap_order[i].first < end; ++i) {
+				auto& var = *heap_order[i].second;
+				if(var) {
+					func(heap_order[i].first, var);
+				}
+			}
+		}
+	}
+
+private:
+	typedef std::array<std::unique_ptr<var_t>, PAGE_SIZE> page_t;
+
+	struct segment_t {
+		uint64_t base = 0;
+		uint64_t end = 0;
+		std::vector<std::unique_ptr<page_t>> pages;
+	};
+
+	segment_t& get_segment(const uint64_t addr)
+	{
+		return segments[addr < MEM_EXTERN ? 0 : (addr < MEM_STACK ? 1 : 2)];
+	}
+
+	segment_t segments[3] = {
+		{MEM_CONST, MEM_EXTERN, {}},
+		{MEM_EXTERN, MEM_STACK, {}},
+		{MEM_STACK, MEM_STATIC, {}}
+	};
+
+	std::map<uint64_t, std::unique_ptr<var_t>> overflow;
+	std::unordered_map<uint64_t, std::unique_ptr<var_t>> heap;
+
+	// heap slots sorted by address, slot pointers stay valid since heap is node based
+	std::vector<std::pair<uint64_t, std::unique_ptr<var_t>*>> heap_order;
+	std::vector<std::pair<uint64_t, std::unique_ptr<var_t>*>> heap_added;		// not yet in heap_order
+
+};
+
+
+} // vm
+} // mmx
+
+#endif /* INCLUDE_MMX_VM_MEMORY_H_ */
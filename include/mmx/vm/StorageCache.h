@@ -9,6 +9,7 @@
 #define INCLUDE_MMX_VM_STORAGECACHE_H_
 
 #include <mmx/vm/StorageRAM.h>
+#include <mmx/vm/StorageTracker.h>
 
 
 namespace mmx {
@@ -30,6 +31,12 @@ public:
 
 	void commit() const;
 
+	// write changes to another storage, such as the backend of a StorageTracker
+	void commit_to(Storage& target) const;
+
+	// keys that commit() would write
+	storage_keys_t get_writes() const;
+
 	std::unique_ptr<uint128> get_balance(const addr_t& contract, const addr_t& currency) override;
 
 	using Storage::write;
@@ -0,0 +1,63 @@
+#ifndef INCLUDE_MMX_VM_STORAGETRACKER_H_
+#define INCLUDE_MMX_VM_STORAGETRACKER_H_
+
+#include <mmx/vm/Storage.h>
+
+#include <set>
+#include <tuple>
+#include <mutex>
+
+
+namespace mmx {
+namespace vm {
+
+struct storage_keys_t {
+	std::set<std::pair<addr_t, uint64_t>> memory;
+	std::set<std::tuple<addr_t, uint64_t, uint64_t>> entries;
+	std::set<addr_t> lookups;									// contracts with key lookups / new keys
+	std::set<std::pair<addr_t, addr_t>> balances;				// [contract, currency]
+
+	bool intersects(const storage_keys_t& other) const;
+
+	void insert(const storage_keys_t& other);
+};
+
+/*
+ * Read-only view of a backend which records all keys read, used for optimistic execution.
+ */
+class StorageTracker : public Storage {
+public:
+	StorageTracker(std::shared_ptr<Storage> backend);
+
+	// all methods below are thread-safe
+
+	std::unique_ptr<var_t> read(const addr_t& contract, const uint64_t src) const override;
+
+	std::unique_ptr<var_t> read(const addr_t& contract, const uint64_t src, const uint64_t key) const override;
+
+	void write(const addr_t& contract, const uint64_t dst, const var_t& value) override;
+
+	void write(const addr_t& contract, const uint64_t dst, const uint64_t key, const var_t& value) override;
+
+	uint64_t lookup(const addr_t& contract, const var_t& value) const override;
+
+	std::unique_ptr<uint128> get_balance(const addr_t& contract, const addr_t& currency) override;
+
+	storage_keys_t get_reads() const;
+
+	using Storage::write;
+	using Storage::lookup;
+
+private:
+	mutable std::mutex mutex;
+	mutable storage_keys_t reads;
+
+	std::shared_ptr<Storage> backend;
+
+};
+
+
+} // vm
+} // mmx
+
+#endif /* INCLUDE_MMX_VM_STORAGETRACKER_H_ */
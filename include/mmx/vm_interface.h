@@ -17,15 +17,42 @@
 namespace mmx {
 namespace vm {
 
+struct decoded_binary_t {
+	size_t num_bytes = 0;
+	std::vector<std::unique_ptr<var_t>> constants;
+	std::shared_ptr<const std::vector<decoded_instr_t>> code;
+};
+
+struct binary_cache_stats_t {
+	uint64_t num_hit = 0;
+	uint64_t num_miss = 0;
+	uint64_t num_evict = 0;
+	size_t num_entries = 0;
+	size_t size = 0;
+	size_t max_size = 0;
+};
+
 const contract::method_t* find_method(std::shared_ptr<const contract::Binary> binary, const std::string& method_name);
 
 void set_deposit(std::shared_ptr<vm::Engine> engine, const addr_t& currency, const uint128& amount);
 
 std::vector<std::unique_ptr<vm::var_t>> read_constants(std::shared_ptr<const contract::Binary> binary);
 
+std::shared_ptr<const decoded_binary_t> decode(std::shared_ptr<const contract::Binary> binary);
+
+// process-wide LRU cache of decoded binaries, keyed by binary address (binaries are immutable)
+std::shared_ptr<const decoded_binary_t> decode_cached(std::shared_ptr<const contract::Binary> binary, const addr_t& address);
+
+void set_binary_cache_size(const size_t max_bytes);
+
+binary_cache_stats_t get_binary_cache_stats();
+
 void load(	std::shared_ptr<vm::Engine> engine,
 			std::shared_ptr<const contract::Binary> binary);
 
+void load(	std::shared_ptr<vm::Engine> engine,
+			std::shared_ptr<const decoded_binary_t> binary);
+
 void copy(std::shared_ptr<vm::Engine> dst, std::shared_ptr<vm::Engine> src, const uint64_t dst_addr, const uint64_t src_addr);
 
 void assign(std::shared_ptr<vm::Engine> engine, const uint64_t dst, const vnx::Variant& value);
@@ -14,6 +14,14 @@ void sha256_64_x8(uint8_t* out, uint8_t* in, const uint64_t length);
 
 void sha256_avx2_64_x8(uint8_t* out, uint8_t* in, const uint64_t length);
 
+// hashes 8 messages of exactly 64 bytes (in = 8 x 64, out = 8 x 32), out may alias in
+void sha256_avx2_64b_x8(uint8_t* out, const uint8_t* in);
+
+// hashes `count` messages of exactly 64 bytes (in = count x 64, out = count x 32), out may alias in
+void sha256_64b_batch(uint8_t* out, const uint8_t* in, const uint64_t count);
+
+void recursive_sha256_avx2_x8(uint8_t* hash, const uint64_t num_iters);
+
 bool avx2_available();
 
 
@@ -0,0 +1,12 @@
+#ifndef INCLUDE_SHA256_AVX512_H_
+#define INCLUDE_SHA256_AVX512_H_
+
+#include <cstdint>
+
+// prerequisite: hash is 16x 32 bytes
+void recursive_sha256_avx512_x16(uint8_t* hash, const uint64_t num_iters);
+
+bool avx512_available();
+
+
+#endif /* INCLUDE_SHA256_AVX512_H_ */
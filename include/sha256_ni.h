@@ -16,6 +16,8 @@ void recursive_sha256_ni(uint8_t* hash, const uint64_t num_iters);
 
 void recursive_sha256_ni_x2(uint8_t* hash, const uint64_t num_iters);
 
+void recursive_sha256_ni_x4(uint8_t* hash, const uint64_t num_iters);
+
 bool sha256_ni_available();
 
 
@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Syncs a fresh node from a single trusted peer and reports how long it took.
+# Run from the repository root, on a different host (or container) than the peer, since ports are fixed.
+#
+# Without checkpoint (full proof of space verification):
+#   ./scripts/bench/replay_sync.sh 192.168.1.10
+# With trusted checkpoint (hash of block at that height, see `mmx node get block <height>` on the peer):
+#   ./scripts/bench/replay_sync.sh 192.168.1.10 1000000 <hash>
+
+if [[ -z "$1" ]]; then
+	echo "Usage: replay_sync.sh <peer> [checkpoint_height checkpoint_hash]"
+	exit
+fi
+
+PEER=$1
+CHECKPOINT_HEIGHT=${2:-0}
+CHECKPOINT_HASH=${3:-0000000000000000000000000000000000000000000000000000000000000000}
+
+export MMX_HOME=$(mktemp -d)/
+mkdir -p ${MMX_HOME}config/local
+cp NETWORK ${MMX_HOME} 2> /dev/null
+
+cat > ${MMX_HOME}config/local/Router.json << EOF
+{
+	"open_port": false,
+	"seed_peers": [],
+	"fixed_peers": ["${PEER}"],
+	"min_sync_peers": 1,
+	"num_peers_out": 1
+}
+EOF
+cat > ${MMX_HOME}config/local/Node.json << EOF
+{
+	"checkpoint_height": ${CHECKPOINT_HEIGHT},
+	"checkpoint_hash": "${CHECKPOINT_HASH}"
+}
+EOF
+
+echo "MMX_HOME=${MMX_HOME}"
+echo "PEER=${PEER}"
+echo "CHECKPOINT_HEIGHT=${CHECKPOINT_HEIGHT}"
+
+LOG=${MMX_HOME}replay.log
+TIME_BEGIN=$(date +%s)
+
+./run_node.sh > ${LOG} 2>&1 &
+PID=$!
+
+while ! grep -q "Finished sync at height" ${LOG}; do
+	if ! kill -0 ${PID} 2> /dev/null; then
+		echo "Node exited, see ${LOG}"
+		exit 1
+	fi
+	sleep 1
+done
+
+TIME_END=$(date +%s)
+HEIGHT=$(grep -o "Finished sync at height [0-9]*" ${LOG} | head -n 1 | grep -o "[0-9]*$")
+ELAPSED=$((TIME_END - TIME_BEGIN))
+
+pkill -P ${PID}	# mmx_node, run_node.sh exits with it
+wait ${PID}
+
+echo "Synced ${HEIGHT} blocks in ${ELAPSED} sec ($((HEIGHT / (ELAPSED > 0 ? ELAPSED : 1))) blocks/s)"
+grep -E "Trusting checkpoint|Passed trusted checkpoint" ${LOG}
+
+rm -r ${MMX_HOME}
@@ -10,6 +10,10 @@
 
 #include <vnx/vnx.h>
 
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
 
 namespace mmx {
 
@@ -87,13 +91,239 @@ void read_entry_at(const vnx::File& file, const int64_t offset, uint32_t& versio
 	read_value(in, value);
 }
 
+/*
+ * Format 3 stores keys as [shared, suffix] with the previous key, restarting at every fence.
+ * Passing the previous key (or any key with the same prefix) is required to decode.
+ * Returns the size of the encoded key, including version.
+ */
+uint32_t read_block_key(vnx::TypeInput& in, const uint16_t format, std::shared_ptr<db_val_t> prev, uint32_t& version, std::shared_ptr<db_val_t>& key)
+{
+	if(format < 3) {
+		read_key(in, version, key);
+		return 8 + key->size;
+	}
+	uint32_t shared = 0;
+	uint32_t size = 0;
+	vnx::read(in, version);
+	vnx::read(in, shared);
+	vnx::read(in, size);
+	if(shared && (!prev || shared > prev->size)) {
+		throw std::runtime_error("read_block_key(): invalid key prefix");
+	}
+	if(prev && shared == prev->size && size == 0) {
+		key = prev;
+	} else {
+		key = std::make_shared<db_val_t>(shared + size);
+		if(shared) {
+			::memcpy(key->data, prev->data, shared);
+		}
+		in.read(key->data + shared, size);
+	}
+	return 12 + size;
+}
+
+uint32_t read_block_entry(vnx::TypeInput& in, const uint16_t format, std::shared_ptr<db_val_t> prev,
+							uint32_t& version, std::shared_ptr<db_val_t>& key, std::shared_ptr<db_val_t>& value)
+{
+	const auto key_size = read_block_key(in, format, prev, version, key);
+	read_value(in, value);
+	return key_size + 4 + value->size;
+}
+
+void write_entry(vnx::TypeOutput& out, uint32_t version, const db_val_t& key, const db_val_t& value)
+{
+	vnx::write(out, version);
+	vnx::write(out, key.size);
+	out.write(key.data, key.size);
+	vnx::write(out, value.size);
+	out.write(value.data, value.size);
+}
+
 void write_entry(vnx::TypeOutput& out, uint32_t version, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value)
 {
+	write_entry(out, version, *key, *value);
+}
+
+/*
+ * Counterpart of read_block_entry(), prev = nullptr restarts the prefix encoding.
+ * Returns the size of the encoded entry.
+ */
+uint32_t write_block_entry(vnx::TypeOutput& out, const uint16_t format,
+							uint32_t version, const db_val_t& key, const db_val_t& value, const db_val_t* prev)
+{
+	if(format < 3) {
+		write_entry(out, version, key, value);
+		return 8 + key.size + 4 + value.size;
+	}
+	uint32_t shared = 0;
+	if(prev) {
+		const auto max_size = std::min(prev->size, key.size);
+		while(shared < max_size && prev->data[shared] == key.data[shared]) {
+			shared++;
+		}
+	}
+	const uint32_t size = key.size - shared;
 	vnx::write(out, version);
-	vnx::write(out, key->size);
-	out.write(key->data, key->size);
-	vnx::write(out, value->size);
-	out.write(value->data, value->size);
+	vnx::write(out, shared);
+	vnx::write(out, size);
+	out.write(key.data + shared, size);
+	vnx::write(out, value.size);
+	out.write(value.data, value.size);
+	return 12 + size + 4 + value.size;
+}
+
+void read_buffer(vnx::TypeInput& in, db_val_t& value, uint32_t& capacity)
+{
+	uint32_t size = 0;
+	vnx::read(in, size);
+	if(size > capacity) {
+		delete [] value.data;
+		value.data = new uint8_t[size];
+		capacity = size;
+	}
+	value.size = size;
+	in.read(value.data, size);
+}
+
+void copy_buffer(db_val_t& dst, uint32_t& capacity, const db_val_t& src)
+{
+	if(src.size > capacity) {
+		delete [] dst.data;
+		dst.data = new uint8_t[src.size];
+		capacity = src.size;
+	}
+	dst.size = src.size;
+	::memcpy(dst.data, src.data, src.size);
+}
+
+#ifdef WITH_ZSTD
+/*
+ * Reads format 4 entries, which are stored as one zstd frame per fence.
+ * Positions are offsets into the uncompressed entries, same as in the index.
+ */
+class chunk_input_stream_t : public vnx::InputStream {
+public:
+	chunk_input_stream_t(	const vnx::File& file, const std::vector<int64_t>& index,
+							const std::vector<int64_t>& chunk_offset, const int64_t end, const int64_t offset)
+		:	file(file), index(index), chunk_offset(chunk_offset), end(end)
+	{
+		chunk = std::upper_bound(index.begin(), index.end(), offset) - index.begin();
+		if(offset < end) {
+			if(!chunk) {
+				throw std::logic_error("chunk_input_stream_t: offset out of bounds");
+			}
+			load(chunk - 1);
+			pos = offset - index[chunk];
+		}
+	}
+
+	size_t read(char* buf, size_t len) override {
+		while(pos >= buffer.size()) {
+			if(chunk + 1 >= index.size()) {
+				throw std::underflow_error("chunk_input_stream_t: end of block");
+			}
+			load(chunk + 1);
+		}
+		const auto num_bytes = std::min(len, buffer.size() - pos);
+		::memcpy(buf, buffer.data() + pos, num_bytes);
+		pos += num_bytes;
+		return num_bytes;
+	}
+
+	int64_t get_input_pos() const override {
+		return chunk < index.size() ? index[chunk] + pos : end;
+	}
+
+private:
+	void load(const size_t i) {
+		const size_t size = chunk_offset[i + 1] - chunk_offset[i];
+		std::vector<uint8_t> data(size);
+		{
+			vnx::FileSectionInputStream stream(file.get_handle(), chunk_offset[i], size, size);
+			vnx::TypeInput in(&stream);
+			in.read(data.data(), data.size());
+		}
+		buffer.resize((i + 1 < index.size() ? index[i + 1] : end) - index[i]);
+
+		const auto res = ZSTD_decompress(buffer.data(), buffer.size(), data.data(), data.size());
+		if(ZSTD_isError(res) || res != buffer.size()) {
+			throw std::runtime_error("chunk_input_stream_t: decompress failed at offset " + std::to_string(chunk_offset[i]));
+		}
+		chunk = i;
+		pos = 0;
+	}
+
+	const vnx::File& file;
+	const std::vector<int64_t>& index;
+	const std::vector<int64_t>& chunk_offset;
+	const int64_t end;
+	size_t chunk = 0;
+	size_t pos = 0;
+	std::vector<uint8_t> buffer;
+};
+#endif
+
+/*
+ * Sequential reader over all entries of a block, without per entry allocations.
+ */
+struct block_reader_t {
+	std::unique_ptr<vnx::InputStream> stream;
+	vnx::TypeInput in;
+	uint16_t format = 0;
+	uint64_t left = 0;
+	uint32_t version = 0;
+	db_val_t key;
+	db_val_t value;
+	uint32_t key_capacity = 0;
+	uint32_t value_capacity = 0;
+
+	block_reader_t(std::unique_ptr<vnx::InputStream> stream_, const uint16_t format, const uint64_t count)
+		:	stream(std::move(stream_)), in(stream.get()), format(format), left(count)
+	{
+	}
+
+	bool next() {
+		if(!left) {
+			return false;
+		}
+		left--;
+		if(format < 3) {
+			vnx::read(in, version);
+			read_buffer(in, key, key_capacity);
+		} else {
+			uint32_t shared = 0;
+			uint32_t size = 0;
+			vnx::read(in, version);
+			vnx::read(in, shared);
+			vnx::read(in, size);
+			if(shared > key.size) {
+				throw std::runtime_error("block_reader_t: invalid key prefix");
+			}
+			if(shared + size > key_capacity) {
+				auto* data = new uint8_t[shared + size];
+				::memcpy(data, key.data, shared);
+				delete [] key.data;
+				key.data = data;
+				key_capacity = shared + size;
+			}
+			key.size = shared + size;
+			in.read(key.data + shared, size);
+		}
+		read_buffer(in, value, value_capacity);
+		return true;
+	}
+};
+
+uint64_t get_key_prefix(const db_val_t& key)
+{
+	uint64_t prefix = 0;
+	for(uint32_t i = 0; i < 8; ++i) {
+		prefix <<= 8;
+		if(i < key.size) {
+			prefix |= key.data[i];
+		}
+	}
+	return prefix;
 }
 
 void write_entry_sum(vnx::TypeOutput& out, uint32_t version, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value)
@@ -102,6 +332,198 @@ void write_entry_sum(vnx::TypeOutput& out, uint32_t version, std::shared_ptr<db_
 	vnx::write(out, calc_checksum_32(version, key, value));
 }
 
+uint64_t calc_key_hash_64(const db_val_t& key)
+{
+	// FNV-1a with a final mix, stable across platforms since it's stored on disk
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for(uint32_t i = 0; i < key.size; ++i) {
+		hash ^= key.data[i];
+		hash *= 0x100000001b3ull;
+	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+void bloom_filter_t::init(const uint64_t num_keys, const uint32_t bits_per_key)
+{
+	bits.clear();
+	num_hashes = 0;
+	if(!num_keys || !bits_per_key) {
+		return;
+	}
+	// k = ln(2) * bits_per_key is optimal
+	num_hashes = std::max<uint32_t>(std::min<uint32_t>(bits_per_key * 69 / 100, 30), 1);
+	bits.resize((std::max<uint64_t>(num_keys * bits_per_key, 64) + 7) / 8);
+}
+
+void bloom_filter_t::add(const db_val_t& key)
+{
+	if(bits.empty()) {
+		return;
+	}
+	const uint64_t num_bits = bits.size() * 8;
+	auto hash = calc_key_hash_64(key);
+	const auto delta = (hash >> 33) | (hash << 31);
+	for(uint32_t i = 0; i < num_hashes; ++i) {
+		const auto bit = hash % num_bits;
+		bits[bit / 8] |= (1 << (bit % 8));
+		hash += delta;
+	}
+}
+
+bool bloom_filter_t::may_contain(const db_val_t& key) const
+{
+	if(bits.empty()) {
+		return true;
+	}
+	const uint64_t num_bits = bits.size() * 8;
+	auto hash = calc_key_hash_64(key);
+	const auto delta = (hash >> 33) | (hash << 31);
+	for(uint32_t i = 0; i < num_hashes; ++i) {
+		const auto bit = hash % num_bits;
+		if(!(bits[bit / 8] & (1 << (bit % 8)))) {
+			return false;
+		}
+		hash += delta;
+	}
+	return true;
+}
+
+void* MemArena::allocate(const size_t num_bytes, const size_t align)
+{
+	const size_t pad = (align - size_t(chunk_pos) % align) % align;
+	if(pad + num_bytes > chunk_left) {
+		const auto size = std::max(num_bytes + align, chunk_size);
+		chunks.emplace_back(new uint8_t[size], size);
+		chunk_pos = chunks.back().first.get();
+		chunk_left = size;
+		total_size += size;
+		return allocate(num_bytes, align);
+	}
+	auto* ptr = chunk_pos + pad;
+	chunk_pos += pad + num_bytes;
+	chunk_left -= pad + num_bytes;
+	return ptr;
+}
+
+db_val_t* MemArena::copy(const db_val_t& value)
+{
+	auto* out = new(allocate(sizeof(db_val_t), alignof(db_val_t))) db_val_t();
+	out->data = (uint8_t*)allocate(value.size, 1);
+	out->size = value.size;
+	::memcpy(out->data, value.data, value.size);
+	return out;
+}
+
+void MemArena::reset()
+{
+	if(chunks.size() > 1) {
+		chunks.resize(1);
+	}
+	if(chunks.empty()) {
+		chunk_pos = nullptr;
+		chunk_left = 0;
+		total_size = 0;
+	} else {
+		chunk_pos = chunks[0].first.get();
+		chunk_left = chunks[0].second;
+		total_size = chunk_left;
+	}
+}
+
+static std::atomic<uint64_t> g_next_block_id {1};
+
+// background compaction of all tables, bounded to not starve block verification
+static vnx::ThreadPool& get_compact_threads()
+{
+	static vnx::ThreadPool threads(std::min(std::max(std::thread::hardware_concurrency() / 4, 1u), 4u));
+	return threads;
+}
+
+
+BlockCache::BlockCache(const size_t max_size, const size_t num_shards)
+	:	max_size(max_size), shards(std::max<size_t>(num_shards, 1))
+{
+}
+
+BlockCache::shard_t& BlockCache::get_shard(const key_t& key)
+{
+	return shards[key_hash_t{}(key) % shards.size()];
+}
+
+bool BlockCache::find(const uint64_t block_id, const int64_t offset, entry_t& entry)
+{
+	key_t key;
+	key.block_id = block_id;
+	key.offset = offset;
+	auto& shard = get_shard(key);
+
+	std::lock_guard lock(shard.mutex);
+	auto iter = shard.map.find(key);
+	if(iter == shard.map.end()) {
+		return false;
+	}
+	shard.list.splice(shard.list.begin(), shard.list, iter->second);
+	entry = iter->second->second;
+	return true;
+}
+
+void BlockCache::insert(const uint64_t block_id, const int64_t offset, const entry_t& entry)
+{
+	if(!entry.data) {
+		return;
+	}
+	const size_t size = entry.data->size + entry_overhead;
+	const size_t max_shard_size = max_size / shards.size();
+	if(size > max_shard_size / 4) {
+		return;		// don't let large values thrash the cache
+	}
+	key_t key;
+	key.block_id = block_id;
+	key.offset = offset;
+	auto& shard = get_shard(key);
+
+	std::lock_guard lock(shard.mutex);
+	if(shard.map.count(key)) {
+		return;
+	}
+	shard.list.emplace_front(key, entry);
+	shard.map[key] = shard.list.begin();
+	shard.size += size;
+
+	while(shard.size > max_shard_size && !shard.list.empty()) {
+		const auto& last = shard.list.back();
+		shard.size -= last.second.data->size + entry_overhead;
+		shard.map.erase(last.first);
+		shard.list.pop_back();
+	}
+}
+
+size_t BlockCache::get_size() const
+{
+	size_t total = 0;
+	for(const auto& shard : shards) {
+		std::lock_guard lock(shard.mutex);
+		total += shard.size;
+	}
+	return total;
+}
+
+size_t BlockCache::get_num_entries() const
+{
+	size_t total = 0;
+	for(const auto& shard : shards) {
+		std::lock_guard lock(shard.mutex);
+		total += shard.map.size();
+	}
+	return total;
+}
+
+
 const std::function<int(const db_val_t&, const db_val_t&)> Table::default_comparator =
 	[](const db_val_t& lhs, const db_val_t& rhs) -> int {
 		if(lhs.size == rhs.size) {
@@ -113,7 +535,10 @@ const std::function<int(const db_val_t&, const db_val_t&)> Table::default_compar
 const Table::options_t Table::default_options;
 
 Table::Table(const std::string& root_path, const options_t& options)
-	:	options(options), root_path(root_path), mem_index(key_compare_t(this)), mem_block(mem_compare_t(this))
+	:	options(options), root_path(root_path),
+		is_default_order(options.comparator.target_type() == default_comparator.target_type()),
+		mem_data(std::make_shared<MemArena>()),
+		mem_index(key_compare_t(this), &mem_nodes), mem_block(mem_compare_t(this), &mem_nodes)
 {
 	const auto time_begin = get_time_ms();
 	vnx::Directory root(root_path);
@@ -146,7 +571,7 @@ Table::Table(const std::string& root_path, const options_t& options)
 		for(const auto& entry : block_map) {
 			const auto block = read_block(entry.second);
 			block_list.push_back(block);
-			debug_log << "Loaded " << block->name << " at level " << block->level << " with " << block->index.size() << " / " << block->total_count
+			debug_log << "Loaded " << block->name << " at level " << block->level << " with " << block->key_count << " / " << block->total_count
 					<< " entries, min_version = " << block->min_version << ", max_version = " << block->max_version << std::endl;
 		}
 		std::sort(block_list.begin(), block_list.end(),
@@ -157,17 +582,20 @@ Table::Table(const std::string& root_path, const options_t& options)
 				return lhs->min_version < rhs->min_version;
 			});
 
+		auto list = std::make_shared<block_list_t>();
+
 		std::shared_ptr<block_t> prev;
 		for(const auto& block : block_list) {
 			if(!prev || block->min_version > prev->max_version) {
 				curr_version = block->max_version + 1;
-				blocks.push_back(block);
+				list->push_back(block);
 			} else {
 				block->file.remove();
 				debug_log << "Deleted " << block->name << std::endl;
 			}
 			prev = block;
 		}
+		blocks = list;
 	}
 	last_flush = curr_version;
 
@@ -223,13 +651,24 @@ Table::Table(const std::string& root_path, const options_t& options)
 
 	revert(curr_version);
 
-	check_rewrite();
+	std::lock_guard lock(mutex);
+	schedule_compact();
+}
+
+Table::~Table()
+{
+	std::unique_lock lock(mutex);
+	do_exit = true;
+
+	// a queued task still has to run to see do_exit
+	compact_done.wait(lock, [this]() -> bool { return !compact_queued; });
 }
 
 std::shared_ptr<Table::block_t> Table::read_block(const std::string& name) const
 {
 	// TODO: handle unexpected read errors here
 	auto block = std::make_shared<block_t>();
+	block->id = g_next_block_id++;
 	block->name = name;
 	block->file.open(root_path + '/' + name, "rb");
 	block->file.lock_exclusive();
@@ -237,9 +676,15 @@ std::shared_ptr<Table::block_t> Table::read_block(const std::string& name) const
 	auto& in = block->file.in;
 	uint16_t format = 0;
 	vnx::read(in, format);
-	if(format > 0) {
+	if(format > block_format) {
 		throw std::runtime_error("invalid block format: " + std::to_string(format));
 	}
+#ifndef WITH_ZSTD
+	if(format >= 4) {
+		throw std::runtime_error("block format 4 requires zstd support: " + name);
+	}
+#endif
+	block->format = format;
 	vnx::read(in, block->level);
 	vnx::read(in, block->min_version);
 	vnx::read(in, block->max_version);
@@ -251,15 +696,131 @@ std::shared_ptr<Table::block_t> Table::read_block(const std::string& name) const
 	vnx::read(in, index_size);
 	block->index.resize(index_size);
 	in.read(block->index.data(), block->index.size() * 8);
+	block->key_count = index_size;
+
+	if(format >= 2) {
+		vnx::read(in, block->fence_interval);
+		vnx::read(in, block->key_count);
+		block->fence_prefix.resize(index_size);
+		block->fence_size.resize(index_size);
+		in.read(block->fence_prefix.data(), block->fence_prefix.size() * 8);
+		in.read(block->fence_size.data(), block->fence_size.size() * 4);
+	}
+	if(format >= 4) {
+		// header points to the index, offsets are within the uncompressed entries
+		vnx::read(in, block->index_offset);
+		block->chunk_offset.resize(index_size + 1);
+		in.read(block->chunk_offset.data(), block->chunk_offset.size() * 8);
+	}
+	if(format >= 1) {
+		uint64_t num_bytes = 0;
+		vnx::read(in, block->bloom.num_hashes);
+		vnx::read(in, num_bytes);
+		block->bloom.bits.resize(num_bytes);
+		in.read(block->bloom.bits.data(), block->bloom.bits.size());
+	}
 	return block;
 }
 
+void Table::set_cache(std::shared_ptr<BlockCache> cache)
+{
+	std::lock_guard lock(mutex);
+	this->cache = cache;
+}
+
+void Table::read_key_at(std::shared_ptr<const block_t> block, const int64_t offset, uint32_t& version, std::shared_ptr<db_val_t>& key) const
+{
+	if(cache) {
+		BlockCache::entry_t entry;
+		if(cache->find(block->id, offset, entry)) {
+			cache_hits++;
+			version = entry.version;
+			key = entry.data;
+			return;
+		}
+		cache_misses++;
+	}
+	if(block->format >= 3) {
+		// need to decode from the fence before
+		const auto iter = std::upper_bound(block->index.begin(), block->index.end(), offset);
+		if(iter == block->index.begin()) {
+			throw std::logic_error("read_key_at(): offset out of bounds");
+		}
+		auto pos = *(iter - 1);
+		const auto stream = open_stream(block, pos, 4096);
+		vnx::TypeInput in(stream.get());
+
+		std::shared_ptr<db_val_t> prev;
+		while(true) {
+			pos += read_block_key(in, block->format, prev, version, key);
+			if(pos > offset) {
+				break;
+			}
+			std::shared_ptr<db_val_t> value;
+			read_value(in, value);
+			pos += 4 + value->size;
+			prev = key;
+		}
+	} else {
+		mmx::read_key_at(block->file, offset, version, key);
+	}
+
+	if(cache) {
+		BlockCache::entry_t entry;
+		entry.version = version;
+		entry.data = key;
+		cache->insert(block->id, offset, entry);
+	}
+}
+
+void Table::read_value_at(std::shared_ptr<const block_t> block, const int64_t offset, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t>& value) const
+{
+	// values are cached at their own slot inside the entry
+	const auto value_offset = offset + 1;
+	if(cache) {
+		BlockCache::entry_t entry;
+		if(cache->find(block->id, value_offset, entry)) {
+			cache_hits++;
+			value = entry.data;
+			return;
+		}
+		cache_misses++;
+	}
+	if(block->format >= 3) {
+		const auto stream = open_stream(block, offset, 1024);
+		vnx::TypeInput in(stream.get());
+		uint32_t version;
+		std::shared_ptr<db_val_t> key_;
+		read_block_key(in, block->format, key, version, key_);
+		read_value(in, value);
+	} else {
+		mmx::read_value_at(block->file, offset, key, value);
+	}
+
+	if(cache) {
+		BlockCache::entry_t entry;
+		entry.data = value;
+		cache->insert(block->id, value_offset, entry);
+	}
+}
+
+std::unique_ptr<vnx::InputStream> Table::open_stream(std::shared_ptr<const block_t> block, const int64_t offset, const size_t buffer_size) const
+{
+#ifdef WITH_ZSTD
+	if(block->format >= 4) {
+		return std::make_unique<chunk_input_stream_t>(block->file, block->index, block->chunk_offset, block->index_offset, offset);
+	}
+#endif
+	return std::make_unique<vnx::FileSectionInputStream>(block->file.get_handle(), offset, block->index_offset - offset, buffer_size);
+}
+
 void Table::insert(std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value)
 {
 	if(!key || !value) {
 		throw std::logic_error("!key || !value");
 	}
-	std::lock_guard lock(mutex);
+	std::unique_lock lock(mutex);
+	wait_flush(lock);
 	if(write_lock) {
 		throw std::logic_error("table is write locked");
 	}
@@ -269,42 +830,72 @@ void Table::insert(std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> valu
 
 void Table::insert_entry(uint32_t version, std::shared_ptr<db_val_t> key, std::shared_ptr<db_val_t> value)
 {
+	// copy into arena, aliasing pointers keep the arena alive when returned by find()
+	const auto iter = mem_index.find(key);
+	if(iter != mem_index.end()) {
+		key = iter->first;
+	} else {
+		key = std::shared_ptr<db_val_t>(mem_data, mem_data->copy(*key));
+	}
+	value = std::shared_ptr<db_val_t>(mem_data, mem_data->copy(*value));
+
+	std::unique_lock mem_lock(mem_mutex);
 	auto& entry = mem_block[std::make_pair(key, version)];
 	if(entry) {
+		// old value stays in the arena until flush
 		mem_block_size -= key->size + entry->size;
+		mem_waste_size += sizeof(db_val_t) + entry->size;
 	}
 	entry = value;
 	mem_index[key] = std::make_pair(value, version);
 	mem_block_size += key->size + value->size;
 }
 
+size_t Table::get_mem_size() const
+{
+	std::shared_lock lock(mem_mutex);
+	return mem_data->get_size() + mem_nodes.get_size();
+}
+
+std::shared_ptr<db_val_t> Table::find_mem(std::shared_ptr<db_val_t> key, const uint32_t max_version) const
+{
+	std::shared_lock lock(mem_mutex);
+	auto iter = mem_index.find(key);
+	if(iter != mem_index.end()) {
+		if(iter->second.second <= max_version) {
+			return iter->second.first;
+		} else {
+			auto iter = mem_block.lower_bound(std::make_pair(key, max_version));
+			while(iter != mem_block.end() && *iter->first.first == *key) {
+				if(iter->first.second <= max_version) {
+					return iter->second;
+				} else if(iter != mem_block.begin()) {
+					iter--;
+				} else {
+					break;
+				}
+			}
+		}
+	}
+	return nullptr;
+}
+
 std::shared_ptr<db_val_t> Table::find(std::shared_ptr<db_val_t> key, const uint32_t max_version) const
 {
 	if(!key) {
 		return nullptr;
 	}
-	{
-		auto iter = mem_index.find(key);
-		if(iter != mem_index.end()) {
-			if(iter->second.second <= max_version) {
-				return iter->second.first;
-			} else {
-				auto iter = mem_block.lower_bound(std::make_pair(key, max_version));
-				while(iter != mem_block.end() && *iter->first.first == *key) {
-					if(iter->first.second <= max_version) {
-						return iter->second;
-					} else if(iter != mem_block.begin()) {
-						iter--;
-					} else {
-						break;
-					}
-				}
-			}
-		}
+	if(auto value = find_mem(key, max_version)) {
+		return value;
 	}
-	for(auto iter = blocks.rbegin(); iter != blocks.rend(); ++iter) {
+	const auto list = get_blocks();
+	for(auto iter = list->rbegin(); iter != list->rend(); ++iter) {
 		const auto& block = *iter;
 		if(block->min_version <= max_version) {
+			if(!block->bloom.may_contain(*key)) {
+				bloom_hits++;
+				continue;
+			}
 			if(auto value = find(block, key, max_version)) {
 				return value;
 			}
@@ -313,27 +904,136 @@ std::shared_ptr<db_val_t> Table::find(std::shared_ptr<db_val_t> key, const uint3
 	return nullptr;
 }
 
-std::shared_ptr<db_val_t> Table::find(std::shared_ptr<const block_t> block, std::shared_ptr<db_val_t> key, const uint32_t max_version) const
+std::vector<std::shared_ptr<db_val_t>> Table::find_many(
+		const std::vector<std::shared_ptr<db_val_t>>& keys, const uint32_t max_version, vnx::ThreadPool* threads) const
+{
+	std::vector<std::shared_ptr<db_val_t>> out(keys.size());
+
+	std::vector<size_t> pending;
+	pending.reserve(keys.size());
+	for(size_t i = 0; i < keys.size(); ++i) {
+		if(const auto& key = keys[i]) {
+			if(auto value = find_mem(key, max_version)) {
+				out[i] = value;
+			} else {
+				pending.push_back(i);
+			}
+		}
+	}
+	// sorted keys allow each search to continue where the last one ended
+	std::sort(pending.begin(), pending.end(),
+		[this, &keys](const size_t lhs, const size_t rhs) -> bool {
+			return options.comparator(*keys[lhs], *keys[rhs]) < 0;
+		});
+
+	const auto list = get_blocks();
+
+	if(threads && pending.size() > find_batch_size) {
+		// each batch covers a range of adjacent keys, so its reads still move forward
+		struct job_t {
+			std::mutex mutex;
+			std::condition_variable signal;
+			std::atomic<size_t> next {0};
+			size_t num_done = 0;
+			std::exception_ptr error;
+			std::vector<std::vector<size_t>> batches;
+		};
+		const auto job = std::make_shared<job_t>();
+		for(size_t i = 0; i < pending.size(); i += find_batch_size) {
+			job->batches.emplace_back(pending.begin() + i, pending.begin() + std::min(i + find_batch_size, pending.size()));
+		}
+		const auto num_batches = job->batches.size();
+
+		// helpers and caller take batches until none are left, so we never wait on the shared pool itself
+		// (a helper that only starts after we returned finds no work and does not touch keys / out)
+		const auto work = [this, job, list, &keys, &out, max_version, num_batches]() {
+			size_t i = 0;
+			while((i = job->next++) < num_batches) {
+				try {
+					find_sorted(list, keys, job->batches[i], out, max_version);
+				} catch(...) {
+					std::lock_guard lock(job->mutex);
+					job->error = std::current_exception();
+				}
+				std::lock_guard lock(job->mutex);
+				if(++job->num_done == num_batches) {
+					job->signal.notify_all();
+				}
+			}
+		};
+		for(size_t i = 1; i < std::min(num_batches, find_max_tasks); ++i) {
+			threads->add_task(work);
+		}
+		work();
+		{
+			std::unique_lock lock(job->mutex);
+			job->signal.wait(lock, [job, num_batches]() -> bool { return job->num_done == num_batches; });
+		}
+		if(job->error) {
+			std::rethrow_exception(job->error);
+		}
+	} else {
+		find_sorted(list, keys, pending, out, max_version);
+	}
+	return out;
+}
+
+void Table::find_sorted(std::shared_ptr<const block_list_t> blocks, const std::vector<std::shared_ptr<db_val_t>>& keys,
+						std::vector<size_t> pending, std::vector<std::shared_ptr<db_val_t>>& out, const uint32_t max_version) const
+{
+	for(auto iter = blocks->rbegin(); iter != blocks->rend() && !pending.empty(); ++iter) {
+		const auto& block = *iter;
+		if(block->min_version > max_version) {
+			continue;
+		}
+		size_t hint = 0;
+		std::vector<size_t> left;
+		for(const auto i : pending) {
+			const auto& key = keys[i];
+			if(!block->bloom.may_contain(*key)) {
+				bloom_hits++;
+				left.push_back(i);
+				continue;
+			}
+			if(auto value = find(block, key, max_version, &hint)) {
+				out[i] = value;
+			} else {
+				left.push_back(i);
+			}
+		}
+		pending = std::move(left);
+	}
+}
+
+std::shared_ptr<db_val_t> Table::find(std::shared_ptr<const block_t> block, std::shared_ptr<db_val_t> key, const uint32_t max_version, size_t* hint) const
 {
 	auto res = key;
 	bool is_match = false;
 	uint32_t version = -1;
-	const auto pos = lower_bound(block, version, res, is_match);
+	int64_t offset = 0;
+	const auto pos = lower_bound(block, version, res, is_match, offset, hint ? *hint : 0);
+	if(hint) {
+		*hint = pos;
+	}
 
 	std::shared_ptr<db_val_t> value;
-	if(is_match) {
-		const auto offset = block->index[pos] + 8 + key->size;
-		if(offset > block->index_offset) {
-			throw std::logic_error("offset > index_offset");
+	if(is_match && version <= max_version) {
+		read_value_at(block, offset, key, value);
+	}
+	else if(is_match) {
+		if(offset >= block->index_offset) {
+			throw std::logic_error("offset >= index_offset");
+		}
+		const auto stream = open_stream(block, offset, 1024);
+		vnx::TypeInput in(stream.get());
+		{
+			std::shared_ptr<db_val_t> key_;
+			read_block_entry(in, block->format, key, version, key_, value);
 		}
-		vnx::FileSectionInputStream stream(block->file.get_handle(), offset, block->index_offset - offset, 1024);
-		vnx::TypeInput in(&stream);
-		read_value(in, value);
-
 		while(version > max_version) {
 			try {
 				std::shared_ptr<db_val_t> key_;
-				read_entry(in, version, key_, value);
+				read_block_entry(in, block->format, key, version, key_, value);
 				if(*key_ != *key) {
 					value = nullptr;
 					break;
@@ -343,24 +1043,30 @@ std::shared_ptr<db_val_t> Table::find(std::shared_ptr<const block_t> block, std:
 				break;
 			}
 		}
+	} else if(!block->bloom.empty()) {
+		bloom_false_hits++;
 	}
 	return value;
 }
 
-size_t Table::lower_bound(std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match) const
+size_t Table::lower_bound(
+		std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match, int64_t& offset, const size_t begin) const
 {
 	if(!key) {
 		throw std::logic_error("!key");
 	}
+	if(block->fence_interval) {
+		return lower_bound_sparse(block, version, key, is_match, offset, begin);
+	}
 	const auto end = block->index.size();
-	// find match or successor
-	size_t L = 0;
+	// find match or successor, all keys before begin are known to be smaller
+	size_t L = std::min(begin, end);
 	size_t R = end;
 	while(L < R) {
 		const auto pos = (L + R) / 2;
 		uint32_t version;
 		std::shared_ptr<db_val_t> key_i;
-		read_key_at(block->file, block->index[pos], version, key_i);
+		read_key_at(block, block->index[pos], version, key_i);
 		if(options.comparator(*key, *key_i) < 0) {
 			R = pos;
 		} else {
@@ -369,15 +1075,18 @@ size_t Table::lower_bound(std::shared_ptr<const block_t> block, uint32_t& versio
 	}
 	if(R > 0) {
 		std::shared_ptr<db_val_t> key_i;
-		read_key_at(block->file, block->index[R - 1], version, key_i);
+		read_key_at(block, block->index[R - 1], version, key_i);
 		if(*key == *key_i) {
 			is_match = true;
+			offset = block->index[R - 1];
 			return R - 1;
 		}
 	}
 	if(R < end) {
-		read_key_at(block->file, block->index[R], version, key);
+		offset = block->index[R];
+		read_key_at(block, offset, version, key);
 	} else {
+		offset = block->index_offset;
 		version = -1;
 		key = nullptr;
 	}
@@ -385,25 +1094,231 @@ size_t Table::lower_bound(std::shared_ptr<const block_t> block, uint32_t& versio
 	return R;
 }
 
-bool Table::commit(const uint32_t new_version, const bool auto_flush)
+size_t Table::lower_bound_sparse(
+		std::shared_ptr<const block_t> block, uint32_t& version, std::shared_ptr<db_val_t>& key, bool& is_match, int64_t& offset, const size_t begin) const
 {
-	if(new_version == uint32_t(-1)) {
-		throw std::logic_error("invalid version");
-	}
-	if(new_version <= curr_version) {
-		throw std::logic_error("commit(): new version <= current version");
+	// find last fence <= key (using in-memory prefixes where possible)
+	size_t L = std::min(begin / block->fence_interval, block->index.size());
+	size_t R = block->index.size();
+	while(L < R) {
+		const auto pos = (L + R) / 2;
+		if(compare_fence(block, pos, *key) < 0) {
+			R = pos;
+		} else {
+			L = pos + 1;
+		}
 	}
+	const size_t fence = R ? R - 1 : 0;
+
+	// scan forward from fence until match or successor
+	is_match = false;
+	if(fence < block->index.size())
 	{
-		const std::string cmd = "commit";
-		write_entry_sum(write_log.out, -1,
-				std::make_shared<db_val_t>(cmd.c_str(), cmd.size()),
-				std::make_shared<db_val_t>(&new_version, sizeof(new_version)));
+		size_t pos = fence * block->fence_interval;
+		offset = block->index[fence];
+
+		const auto stream = open_stream(block, offset, 4096);
+		vnx::TypeInput in(stream.get());
+
+		std::shared_ptr<db_val_t> prev;
+		while(offset < block->index_offset) {
+			uint32_t version_i;
+			std::shared_ptr<db_val_t> key_i;
+			std::shared_ptr<db_val_t> value_i;
+			const auto size = read_block_entry(in, block->format, prev, version_i, key_i, value_i);
+
+			if(!prev || *key_i != *prev) {
+				if(prev) {
+					pos++;
+				}
+				const auto res = options.comparator(*key, *key_i);
+				if(res <= 0) {
+					version = version_i;
+					if(res == 0) {
+						is_match = true;
+					} else {
+						key = key_i;
+					}
+					return pos;
+				}
+				prev = key_i;
+			}
+			offset += size;
+		}
 	}
-	write_log.flush();
+	offset = block->index_offset;
+	version = -1;
+	key = nullptr;
+	return block->key_count;
+}
 
-	curr_version = new_version;
+int Table::compare_fence(std::shared_ptr<const block_t> block, const size_t index, const db_val_t& key) const
+{
+	if(is_default_order) {
+		// default order: by size first, then memcmp
+		const auto size = block->fence_size[index];
+		if(key.size != size) {
+			return key.size < size ? -1 : 1;
+		}
+		const auto prefix = get_key_prefix(key);
+		const auto fence = block->fence_prefix[index];
+		if(prefix != fence) {
+			return prefix < fence ? -1 : 1;
+		}
+		if(size <= 8) {
+			return 0;
+		}
+	}
+	uint32_t version;
+	std::shared_ptr<db_val_t> fence_key;
+	read_key_at(block, block->index[index], version, fence_key);
+	return options.comparator(key, *fence_key);
+}
+
+int64_t Table::get_offset(std::shared_ptr<const block_t> block, const size_t pos) const
+{
+	if(pos >= block->key_count) {
+		throw std::logic_error("get_offset(): pos out of bounds");
+	}
+	if(!block->fence_interval) {
+		return block->index[pos];
+	}
+	const auto fence = pos / block->fence_interval;
+	size_t index = fence * block->fence_interval;
+	int64_t offset = block->index[fence];
+	if(index == pos) {
+		return offset;
+	}
+	const auto stream = open_stream(block, offset, 4096);
+	vnx::TypeInput in(stream.get());
+
+	std::shared_ptr<db_val_t> prev;
+	while(offset < block->index_offset) {
+		uint32_t version;
+		std::shared_ptr<db_val_t> key;
+		std::shared_ptr<db_val_t> value;
+		const auto size = read_block_entry(in, block->format, prev, version, key, value);
+
+		if(!prev || *key != *prev) {
+			if(prev && ++index == pos) {
+				return offset;
+			}
+			prev = key;
+		}
+		offset += size;
+	}
+	throw std::logic_error("get_offset(): unexpected end of block");
+}
+
+int64_t Table::get_next_offset(std::shared_ptr<const block_t> block, const size_t pos, const int64_t offset) const
+{
+	if(!block->fence_interval) {
+		return block->index[pos + 1];
+	}
+	// skip remaining versions of current key
+	const auto stream = open_stream(block, offset, 4096);
+	vnx::TypeInput in(stream.get());
+
+	auto next = offset;
+	std::shared_ptr<db_val_t> first;
+	if(block->format >= 3) {
+		uint32_t version;
+		read_key_at(block, offset, version, first);
+	}
+	while(next < block->index_offset) {
+		uint32_t version;
+		std::shared_ptr<db_val_t> key;
+		std::shared_ptr<db_val_t> value;
+		const auto size = read_block_entry(in, block->format, first, version, key, value);
+		if(first && *key != *first) {
+			return next;
+		}
+		first = key;
+		next += size;
+	}
+	throw std::logic_error("get_next_offset(): unexpected end of block");
+}
+
+void Table::write_block_entry(
+		std::shared_ptr<block_t> block, uint32_t version, const db_val_t& key, const db_val_t& value, const db_val_t* prev) const
+{
+	// restart at every fence, so a fence offset can be decoded on its own
+	const bool is_fence = block->index.back() == block->index_offset;
+	if(is_fence) {
+		prev = nullptr;
+	}
+	uint32_t size = 0;
+	if(block->format >= 4) {
+		if(is_fence && !block->chunk.empty()) {
+			write_block_chunk(block);
+		}
+		vnx::VectorOutputStream stream(&block->chunk);
+		vnx::TypeOutput out(&stream);
+		size = mmx::write_block_entry(out, block->format, version, key, value, prev);
+		out.flush();
+	} else {
+		size = mmx::write_block_entry(block->file.out, block->format, version, key, value, prev);
+	}
+	block->index_offset += size;
+}
+
+void Table::write_block_chunk(std::shared_ptr<block_t> block) const
+{
+#ifdef WITH_ZSTD
+	std::vector<uint8_t> data(ZSTD_compressBound(block->chunk.size()));
+	const auto size = ZSTD_compress(data.data(), data.size(), block->chunk.data(), block->chunk.size(), options.compress_level);
+	if(ZSTD_isError(size)) {
+		throw std::runtime_error("ZSTD_compress() failed with: " + std::string(ZSTD_getErrorName(size)));
+	}
+	auto& out = block->file.out;
+	block->chunk_offset.push_back(out.get_output_pos());
+	out.write(data.data(), size);
+	block->chunk.clear();
+#else
+	throw std::logic_error("write_block_chunk(): no zstd support");
+#endif
+}
+
+void Table::append_key(std::shared_ptr<block_t> block, const db_val_t& key) const
+{
+	// index_offset is the end of entries written so far
+	const auto offset = block->index_offset;
+	if(!block->fence_interval || block->key_count % block->fence_interval == 0) {
+		block->index.push_back(offset);
+		if(block->fence_interval) {
+			block->fence_prefix.push_back(get_key_prefix(key));
+			block->fence_size.push_back(key.size);
+		}
+	}
+	block->bloom.add(key);
+	block->key_count++;
+}
+
+bool Table::commit(const uint32_t new_version, const bool auto_flush, const bool flush_log)
+{
+	if(new_version == uint32_t(-1)) {
+		throw std::logic_error("invalid version");
+	}
+	bool flag = false;
+	{
+		std::unique_lock lock(mutex);
+		wait_flush(lock);
 
-	const bool flag = do_flush();
+		if(new_version <= curr_version) {
+			throw std::logic_error("commit(): new version <= current version");
+		}
+		{
+			const std::string cmd = "commit";
+			write_entry_sum(write_log.out, -1,
+					std::make_shared<db_val_t>(cmd.c_str(), cmd.size()),
+					std::make_shared<db_val_t>(&new_version, sizeof(new_version)));
+		}
+		if(flush_log) {
+			write_log.flush();
+		}
+		curr_version = new_version;
+		flag = do_flush();
+	}
 	if(flag && auto_flush) {
 		flush();
 		return false;
@@ -411,16 +1326,35 @@ bool Table::commit(const uint32_t new_version, const bool auto_flush)
 	return flag;
 }
 
+void Table::schedule_flush()
+{
+	std::lock_guard lock(mutex);
+	flush_pending = true;
+}
+
+void Table::wait_flush(std::unique_lock<std::mutex>& lock) const
+{
+	flush_done.wait(lock, [this]() -> bool { return !flush_pending; });
+}
+
+void Table::flush_log()
+{
+	std::lock_guard lock(mutex);
+	write_log.flush();
+}
+
 bool Table::do_flush() const
 {
-	const bool normal_flush = (mem_block_size + mem_block.size() * entry_overhead >= options.max_block_size);
+	// arena memory is only released at flush, so overwritten and reverted entries count as well
+	const bool normal_flush = (mem_block_size + mem_block.size() * entry_overhead + mem_waste_size >= options.max_block_size);
 	const bool force_flush = (curr_version > last_flush && curr_version - last_flush >= options.force_flush_threshold);
 	return normal_flush || force_flush;
 }
 
 void Table::revert(const uint32_t new_version)
 {
-	std::lock_guard lock(mutex);
+	std::unique_lock lock(mutex);
+	wait_flush(lock);
 	if(write_lock) {
 		throw std::logic_error("table is write locked");
 	}
@@ -435,13 +1369,17 @@ void Table::revert(const uint32_t new_version)
 	}
 	write_log.flush();
 
-	std::set<std::string> deleted_blocks;
-	for(auto iter = blocks.begin(); iter != blocks.end();) {
+	// wait for background compaction to finish
+	compact_done.wait(lock, [this]() -> bool { return !is_compacting; });
+
+	// readers may still hold the old blocks, they are only deleted once released
+	auto list = std::make_shared<block_list_t>(*blocks);
+	for(auto iter = list->begin(); iter != list->end();) {
 		auto& block = *iter;
 		if(block->min_version >= new_version) {
-			block->file.remove();
+			block->remove_on_close = true;
 			debug_log << "Deleted " << block->name << std::endl;
-			iter = blocks.erase(iter);
+			iter = list->erase(iter);
 			continue;
 		}
 		if(block->max_version >= new_version) {
@@ -449,66 +1387,72 @@ void Table::revert(const uint32_t new_version)
 
 			auto new_block = create_block(block->level, block->name + ".tmp");
 			new_block->min_version = block->min_version;
+			new_block->bloom.init(block->key_count, options.bloom_bits_per_key);
 
-			auto& src = block->file;
-			auto& dst = new_block->file;
-			auto& in = src.in;
-			auto& out = dst.out;
-			src.seek_to(block_header_size);
-			dst.seek_to(block_header_size);
+			new_block->file.seek_to(block_header_size);
+			{
+				const auto stream = open_stream(block, block_header_size, 1024 * 1024);
+				vnx::TypeInput in(stream.get());
 
-			std::shared_ptr<db_val_t> prev;
-			for(uint64_t i = 0; i < block->total_count; ++i) {
-				uint32_t version;
-				std::shared_ptr<db_val_t> key;
-				std::shared_ptr<db_val_t> value;
-				read_entry(in, version, key, value);
-				if(version < new_version) {
-					if(!prev || *key != *prev) {
-						new_block->index.push_back(out.get_output_pos());
+				std::shared_ptr<db_val_t> prev;
+				std::shared_ptr<db_val_t> prev_read;
+				for(uint64_t i = 0; i < block->total_count; ++i) {
+					uint32_t version;
+					std::shared_ptr<db_val_t> key;
+					std::shared_ptr<db_val_t> value;
+					read_block_entry(in, block->format, prev_read, version, key, value);
+					prev_read = key;
+					if(version < new_version) {
+						if(!prev || *key != *prev) {
+							append_key(new_block, *key);
+						}
+						new_block->max_version = std::max(version, new_block->max_version);
+						new_block->total_count++;
+						write_block_entry(new_block, version, *key, *value, prev.get());
+						prev = key;
 					}
-					new_block->max_version = std::max(version, new_block->max_version);
-					new_block->total_count++;
-					write_entry(out, version, key, value);
-					prev = key;
 				}
 			}
-			new_block->index_offset = out.get_output_pos();
 
 			finish_block(new_block);
-			block->file.close();
-			rename(new_block, block->name);
+			rename(new_block, next_block_id++);
+			block->remove_on_close = true;
 
-			debug_log << "Rewrote " << block->name << " with max_version = " << new_block->max_version
-					<< ", " << new_block->index.size() << " / " << new_block->total_count << " entries"
-					<< ", from " << block->index.size() << " / " << block->total_count << " entries"
+			debug_log << "Rewrote " << block->name << " to " << new_block->name << " with max_version = " << new_block->max_version
+					<< ", " << new_block->key_count << " / " << new_block->total_count << " entries"
+					<< ", from " << block->key_count << " / " << block->total_count << " entries"
 					<< ", took " << (get_time_ms() - time_begin) / 1e3 << " sec" << std::endl;
 			block = new_block;
 		}
 		iter++;
 	}
+	set_blocks(list);
 
-	for(auto iter = mem_block.begin(); iter != mem_block.end();) {
-		const auto& key = iter->first;
-		if(key.second >= new_version) {
-			mem_block_size -= key.first->size + iter->second->size;
-			iter = mem_block.erase(iter);
-		} else {
-			iter++;
-		}
-	}
-	for(auto iter = mem_index.begin(); iter != mem_index.end();) {
-		const auto& key = iter->first;
-		if(iter->second.second >= new_version) {
-			const auto found = mem_block.lower_bound(std::make_pair(key, -1));
-			if(found != mem_block.end() && *found->first.first == *key) {
-				iter->second = std::make_pair(found->second, found->first.second);
+	{
+		std::unique_lock mem_lock(mem_mutex);
+		for(auto iter = mem_block.begin(); iter != mem_block.end();) {
+			const auto& key = iter->first;
+			if(key.second >= new_version) {
+				mem_block_size -= key.first->size + iter->second->size;
+				mem_waste_size += key.first->size + iter->second->size + entry_overhead;
+				iter = mem_block.erase(iter);
+			} else {
 				iter++;
+			}
+		}
+		for(auto iter = mem_index.begin(); iter != mem_index.end();) {
+			const auto& key = iter->first;
+			if(iter->second.second >= new_version) {
+				const auto found = mem_block.lower_bound(std::make_pair(key, -1));
+				if(found != mem_block.end() && *found->first.first == *key) {
+					iter->second = std::make_pair(found->second, found->first.second);
+					iter++;
+				} else {
+					iter = mem_index.erase(iter);
+				}
 			} else {
-				iter = mem_index.erase(iter);
+				iter++;
 			}
-		} else {
-			iter++;
 		}
 	}
 	curr_version = new_version;
@@ -518,6 +1462,19 @@ void Table::revert(const uint32_t new_version)
 void Table::flush()
 {
 	std::lock_guard lock(mutex);
+	try {
+		flush_memtable();
+	} catch(...) {
+		flush_pending = false;
+		flush_done.notify_all();
+		throw;
+	}
+	flush_pending = false;
+	flush_done.notify_all();
+}
+
+void Table::flush_memtable()
+{
 	if(write_lock) {
 		throw std::logic_error("table is write locked");
 	}
@@ -533,15 +1490,19 @@ void Table::flush()
 					std::make_shared<db_val_t>(cmd.c_str(), cmd.size()),
 					std::make_shared<db_val_t>(&curr_version, sizeof(curr_version)));
 		}
+		{
+			std::unique_lock mem_lock(mem_mutex);
+			clear_memtable();
+		}
 		debug_log << "Force flushed at version " << curr_version << std::endl;
 		return;
 	}
 	const auto time_begin = get_time_ms();
 
 	auto block = create_block(0, "flush.tmp");
-	block->index.reserve(mem_index.size());
+	block->index.reserve(mem_index.size() / std::max<size_t>(block->fence_interval, 1) + 1);
+	block->bloom.init(mem_index.size(), options.bloom_bits_per_key);
 
-	auto& out = block->file.out;
 	block->file.seek_to(block_header_size);
 
 	std::shared_ptr<db_val_t> prev;
@@ -549,38 +1510,53 @@ void Table::flush()
 		const auto& version = entry.first.second;
 		const auto& key = entry.first.first;
 		if(!prev || *key != *prev) {
-			block->index.push_back(out.get_output_pos());
+			append_key(block, *key);
 		}
 		block->total_count++;
 		block->min_version = std::min(version, block->min_version);
 		block->max_version = std::max(version, block->max_version);
-		write_entry(out, version, key, entry.second);
+		write_block_entry(block, version, *key, *entry.second, prev.get());
 		prev = key;
 	}
-	block->index_offset = out.get_output_pos();
 
 	finish_block(block);
 	rename(block, next_block_id++);
 
-	mem_index.clear();
-	mem_block.clear();
-	blocks.push_back(block);
-
-	mem_block_size = 0;
+	{
+		// readers check memtable first, then blocks
+		std::unique_lock mem_lock(mem_mutex);
+		auto list = std::make_shared<block_list_t>(*blocks);
+		list->push_back(block);
+		set_blocks(list);
+		clear_memtable();
+	}
 
 	// clear log after writing block
 	write_log.open("wb");
 	write_log.lock_exclusive();
 
-	debug_log << "Flushed " << block->name << " with " << block->index.size() << " / " << block->total_count
+	debug_log << "Flushed " << block->name << " with " << block->key_count << " / " << block->total_count
 			<< " entries, min_version = " << block->min_version << ", max_version = " << block->max_version
+			<< ", bloom_hits = " << bloom_hits.exchange(0) << ", bloom_false_hits = " << bloom_false_hits.exchange(0)
+			<< ", cache_hits = " << cache_hits.exchange(0) << ", cache_misses = " << cache_misses.exchange(0)
 			<< ", took " << (get_time_ms() - time_begin) / 1e3 << " sec" << std::endl;
 
-	check_rewrite();
+	schedule_compact();
+}
+
+void Table::clear_memtable()
+{
+	// mem_mutex needs to be locked
+	mem_index.clear();
+	mem_block.clear();
+	mem_nodes.reset();
+	mem_data = std::make_shared<MemArena>();
+	mem_block_size = 0;
+	mem_waste_size = 0;
 }
 
 std::shared_ptr<Table::block_t>
-Table::rewrite(std::list<std::shared_ptr<block_t>> blocks, const uint32_t level) const
+Table::rewrite(const block_list_t& blocks, const uint32_t level) const
 {
 	if(blocks.empty()) {
 		throw std::logic_error("no blocks given");
@@ -590,122 +1566,205 @@ Table::rewrite(std::list<std::shared_ptr<block_t>> blocks, const uint32_t level)
 		if(block->level + 1 != level) {
 			throw std::logic_error("level mismatch");
 		}
-		total_index_entries += block->index.size();
+		total_index_entries += block->key_count;
 	}
 
-	struct pointer_t {
-		uint64_t offset = 0;
-		std::shared_ptr<block_t> block;
-		std::shared_ptr<db_val_t> value;
-	};
-	std::map<std::pair<std::shared_ptr<db_val_t>, uint32_t>, pointer_t, mem_compare_t> block_map(mem_compare_t(this));
-
+	// k-way merge over a binary heap, each reader re-uses its key / value buffers
+	std::list<block_reader_t> readers;
 	for(const auto& block : blocks) {
-		if(!block->total_count) {
-			continue;
+		if(block->total_count) {
+			readers.emplace_back(open_stream(block, block_header_size, 1024 * 1024), block->format, block->total_count);
 		}
-		block->file.seek_to(block_header_size);
-
-		pointer_t entry;
-		entry.block = block;
-		uint32_t version;
-		std::shared_ptr<db_val_t> key;
-		read_entry(block->file.in, version, key, entry.value);
-		block_map[std::make_pair(key, version)] = entry;
 	}
+	// heap is a max-heap, so "less" means comes later: key ascending, version descending
+	const auto heap_less = [this](const block_reader_t* lhs, const block_reader_t* rhs) -> bool {
+		const auto res = options.comparator(lhs->key, rhs->key);
+		if(res == 0) {
+			return lhs->version < rhs->version;
+		}
+		return res > 0;
+	};
+	std::vector<block_reader_t*> heap;
+	heap.reserve(readers.size());
+	for(auto& reader : readers) {
+		reader.next();
+		heap.push_back(&reader);
+	}
+	std::make_heap(heap.begin(), heap.end(), heap_less);
 
 	auto block = create_block(level, "rewrite.tmp");
-	block->index.reserve(total_index_entries);
+	block->index.reserve(total_index_entries / std::max<size_t>(block->fence_interval, 1) + 1);
+	block->bloom.init(total_index_entries, options.bloom_bits_per_key);
 
-	auto& out = block->file.out;
 	block->file.seek_to(block_header_size);
 
-	std::shared_ptr<db_val_t> prev;
-	while(!block_map.empty()) {
-		const auto iter = block_map.begin();
-		const auto& key = iter->first.first;
-		const auto& version = iter->first.second;
-		if(!prev || *key != *prev) {
-			block->index.push_back(out.get_output_pos());
+	db_val_t prev;
+	uint32_t prev_capacity = 0;
+	bool have_prev = false;
+
+	while(!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), heap_less);
+		auto* reader = heap.back();
+		const auto& key = reader->key;
+		const auto version = reader->version;
+		const bool is_new = !have_prev || key != prev;
+		if(is_new) {
+			append_key(block, key);
 		}
 		block->total_count++;
 		block->min_version = std::min(version, block->min_version);
 		block->max_version = std::max(version, block->max_version);
-		write_entry(out, version, key, iter->second.value);
-		prev = key;
+		write_block_entry(block, version, key, reader->value, have_prev ? &prev : nullptr);
+
+		if(is_new) {
+			copy_buffer(prev, prev_capacity, key);
+			have_prev = true;
+		}
 
-		auto entry = iter->second;
-		if(++entry.offset < entry.block->total_count) {
-			uint32_t version;
-			std::shared_ptr<db_val_t> key;
-			read_entry(entry.block->file.in, version, key, entry.value);
-			block_map[std::make_pair(key, version)] = entry;
+		if(reader->next()) {
+			std::push_heap(heap.begin(), heap.end(), heap_less);
+		} else {
+			heap.pop_back();
 		}
-		block_map.erase(iter);
 	}
-	block->index_offset = out.get_output_pos();
 
 	finish_block(block);
 	return block;
 }
 
-void Table::check_rewrite()
+bool Table::check_rewrite(block_list_t& selected, uint32_t& level) const
 {
+	selected.clear();
 	if(options.level_factor <= 1) {
-		return;
+		return false;
 	}
-	uint32_t level = 0;
-	auto iter_begin = blocks.begin();
-	auto iter_end = iter_begin;
-	std::list<std::shared_ptr<block_t>> selected;
-	for(auto iter = blocks.begin(); iter != blocks.end(); ++iter) {
-		const auto& block = *iter;
+	for(const auto& block : *blocks) {
 		if(selected.empty() || block->level == level) {
 			selected.push_back(block);
 			if(selected.size() > options.level_factor) {
-				iter_end = iter;
 				break;
 			}
 		} else {
 			selected.clear();
 			selected.push_back(block);
-			iter_begin = iter;
 		}
 		level = block->level;
 	}
 	if(selected.size() <= options.level_factor) {
-		return;
+		return false;
 	}
 	selected.pop_back();
+	return true;
+}
+
+bool Table::compact_step(std::unique_lock<std::mutex>& lock)
+{
+	// compact() and the background thread may both get here
+	compact_done.wait(lock, [this]() -> bool { return !is_compacting; });
+
+	uint32_t level = 0;
+	block_list_t selected;
+	if(!check_rewrite(selected, level)) {
+		return false;
+	}
+	const auto block_id = next_block_id++;
+	is_compacting = true;
 
 	const auto time_begin = get_time_ms();
 
-	const auto block = rewrite(selected, level + 1);
-	rename(block, next_block_id++);
+	// merge without holding the lock, readers keep using the old blocks
+	std::shared_ptr<block_t> block;
+	lock.unlock();
+	try {
+		block = rewrite(selected, level + 1);
+		rename(block, block_id);
+	} catch(...) {
+		lock.lock();
+		is_compacting = false;
+		compact_done.notify_all();
+		throw;
+	}
+	lock.lock();
+
+	// flush() only appends and revert() waits for us, so the range is still in place
+	auto list = std::make_shared<block_list_t>();
+	for(const auto& entry : *blocks) {
+		if(entry == selected.front()) {
+			list->push_back(block);
+		}
+		if(std::find(selected.begin(), selected.end(), entry) == selected.end()) {
+			list->push_back(entry);
+		}
+	}
+	set_blocks(list);
 
 	debug_log << "Wrote " << block->name << " at level " << block->level
-			<< " with " << block->index.size() << " / " << block->total_count
+			<< " with " << block->key_count << " / " << block->total_count
 			<< " entries, min_version = " << block->min_version << ", max_version = " << block->max_version
 			<< ", took " << (get_time_ms() - time_begin) / 1e3 << " sec" << std::endl;
 
 	for(const auto& block : selected) {
-		block->file.remove();
+		block->remove_on_close = true;
 		debug_log << "Deleted " << block->name << std::endl;
 	}
-	blocks.insert(iter_begin, block);
-	blocks.erase(iter_begin, iter_end);
+	is_compacting = false;
+	compact_done.notify_all();
+	return true;
+}
+
+void Table::compact()
+{
+	std::unique_lock lock(mutex);
+	while(compact_step(lock));
+}
+
+void Table::schedule_compact()
+{
+	// mutex needs to be locked
+	if(!options.auto_compact || do_exit) {
+		return;
+	}
+	do_compact = true;
+
+	if(!compact_queued) {
+		compact_queued = true;
+		get_compact_threads().add_task(std::bind(&Table::compact_task, this));
+	}
+}
+
+void Table::compact_task()
+{
+	std::unique_lock lock(mutex);
+	while(!do_exit && do_compact) {
+		do_compact = false;
+		try {
+			while(!do_exit && compact_step(lock));
+		} catch(const std::exception& ex) {
+			debug_log << "Compaction failed with: " << ex.what() << std::endl;
+		}
+	}
+	compact_queued = false;
+	compact_done.notify_all();
+}
 
-	check_rewrite();
+std::shared_ptr<const Table::block_list_t> Table::get_blocks() const
+{
+	return std::atomic_load(&blocks);
+}
+
+void Table::set_blocks(std::shared_ptr<const block_list_t> list)
+{
+	std::atomic_store(&blocks, list);
 }
 
 void Table::write_block_header(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const
 {
-	vnx::write(out, uint16_t(0));
+	vnx::write(out, block->format);
 	vnx::write(out, block->level);
 	vnx::write(out, block->min_version);
 	vnx::write(out, block->max_version);
 	vnx::write(out, block->total_count);
-	vnx::write(out, block->index_offset);
+	vnx::write(out, block->format >= 4 ? block->chunk_offset.back() : block->index_offset);
 }
 
 void Table::write_block_index(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const
@@ -714,13 +1773,43 @@ void Table::write_block_index(vnx::TypeOutput& out, std::shared_ptr<const block_
 	out.write(block->index.data(), block->index.size() * 8);
 }
 
+void Table::write_block_fences(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const
+{
+	vnx::write(out, block->fence_interval);
+	vnx::write(out, block->key_count);
+	out.write(block->fence_prefix.data(), block->fence_prefix.size() * 8);
+	out.write(block->fence_size.data(), block->fence_size.size() * 4);
+}
+
+void Table::write_block_chunks(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const
+{
+	vnx::write(out, block->index_offset);
+	out.write(block->chunk_offset.data(), block->chunk_offset.size() * 8);
+}
+
+void Table::write_block_bloom(vnx::TypeOutput& out, std::shared_ptr<const block_t> block) const
+{
+	vnx::write(out, block->bloom.num_hashes);
+	vnx::write(out, uint64_t(block->bloom.bits.size()));
+	out.write(block->bloom.bits.data(), block->bloom.bits.size());
+}
+
 std::shared_ptr<Table::block_t> Table::create_block(const uint32_t level, const std::string& name) const
 {
 	auto block = std::make_shared<block_t>();
+	block->id = g_next_block_id++;
 	block->level = level;
 	block->name = name;
+	block->format = options.fence_interval ? (options.prefix_keys ? 3 : 2) : 1;
+#ifdef WITH_ZSTD
+	if(block->format == 3 && options.compress_level) {
+		block->format = 4;
+	}
+#endif
+	block->fence_interval = options.fence_interval;
 	block->file.open(root_path + '/' + block->name, "wb");
 	block->min_version = -1;
+	block->index_offset = block_header_size;
 	return block;
 }
 
@@ -728,12 +1817,29 @@ void Table::finish_block(std::shared_ptr<block_t> block) const
 {
 	auto& file = block->file;
 
+	if(block->format >= 4) {
+		if(!block->chunk.empty()) {
+			write_block_chunk(block);
+		}
+		block->chunk.shrink_to_fit();
+		block->chunk_offset.push_back(file.out.get_output_pos());
+	}
 	file.seek_begin();
 	write_block_header(file.out, block);
 
-	file.seek_to(block->index_offset);
+	file.seek_to(block->format >= 4 ? block->chunk_offset.back() : block->index_offset);
 	write_block_index(file.out, block);
 
+	if(block->format >= 2) {
+		write_block_fences(file.out, block);
+	}
+	if(block->format >= 4) {
+		write_block_chunks(file.out, block);
+	}
+	if(block->format >= 1) {
+		write_block_bloom(file.out, block);
+	}
+
 	file.close();
 }
 
@@ -753,7 +1859,8 @@ void Table::rename(std::shared_ptr<block_t> block, const std::string& new_name)
 Table::Iterator::Iterator(const Table* table)
 	:	table(table), block_map(compare_t(this))
 {
-	std::lock_guard lock(table->mutex);
+	std::unique_lock lock(table->mutex);
+	table->wait_flush(lock);
 	table->write_lock++;
 }
 
@@ -824,13 +1931,14 @@ void Table::Iterator::prev()
 			const auto& entry = iter->second;
 			if(const auto& block = entry.block) {
 				if(entry.pos > 0) {
-					const auto pos = entry.pos - 1;
 					pointer_t next;
 					next.block = block;
-					next.pos = pos;
+					next.pos = entry.pos - 1;
+					next.offset = table->get_offset(block, next.pos);
 					uint32_t version;
 					std::shared_ptr<db_val_t> key;
-					read_entry_at(entry.block->file, block->index[pos], version, key, next.value);
+					table->read_key_at(block, next.offset, version, key);
+					table->read_value_at(block, next.offset, key, next.value);
 					block_map[std::make_pair(key, version)] = next;
 				}
 			} else {
@@ -861,14 +1969,15 @@ void Table::Iterator::next()
 		while(iter != block_map.end() && *iter->first.first == *prev) {
 			const auto& entry = iter->second;
 			if(const auto& block = entry.block) {
-				const auto pos = entry.pos + 1;
-				if(pos < block->index.size()) {
+				if(entry.pos + 1 < block->key_count) {
 					pointer_t next;
 					next.block = block;
-					next.pos = pos;
+					next.pos = entry.pos + 1;
+					next.offset = table->get_next_offset(block, entry.pos, entry.offset);
 					uint32_t version;
 					std::shared_ptr<db_val_t> key;
-					read_entry_at(entry.block->file, block->index[pos], version, key, next.value);
+					table->read_key_at(block, next.offset, version, key);
+					table->read_value_at(block, next.offset, key, next.value);
 					block_map[std::make_pair(key, version)] = next;
 				}
 			} else {
@@ -904,7 +2013,7 @@ void Table::Iterator::seek(std::shared_ptr<db_val_t> key)
 
 void Table::Iterator::seek(std::shared_ptr<db_val_t> key, const int mode)
 {
-	seek(table->blocks, key, mode);
+	seek(*table->get_blocks(), key, mode);
 
 	const auto& mem_index = table->mem_index;
 	if(!mem_index.empty()) {
@@ -934,25 +2043,27 @@ void Table::Iterator::seek(std::shared_ptr<db_val_t> key, const int mode)
 	}
 }
 
-void Table::Iterator::seek(const std::list<std::shared_ptr<block_t>>& blocks, std::shared_ptr<db_val_t> key, const int mode)
+void Table::Iterator::seek(const block_list_t& blocks, std::shared_ptr<db_val_t> key, const int mode)
 {
 	block_map.clear();
 	direction = mode >= 0 ? 1 : -1;
 
 	for(const auto& block : blocks)
 	{
-		const auto end = block->index.size();
+		const auto end = block->key_count;
 
 		bool is_match = false;
 		uint32_t version = -1;
 		size_t pos = 0;
+		int64_t offset = 0;
 		auto res = key;
 		if(res) {
-			pos = table->lower_bound(block, version, res, is_match);
+			pos = table->lower_bound(block, version, res, is_match, offset);
 		}
 		else if(mode == 0) {
 			if(pos < end) {
-				read_key_at(block->file, block->index[pos], version, res);
+				offset = table->get_offset(block, pos);
+				table->read_key_at(block, offset, version, res);
 			} else {
 				continue;
 			}
@@ -964,13 +2075,15 @@ void Table::Iterator::seek(const std::list<std::shared_ptr<block_t>>& blocks, st
 			if(pos == 0) {
 				continue;
 			}
-			read_key_at(block->file, block->index[--pos], version, res);
+			offset = table->get_offset(block, --pos);
+			table->read_key_at(block, offset, version, res);
 		}
 		else if(mode > 0) {
 			if(pos + 1 >= end) {
 				continue;
 			}
-			read_key_at(block->file, block->index[++pos], version, res);
+			offset = table->get_next_offset(block, pos++, offset);
+			table->read_key_at(block, offset, version, res);
 		}
 		if(!res) {
 			continue;
@@ -978,7 +2091,8 @@ void Table::Iterator::seek(const std::list<std::shared_ptr<block_t>>& blocks, st
 		pointer_t entry;
 		entry.block = block;
 		entry.pos = pos;
-		read_value_at(block->file, block->index[pos], res, entry.value);
+		entry.offset = offset;
+		table->read_value_at(block, offset, res, entry.value);
 		block_map[std::make_pair(res, version)] = entry;
 	}
 }
@@ -1002,38 +2116,91 @@ void Table::Iterator::seek_for_prev(std::shared_ptr<db_val_t> key_)
 }
 
 
-DataBase::DataBase(const int num_threads)
-	:	threads(num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 4u))
+DataBase::DataBase(const int num_threads, std::shared_ptr<BlockCache> cache)
+	:	threads(num_threads > 0 ? num_threads : std::max(std::thread::hardware_concurrency(), 4u)), cache(cache)
 {
 }
 
 DataBase::~DataBase()
 {
+	flush_log();
 	threads.close();
 }
 
 void DataBase::add(std::shared_ptr<Table> table)
 {
+	if(cache) {
+		table->set_cache(cache);
+	}
+	auto entry = std::make_shared<commit_stats_t>();
+	entry->name = table->root_path;
+
 	std::lock_guard<std::mutex> lock(mutex);
 	tables.push_back(table);
+	stats.push_back(entry);
 }
 
 void DataBase::commit(const uint32_t new_version)
 {
 	std::lock_guard<std::mutex> lock(mutex);
-	for(const auto& table : tables) {
-		if(table->commit(new_version, false)) {
-			threads.add_task([table]() {
+
+	// finish flushes of previous commit (when pipelined)
+	threads.sync();
+
+	// group commit: only flush the logs together every so often
+	const auto now = get_time_ms();
+	const bool sync_log =
+			(sync_versions && (new_version < last_sync_version || new_version - last_sync_version >= sync_versions))
+			|| (sync_interval_ms && now - last_sync_ms >= sync_interval_ms);
+	if(sync_log) {
+		last_sync_ms = now;
+		last_sync_version = new_version;
+	}
+	// all tables commit in parallel, tables that need a flush are marked before returning
+	std::vector<std::shared_ptr<Table>> to_flush(tables.size());
+	for(size_t i = 0; i < tables.size(); ++i) {
+		threads.add_task([this, i, new_version, sync_log, &to_flush]() {
+			const auto& table = tables[i];
+			const auto time_begin = vnx::get_time_micros();
+			const bool do_flush = table->commit(new_version, false, false);
+			if(do_flush) {
+				table->schedule_flush();
+				to_flush[i] = table;
+			} else if(sync_log) {
+				table->flush_log();
+			}
+			const auto elapsed = vnx::get_time_micros() - time_begin;
+
+			std::lock_guard<std::mutex> lock(stats_mutex);
+			stats[i]->num_commit++;
+			stats[i]->commit_time_us += elapsed;
+		});
+	}
+	threads.sync();
+
+	for(size_t i = 0; i < tables.size(); ++i) {
+		if(const auto table = to_flush[i]) {
+			const auto entry = stats[i];
+			threads.add_task([this, table, entry]() {
+				const auto time_begin = vnx::get_time_micros();
 				table->flush();
+				const auto elapsed = vnx::get_time_micros() - time_begin;
+
+				std::lock_guard<std::mutex> lock(stats_mutex);
+				entry->num_flush++;
+				entry->flush_time_us += elapsed;
 			});
 		}
 	}
-	threads.sync();
+	if(!pipelined) {
+		threads.sync();
+	}
 }
 
 void DataBase::revert(const uint32_t new_version)
 {
 	std::lock_guard<std::mutex> lock(mutex);
+	threads.sync();
 	for(const auto& table : tables) {
 		threads.add_task([table, new_version]() {
 			table->revert(new_version);
@@ -1064,6 +2231,53 @@ uint32_t DataBase::min_version() const
 	return min_version;
 }
 
+void DataBase::set_durability(const uint32_t sync_versions, const int64_t sync_interval_ms)
+{
+	if(!sync_versions && sync_interval_ms <= 0) {
+		throw std::logic_error("set_durability(): no sync condition");
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	this->sync_versions = sync_versions;
+	this->sync_interval_ms = std::max<int64_t>(sync_interval_ms, 0);
+}
+
+void DataBase::flush_log()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for(const auto& table : tables) {
+		threads.add_task([table]() {
+			table->flush_log();
+		});
+	}
+	threads.sync();
+	last_sync_ms = get_time_ms();
+}
+
+void DataBase::set_pipelined(const bool enable)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pipelined = enable;
+	if(!pipelined) {
+		threads.sync();
+	}
+}
+
+std::vector<DataBase::commit_stats_t> DataBase::get_commit_stats(const bool reset) const
+{
+	std::vector<commit_stats_t> out;
+	std::lock_guard<std::mutex> lock(mutex);
+	std::lock_guard<std::mutex> stats_lock(stats_mutex);
+	for(const auto& entry : stats) {
+		out.push_back(*entry);
+		if(reset) {
+			const auto name = entry->name;
+			*entry = commit_stats_t();
+			entry->name = name;
+		}
+	}
+	return out;
+}
+
 uint32_t DataBase::recover()
 {
 	const auto version = min_version();
@@ -49,6 +49,9 @@ void Harvester::main()
 	add_async_client(node_async);
 	add_async_client(farmer_async);
 
+	const auto file_limit = pos::set_max_open_files(max_open_files);
+	log(DEBUG) << "Keeping up to " << file_limit << " plot files open";
+
 	threads = std::make_shared<vnx::ThreadPool>(num_threads, num_threads);
 	lookup_timer = add_timer(std::bind(&Harvester::check_queue, this));
 
@@ -515,6 +518,13 @@ void Harvester::reload()
 				if(ksize < params->min_ksize || ksize > params->max_ksize) {
 					throw std::logic_error("invalid ksize: " + std::to_string(ksize));
 				}
+				if(build_y_index) {
+					try {
+						prover->load_index();
+					} catch(const std::exception& ex) {
+						log(WARN) << "[" << my_name << "] Failed to build Y index for '" << file_path << "' (using lookup without index): " << ex.what();
+					}
+				}
 				{
 					std::lock_guard<std::mutex> lock(mutex);
 					plots.emplace_back(file_path, prover);
@@ -559,6 +569,7 @@ void Harvester::reload()
 	id_map.clear();
 	total_bytes = 0;
 	total_bytes_effective = 0;
+	uint64_t total_index_size = 0;
 	for(const auto& entry : plot_map) {
 		const auto& prover = entry.second;
 		const auto& file_name = entry.first;
@@ -569,6 +580,7 @@ void Harvester::reload()
 		}
 		total_bytes += vnx::File(file_name).file_size();
 		total_bytes_effective += get_effective_plot_size(prover->get_ksize());
+		total_index_size += prover->get_index_size();
 	}
 
 	// gather plot NFTs
@@ -595,6 +607,10 @@ void Harvester::reload()
 	log(INFO) << "[" << my_name << "] Loaded " << plot_map.size() << " plots, "
 			<< total_bytes / pow(1000, 4) << " TB, " << total_bytes_effective / pow(1000, 4) << " TBe"
 			<< ", took " << (get_time_ms() - time_begin) / 1e3 << " sec";
+	if(total_index_size) {
+		log(INFO) << "[" << my_name << "] Y index uses " << total_index_size / pow(1024, 2) << " MiB ("
+				<< total_index_size / plot_map.size() / 1024. << " KiB per plot)";
+	}
 }
 
 void Harvester::add_plot_dir(const std::string& path)
@@ -7,6 +7,7 @@
 
 #include <mmx/Node.h>
 #include <mmx/Challenge.hxx>
+#include <mmx/BalanceDelta.hxx>
 #include <mmx/ProofOfSpaceOG.hxx>
 #include <mmx/ProofOfSpaceNFT.hxx>
 #include <mmx/contract/Binary.hxx>
@@ -149,6 +150,9 @@ void Node::main()
 	api_threads = std::make_shared<vnx::ThreadPool>(num_api_threads);
 	vdf_threads = std::make_shared<vnx::ThreadPool>(max_vdf_verify_pending);
 	fetch_threads = std::make_shared<vnx::ThreadPool>(2);
+	sync_threads = std::make_shared<vnx::ThreadPool>(std::max<int>(num_threads / 4, 2));
+	num_sig_threads = std::max<int>(num_threads / 4, 2);
+	sig_threads = std::make_shared<vnx::ThreadPool>(num_sig_threads);
 
 	router = std::make_shared<RouterAsyncClient>(router_name);
 	http = std::make_shared<vnx::addons::HttpInterface<Node>>(this, vnx_name);
@@ -159,11 +163,25 @@ void Node::main()
 	vnx::Directory(database_path).create();
 
 	const auto time_begin = get_time_ms();
+	if(db_cache_size) {
+		db_cache = std::make_shared<BlockCache>(size_t(db_cache_size) << 20);
+	}
+	vm::set_binary_cache_size(size_t(vm_cache_size) << 20);
 	{
-		db = std::make_shared<DataBase>(num_db_threads);
+		db = std::make_shared<DataBase>(num_db_threads, db_cache);
+
+		// large log tables use a sparse index, prefix compressed keys and zstd (if available) to save memory and disk
+		Table::options_t log_options;
+		log_options.fence_interval = 16;
+		log_options.prefix_keys = true;
+		log_options.compress_level = 3;
 
-		db->open_async(txio_log, database_path + "txio_log");
-		db->open_async(exec_log, database_path + "exec_log");
+		// tx_index is keyed by random hashes and read on every tx lookup: sparse index only
+		Table::options_t index_options;
+		index_options.fence_interval = 16;
+
+		db->open_async(txio_log, database_path + "txio_log", log_options);
+		db->open_async(exec_log, database_path + "exec_log", log_options);
 		db->open_async(memo_log, database_path + "memo_log");
 
 		db->open_async(contract_map, database_path + "contract_map");
@@ -178,7 +196,7 @@ void Node::main()
 		db->open_async(swap_liquid_map, database_path + "swap_liquid_map");
 
 		db->open_async(tx_log, database_path + "tx_log");
-		db->open_async(tx_index, database_path + "tx_index");
+		db->open_async(tx_index, database_path + "tx_index", index_options);
 		db->open_async(height_map, database_path + "height_map");
 		db->open_async(balance_table, database_path + "balance_table");
 		db->open_async(farmer_block_map, database_path + "farmer_block_map");
@@ -188,7 +206,7 @@ void Node::main()
 		db->recover();
 	}
 	{
-		db_blocks = std::make_shared<DataBase>(2);
+		db_blocks = std::make_shared<DataBase>(2, db_cache);
 
 		db_blocks->open_async(block_index, database_path + "block_index");
 		db_blocks->open_async(height_index, database_path + "height_index");
@@ -276,6 +294,8 @@ void Node::main()
 	api_threads->close();
 	vdf_threads->close();
 	fetch_threads->close();
+	sync_threads->close();
+	sig_threads->close();
 
 	opencl_vdf.clear();
 
@@ -365,6 +385,14 @@ void Node::trigger_update()
 
 void Node::add_block(std::shared_ptr<const Block> block)
 {
+	if(pre_validate(block)) {
+		add_valid_block(block);
+	}
+}
+
+bool Node::pre_validate(std::shared_ptr<const Block> block) const
+{
+	// NOTE: NEEDS TO BE THREAD SAFE
 	try {
 		if(!block->is_valid(params)) {
 			throw std::logic_error("invalid block");
@@ -374,9 +402,13 @@ void Node::add_block(std::shared_ptr<const Block> block)
 	}
 	catch(const std::exception& ex) {
 		log(WARN) << "Pre-validation failed for a block at height " << block->height << ": " << ex.what();
-		return;
+		return false;
 	}
+	return true;
+}
 
+void Node::add_valid_block(std::shared_ptr<const Block> block)
+{
 	const auto root = get_root();
 	if(block->height <= root->height) {
 		write_block(block, false);
@@ -509,7 +541,88 @@ void Node::print_stats()
 		}
 	}
 	log(INFO) << fork_tree.size() << " blocks in memory, "
-			<< tx_pool.size() << " tx pool, " << tx_pool_fees.size() << " tx senders";
+			<< tx_pool.size() << " tx pool (" << tx_pool_bytes / (1 << 20) << " MiB, " << tx_pool_evicted << " evicted), "
+			<< tx_pool_fees.size() << " tx senders";
+	if(db_cache) {
+		log(INFO) << "DB cache: " << db_cache->get_num_entries() << " entries, "
+				<< db_cache->get_size() / (1 << 20) << " / " << db_cache->max_size / (1 << 20) << " MiB";
+	}
+	{
+		const auto stats = vm::get_binary_cache_stats();
+		log(INFO) << "VM cache: " << stats.num_entries << " binaries, " << stats.size / (1 << 20) << " / " << stats.max_size / (1 << 20)
+				<< " MiB, " << stats.num_hit << " hits, " << stats.num_miss << " misses, " << stats.num_evict << " evicted";
+	}
+	if(!is_synced) {
+		print_sync_stats();
+
+		auto stats = db->get_commit_stats(true);
+		std::sort(stats.begin(), stats.end(),
+			[](const DataBase::commit_stats_t& lhs, const DataBase::commit_stats_t& rhs) -> bool {
+				return lhs.commit_time_us + lhs.flush_time_us > rhs.commit_time_us + rhs.flush_time_us;
+			});
+		for(size_t i = 0; i < stats.size() && i < 3; ++i) {
+			const auto& entry = stats[i];
+			log(INFO) << "DB commit: " << entry.name << " took " << entry.commit_time_us / 1000 << " ms for "
+					<< entry.num_commit << " commits, " << entry.flush_time_us / 1000 << " ms for " << entry.num_flush << " flushes";
+		}
+	}
+}
+
+void Node::print_sync_stats()
+{
+	// queue depth per stage, each stage is bounded by sync_pending / max_sync_ahead / commit_delay
+	size_t depth[SYNC_NUM_STAGES] = {};
+	depth[SYNC_VERIFY] = sync_verify_pending;
+	for(const auto& entry : fork_index) {
+		const auto& fork = entry.second;
+		if(fork->is_invalid) {
+			continue;
+		}
+		if(fork->is_validated) {
+			depth[SYNC_COMMIT]++;
+		} else if(fork->is_proof_verified) {
+			depth[SYNC_EXECUTE]++;
+		} else {
+			depth[SYNC_PROOF]++;
+		}
+	}
+	std::array<sync_stage_t, SYNC_NUM_STAGES> stats;
+	int64_t elapsed_us = 0;
+	{
+		std::lock_guard lock(sync_stats_mutex);
+		const auto now = get_time_us();
+		elapsed_us = now - sync_stats_begin_us;
+		stats = sync_stats;
+		sync_stats = {};
+		sync_stats_begin_us = now;
+	}
+	if(elapsed_us <= 0) {
+		return;
+	}
+	const char* names[SYNC_NUM_STAGES] = {"verify", "proof", "execute", "commit"};
+
+	for(int i = 0; i < SYNC_NUM_STAGES; ++i) {
+		const auto& entry = stats[i];
+		log(INFO) << "Sync " << names[i] << ": " << depth[i] << " queued, "
+				<< entry.num_blocks * 1e6 / elapsed_us << " blocks/s, "
+				<< int64_t(entry.busy_time_us * 100 / elapsed_us) << " % busy";
+	}
+	{
+		const uint64_t count = sig_verify_count.exchange(0);
+		const int64_t time_us = sig_verify_time_us.exchange(0);
+		if(count && time_us > 0) {
+			log(INFO) << "Sync signatures: " << int64_t(count * 1e6 / elapsed_us) << " /s, "
+					<< int64_t(count * 1e6 / time_us) << " /s per core";
+		}
+	}
+}
+
+void Node::add_sync_stats(const sync_stage_e stage, const uint64_t num_blocks, const int64_t time_us)
+{
+	std::lock_guard lock(sync_stats_mutex);
+	auto& entry = sync_stats[stage];
+	entry.num_blocks += num_blocks;
+	entry.busy_time_us += time_us;
 }
 
 void Node::on_stuck_timeout()
@@ -517,9 +630,37 @@ void Node::on_stuck_timeout()
 	if(is_synced) {
 		log(WARN) << "Lost sync due to progress timeout!";
 	}
+	else if(checkpoint_height) {
+		const auto root = get_root();
+		if(root->height < checkpoint_height) {
+			// peers have blocks on top of our root, but none of them link to it:
+			// what we committed below the checkpoint (without proof of space verification) is not the main chain
+			bool have_next = false;
+			bool is_linked = false;
+			const auto range = fork_index.equal_range(root->height + 1);
+			for(auto iter = range.first; iter != range.second; ++iter) {
+				const auto& fork = iter->second;
+				have_next = true;
+				is_linked = is_linked || (fork->is_connected && !fork->is_invalid);
+			}
+			if(have_next && !is_linked) {
+				on_checkpoint_failed("stuck at height " + std::to_string(root->height));
+				return;
+			}
+		}
+	}
 	start_sync(false);
 }
 
+void Node::on_checkpoint_failed(const std::string& reason)
+{
+	// we cannot tell which of the blocks below the checkpoint were verified, start over with full verification
+	log(ERROR) << "Chain does not link to checkpoint " << checkpoint_hash << " at height " << checkpoint_height
+			<< " (" << reason << "), re-syncing with full verification ...";
+	checkpoint_height = 0;
+	revert_sync(1);
+}
+
 void Node::start_sync(const vnx::bool_t& force)
 {
 	if((!is_synced || !do_sync) && !force) {
@@ -529,9 +670,19 @@ void Node::start_sync(const vnx::bool_t& force)
 		std::unique_lock lock(db_mutex);
 		is_synced = false;
 	}
+	// relax write log durability while syncing, recover() handles a crash
+	db->set_durability(0, 1000);
+	db_blocks->set_durability(0, 1000);
+	db->set_pipelined(true);
+
 	sync_pos = 0;
 	sync_peak = nullptr;
 	sync_retry = 0;
+	{
+		std::lock_guard lock(sync_stats_mutex);
+		sync_stats = {};
+		sync_stats_begin_us = get_time_us();
+	}
 	sync_more();
 }
 
@@ -545,6 +696,54 @@ void Node::revert_sync(const uint32_t& height)
 	start_sync(true);
 }
 
+void Node::watch_balances(const std::vector<addr_t>& addresses, const hash_t& client)
+{
+	if(addresses.size() > 100000) {
+		throw std::logic_error("too many addresses");
+	}
+	if(addresses.empty()) {
+		balance_watch.erase(client);
+	} else {
+		purge_balance_watch();
+
+		size_t total = addresses.size();
+		for(const auto& entry : balance_watch) {
+			if(entry.first != client) {
+				total += entry.second.second.size();
+			}
+		}
+		if(!balance_watch.count(client) && balance_watch.size() >= 64) {
+			throw std::logic_error("too many clients");
+		}
+		if(total > 1000000) {
+			throw std::logic_error("too many addresses in total");
+		}
+		balance_watch[client] = std::make_pair(get_time_ms(), addresses);
+	}
+	purge_balance_watch(true);
+}
+
+void Node::purge_balance_watch(const bool force)
+{
+	// clients need to renew their watch, in case they went away
+	const auto now = get_time_ms();
+	bool changed = force;
+	for(auto iter = balance_watch.begin(); iter != balance_watch.end();) {
+		if(now - iter->second.first > 900 * 1000) {
+			iter = balance_watch.erase(iter);
+			changed = true;
+		} else {
+			iter++;
+		}
+	}
+	if(changed) {
+		balance_watch_set.clear();
+		for(const auto& entry : balance_watch) {
+			balance_watch_set.insert(entry.second.second.begin(), entry.second.second.end());
+		}
+	}
+}
+
 void Node::sync_more()
 {
 	if(is_synced) {
@@ -556,6 +755,9 @@ void Node::sync_more()
 		sync_pos = root->height + 1;
 		sync_start = sync_pos;
 		log(INFO) << "Starting sync at height " << sync_pos;
+		if(sync_pos < checkpoint_height) {
+			log(INFO) << "Trusting checkpoint at height " << checkpoint_height << ", skipping proof of space verification until then";
+		}
 	}
 	if(sync_pos > root->height && sync_pos - root->height > params->commit_delay + max_sync_ahead) {
 		return;		// limit blocks in memory during sync
@@ -581,8 +783,6 @@ void Node::sync_height(const uint32_t& height)
 
 void Node::sync_result(const uint32_t& height, const std::vector<std::shared_ptr<const Block>>& result)
 {
-	sync_pending.erase(height);
-
 	// filter out blocks too far into the future
 	// prevent extension attack with invalid VDFs during sync
 	const auto max_time_stamp = get_time_ms() + max_future_sync * params->block_interval_ms;
@@ -597,9 +797,37 @@ void Node::sync_result(const uint32_t& height, const std::vector<std::shared_ptr
 		}
 	}
 
+	if(blocks.empty()) {
+		sync_verified(height, 0, blocks);
+		return;
+	}
+	// pre-validate in parallel to update(), height stays pending until added to fork tree
+	sync_verify_pending += blocks.size();
+
+	sync_threads->add_task([this, height, blocks]() {
+		const auto time_begin = get_time_us();
+		std::vector<std::shared_ptr<const Block>> valid;
+		for(auto block : blocks) {
+			if(pre_validate(block)) {
+				valid.push_back(block);
+			}
+		}
+		add_sync_stats(SYNC_VERIFY, blocks.size(), get_time_us() - time_begin);
+
+		add_task([this, height, valid, num_blocks = blocks.size()]() {
+			sync_verify_pending -= num_blocks;
+			sync_verified(height, num_blocks, valid);
+		});
+	});
+}
+
+void Node::sync_verified(const uint32_t& height, const size_t num_blocks, const std::vector<std::shared_ptr<const Block>>& blocks)
+{
+	sync_pending.erase(height);
+
 	uint64_t total_size = 0;
 	for(auto block : blocks) {
-		add_block(block);
+		add_valid_block(block);
 		total_size += block->static_cost;
 	}
 
@@ -620,7 +848,7 @@ void Node::sync_result(const uint32_t& height, const std::vector<std::shared_ptr
 		max_sync_pending = value * 0.1 + max_sync_pending * 0.9;
 	}
 	if(!is_synced) {
-		if(blocks.empty()) {
+		if(num_blocks == 0) {
 			if(!sync_peak || height < *sync_peak) {
 				sync_peak = height;
 			}
@@ -792,8 +1020,10 @@ std::shared_ptr<const BlockHeader> Node::fork_to(std::shared_ptr<fork_t> peak)
 		}
 		if(!fork->is_validated) {
 			try {
+				const auto time_begin = get_time_us();
 				fork->context = validate(block);
 				fork->is_validated = true;
+				add_sync_stats(SYNC_EXECUTE, 1, get_time_us() - time_begin);
 			}
 			catch(const std::exception& ex) {
 				log(WARN) << "Block validation failed for height " << block->height << " with: " << ex.what();
@@ -808,7 +1038,9 @@ std::shared_ptr<const BlockHeader> Node::fork_to(std::shared_ptr<fork_t> peak)
 				publish(block, output_verified_blocks);
 			}
 		}
+		const auto time_begin = get_time_us();
 		apply(block, fork->context);
+		add_sync_stats(SYNC_COMMIT, 0, get_time_us() - time_begin);
 	}
 	return did_fork ? forked_at : nullptr;
 }
@@ -981,6 +1213,10 @@ void Node::commit(std::shared_ptr<const Block> block)
 
 	root = block;	// update root at end
 
+	if(checkpoint_height && height == checkpoint_height) {
+		log(INFO) << "Passed trusted checkpoint at height " << height << " with hash " << block->hash;
+	}
+
 	history[block->hash] = block->get_header();
 	history_log.emplace(height, block->hash);
 
@@ -1011,35 +1247,23 @@ void Node::commit(std::shared_ptr<const Block> block)
 	publish(block, output_committed_blocks, is_synced ? 0 : BLOCKING);
 }
 
-size_t Node::prefetch_balances(const std::set<std::pair<addr_t, addr_t>>& keys) const
-{
-	if(keys.size() < 64) {
-		return 0;
-	}
-	std::atomic<size_t> total {0};
-	for(const auto& key : keys) {
-		threads->add_task([this, &key, &total]() {
-			total += balance_table.count(key);
-		});
-	}
-	threads->sync();
-	return total;
-}
-
 void Node::apply(	std::shared_ptr<const Block> block,
 					std::shared_ptr<const execution_context_t> context)
 {
 	if(block->prev != state_hash) {
 		throw std::logic_error("apply(): prev != state_hash");
 	}
+	std::set<addr_t> external;
+	std::vector<txio_entry_t> block_inputs;
+	std::vector<txio_entry_t> block_outputs;
 	try {
 		uint32_t counter = 0;
 		std::vector<hash_t> tx_ids;
 		std::unordered_set<hash_t> tx_set;
 		balance_cache_t balance_cache(&balance_table);
 
-		const auto block_inputs = block->get_inputs(params);
-		const auto block_outputs = block->get_outputs(params);
+		block_inputs = block->get_inputs(params);
+		block_outputs = block->get_outputs(params);
 		{
 			std::set<std::pair<addr_t, addr_t>> keys;
 			for(const auto& io : block_inputs) {
@@ -1048,7 +1272,7 @@ void Node::apply(	std::shared_ptr<const Block> block,
 			for(const auto& io : block_outputs) {
 				keys.emplace(io.address, io.contract);
 			}
-			prefetch_balances(keys);
+			balance_cache.prefetch(keys, threads.get());
 		}
 		std::unordered_map<addr_t, uint128_t> supply_delta;
 
@@ -1079,7 +1303,7 @@ void Node::apply(	std::shared_ptr<const Block> block,
 		for(const auto& tx : block->get_transactions()) {
 			if(tx) {
 				if(!tx->exec_result || !tx->exec_result->did_fail) {
-					apply(block, tx, counter);
+					apply(block, tx, counter, external);
 				}
 				tx_pool_erase(tx->id);
 				tx_set.insert(tx->id);
@@ -1146,6 +1370,7 @@ void Node::apply(	std::shared_ptr<const Block> block,
 
 		height_map.insert(block->height, block->hash);
 		contract_cache.clear();
+		tx_template_update(block, block_inputs);
 
 		state_hash = block->hash;
 
@@ -1159,11 +1384,13 @@ void Node::apply(	std::shared_ptr<const Block> block,
 		}
 		throw std::runtime_error("apply() failed with: " + std::string(ex.what()));
 	}
+	publish_balance_deltas(block, block_inputs, block_outputs, external);
 }
 
 void Node::apply(	std::shared_ptr<const Block> block,
 					std::shared_ptr<const Transaction> tx,
-					uint32_t& counter)
+					uint32_t& counter,
+					std::set<addr_t>& external)
 {
 	if(auto contract = tx->deploy)
 	{
@@ -1198,7 +1425,9 @@ void Node::apply(	std::shared_ptr<const Block> block,
 				owner_index = 2;
 			}
 			if(owner_index >= 0) {
-				owner_map.insert(std::make_tuple(exec->get_arg(owner_index).to<addr_t>(), block->height, ticket), std::make_pair(tx->id, type_hash));
+				const auto owner = exec->get_arg(owner_index).to<addr_t>();
+				owner_map.insert(std::make_tuple(owner, block->height, ticket), std::make_pair(tx->id, type_hash));
+				external.insert(owner);
 			}
 			{
 				std::set<addr_t> depends;
@@ -1216,6 +1445,7 @@ void Node::apply(	std::shared_ptr<const Block> block,
 		}
 		if(auto owner = contract->get_owner()) {
 			owner_map.insert(std::make_tuple(*owner, block->height, ticket), std::make_pair(tx->id, type_hash));
+			external.insert(*owner);
 		}
 	}
 	for(const auto& op : tx->execute)
@@ -1258,6 +1488,7 @@ void Node::apply(	std::shared_ptr<const Block> block,
 								balance = std::array<uint128, 2>();
 								swap_liquid_map.insert(key, balance);
 							}
+							external.insert(key.first);
 						}
 					}
 				}
@@ -1286,6 +1517,38 @@ void Node::apply(	std::shared_ptr<const Block> block,
 	}
 }
 
+void Node::publish_balance_deltas(	std::shared_ptr<const Block> block,
+									const std::vector<txio_entry_t>& inputs,
+									const std::vector<txio_entry_t>& outputs,
+									const std::set<addr_t>& external)
+{
+	purge_balance_watch();
+	if(balance_watch_set.empty()) {
+		return;
+	}
+	// published for every block (even if empty) so wallets can follow the chain
+	auto delta = BalanceDelta::create();
+	delta->height = block->height;
+	delta->hash = block->hash;
+	delta->prev = block->prev;
+	for(const auto& in : inputs) {
+		if(balance_watch_set.count(in.address)) {
+			delta->inputs.push_back(in);
+		}
+	}
+	for(const auto& out : outputs) {
+		if(balance_watch_set.count(out.address)) {
+			delta->outputs.push_back(out);
+		}
+	}
+	for(const auto& address : external) {
+		if(balance_watch_set.count(address)) {
+			delta->external.push_back(address);
+		}
+	}
+	publish(delta, output_balance_deltas);
+}
+
 void Node::revert(const uint32_t height)
 {
 	const auto time_begin = get_time_ms();
@@ -1324,6 +1587,7 @@ void Node::revert(const uint32_t height)
 	}
 
 	db->revert(height);
+	tx_template.clear();
 
 	uint32_t peak = 0;
 	if(!height_map.find_last(peak, state_hash)) {
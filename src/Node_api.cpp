@@ -132,7 +132,15 @@ std::shared_ptr<const NetworkInfo> Node::get_network_info() const
 			network = info;
 		}
 	}
-	return network;
+	if(!network) {
+		return nullptr;
+	}
+	// tx pool changes in between blocks
+	auto info = vnx::clone(network);
+	info->tx_pool_size = tx_pool.size();
+	info->tx_pool_bytes = tx_pool_bytes;
+	info->tx_pool_evicted = tx_pool_evicted;
+	return info;
 }
 
 hash_t Node::get_genesis_hash() const
@@ -865,7 +873,7 @@ std::map<vm::varptr_t, vm::varptr_t> Node::read_storage_map(const addr_t& contra
 		if(auto bin = std::dynamic_pointer_cast<const contract::Binary>(get_contract(exec->binary))) {
 			auto engine = std::make_shared<vm::Engine>(contract, storage, true, 0);
 			engine->gas_limit = params->max_tx_cost;
-			vm::load(engine, bin);
+			vm::load(engine, vm::decode_cached(bin, exec->binary));
 			for(const auto& entry : storage->find_entries(contract, address, height)) {
 				// need to use engine to support constant keys
 				if(auto key = engine->read(entry.first)) {
@@ -901,7 +909,7 @@ vnx::Variant Node::call_contract(
 			auto engine = std::make_shared<vm::Engine>(
 					address, storage, func->is_const, get_transaction_version(params, height));
 			engine->gas_limit = params->max_tx_cost;
-			vm::load(engine, bin);
+			vm::load(engine, vm::decode_cached(bin, exec->binary));
 			engine->write(vm::MEM_EXTERN + vm::EXTERN_TXID, vm::var_t());
 			engine->write(vm::MEM_EXTERN + vm::EXTERN_HEIGHT, vm::uint_t(height));
 			engine->write(vm::MEM_EXTERN + vm::EXTERN_ADDRESS, vm::to_binary(address));
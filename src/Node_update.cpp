@@ -196,6 +196,9 @@ void Node::verify_block_proofs()
 {
 	std::mutex mutex;
 	const auto root = get_root();
+	const auto time_begin = get_time_us();
+
+	uint64_t num_blocks = 0;
 
 	for(const auto& entry : fork_index)
 	{
@@ -221,6 +224,11 @@ void Node::verify_block_proofs()
 		if(!fork->is_connected || fork->is_invalid || fork->is_proof_verified) {
 			continue;
 		}
+		if(checkpoint_height && block->height == checkpoint_height && block->hash != checkpoint_hash) {
+			fork->is_invalid = true;
+			log(WARN) << "Block at checkpoint height " << block->height << " does not match checkpoint hash: " << block->hash;
+			continue;
+		}
 		if(!fork->is_vdf_verified) {
 			const auto vdf_points = find_vdf_points(block);
 			if(vdf_points.size()) {
@@ -234,10 +242,15 @@ void Node::verify_block_proofs()
 			}
 		}
 		if(fork->is_vdf_verified) {
-			threads->add_task([this, fork, &mutex]() {
+			num_blocks++;
+			// below a trusted checkpoint the hash chain up to checkpoint_hash vouches for the proofs:
+			// a chain that doesn't link to it cannot pass the checkpoint height, see on_checkpoint_failed()
+			const bool skip_pos = !is_synced && block->height < checkpoint_height;
+
+			threads->add_task([this, fork, skip_pos, &mutex]() {
 				const auto& block = fork->block;
 				try {
-					verify_proof(block);
+					verify_proof(block, skip_pos);
 					fork->is_proof_verified = true;
 
 					if(auto proof = block->proof[0]) {
@@ -255,6 +268,10 @@ void Node::verify_block_proofs()
 		}
 	}
 	threads->sync();
+
+	if(num_blocks) {
+		add_sync_stats(SYNC_PROOF, num_blocks, get_time_us() - time_begin);
+	}
 }
 
 void Node::update()
@@ -328,7 +345,9 @@ void Node::update()
 				&& !sync_pending.count(block->height)
 				&& (is_synced || block->height < sync_pos))
 			{
+				const auto time_begin = get_time_us();
 				commit(block);
+				add_sync_stats(SYNC_COMMIT, 1, get_time_us() - time_begin);
 			} else {
 				break;
 			}
@@ -529,9 +548,49 @@ void Node::on_sync_done(const uint32_t height)
 {
 	log(INFO) << "Finished sync at height " << height;
 	synced_since = height;
+
+	if(checkpoint_height && height < checkpoint_height) {
+		// never passed the checkpoint, so nothing vouches for the blocks we didn't fully verify
+		add_task([this, height]() {
+			on_checkpoint_failed("sync finished at height " + std::to_string(height));
+		});
+	}
+
+	db->set_pipelined(false);
+	db->set_durability(1);
+	db_blocks->set_durability(1);
+	db->flush_log();
+	db_blocks->flush_log();
 	update_control_deferred();
 }
 
+static uint64_t calc_tx_pool_bytes(std::shared_ptr<const Transaction> tx)
+{
+	// rough estimate including pool indices
+	uint64_t num_bytes = sizeof(Transaction) + 512;
+	for(const auto& in : tx->inputs) {
+		num_bytes += sizeof(in) + 128 + (in.memo ? in.memo->size() : 0);
+	}
+	for(const auto& out : tx->outputs) {
+		num_bytes += sizeof(out) + 128 + (out.memo ? 128 + out.memo->size() : 0);
+	}
+	num_bytes += tx->solutions.size() * 256;
+
+	for(const auto& op : tx->execute) {
+		num_bytes += 256;
+		if(auto exec = std::dynamic_pointer_cast<const operation::Execute>(op)) {
+			num_bytes += exec->method.size();
+			for(const auto& arg : exec->args) {
+				num_bytes += get_num_bytes(arg);
+			}
+		}
+	}
+	if(tx->deploy) {
+		num_bytes += tx->deploy->num_bytes();
+	}
+	return num_bytes;
+}
+
 bool Node::tx_pool_update(const tx_pool_t& entry, const bool force_add)
 {
 	if(entry.is_skipped) {
@@ -556,8 +615,13 @@ bool Node::tx_pool_update(const tx_pool_t& entry, const bool force_add)
 			} else {
 				tx_pool_fees[sender] = new_total;
 			}
+			auto tmp = entry;
+			tmp.num_bytes = calc_tx_pool_bytes(tx);
+
 			if(iter != tx_pool.end()) {
-				iter->second = entry;
+				tx_pool_cost -= iter->second.tx->static_cost;
+				tx_pool_bytes -= iter->second.num_bytes;
+				iter->second = tmp;
 			} else {
 				std::lock_guard<std::mutex> lock(mutex);
 
@@ -570,9 +634,16 @@ bool Node::tx_pool_update(const tx_pool_t& entry, const bool force_add)
 						tx_pool_index.emplace(std::make_pair(hash_t(out.address + (*out.memo)), tx->id), tx);
 					}
 				}
-				tx_pool[tx->id] = entry;
+				tx_pool[tx->id] = tmp;
 			}
-			return true;
+			tx_pool_fee_index.emplace(tx->fee_ratio, tx->id);
+			tx_pool_sender_index.emplace(sender, tx->fee_ratio, tx->id);
+			tx_pool_cost += tx->static_cost;
+			tx_pool_bytes += tmp.num_bytes;
+
+			// evict lowest fee transactions if full (might be this one)
+			tx_pool_evict();
+			return tx_pool.count(tx->id);
 		}
 	}
 	return false;
@@ -580,6 +651,8 @@ bool Node::tx_pool_update(const tx_pool_t& entry, const bool force_add)
 
 void Node::tx_pool_erase(const hash_t& txid)
 {
+	tx_template.erase(txid);
+
 	const auto iter = tx_pool.find(txid);
 	if(iter != tx_pool.end()) {
 		if(const auto& tx = iter->second.tx) {
@@ -590,7 +663,12 @@ void Node::tx_pool_erase(const hash_t& txid)
 						tx_pool_fees.erase(iter2);
 					}
 				}
+				tx_pool_sender_index.erase(std::make_tuple(*sender, tx->fee_ratio, tx->id));
 			}
+			tx_pool_fee_index.erase(std::make_pair(tx->fee_ratio, tx->id));
+			tx_pool_cost -= tx->static_cost;
+			tx_pool_bytes -= iter->second.num_bytes;
+
 			std::lock_guard<std::mutex> lock(mutex);
 
 			for(const auto& in : tx->get_inputs()) {
@@ -607,60 +685,112 @@ void Node::tx_pool_erase(const hash_t& txid)
 	}
 }
 
-void Node::purge_tx_pool()
+bool Node::is_template_tx(std::shared_ptr<const Transaction> tx) const
 {
-	const auto time_begin = get_time_ms();
-
-	std::vector<tx_pool_t> all_tx;
-	all_tx.reserve(tx_pool.size());
-	for(const auto& entry : tx_pool) {
-		all_tx.push_back(entry.second);
+	// only plain transfers: result depends on balances, expiry and version only
+	if(tx->deploy || !tx->get_operations().empty()) {
+		return false;
 	}
+	for(const auto& in : tx->inputs) {
+		if(in.flags & txin_t::IS_EXEC) {
+			return false;
+		}
+	}
+	return true;
+}
 
-	// sort transactions by fee ratio
-	std::sort(all_tx.begin(), all_tx.end(),
-		[](const tx_pool_t& lhs, const tx_pool_t& rhs) -> bool {
-			const auto L = lhs.tx->fee_ratio;
-			const auto R = rhs.tx->fee_ratio;
-			return (L == R) ? lhs.luck < rhs.luck : L > R;
-		});
+void Node::tx_template_update(std::shared_ptr<const Block> block, const std::vector<txio_entry_t>& block_inputs)
+{
+	const auto height = block->height + 1;
+	const bool is_hardfork = (height == params->hardfork2_height);
 
-	size_t num_purged = 0;
-	uint64_t total_pool_size = 0;
-	std::unordered_map<addr_t, std::pair<uint64_t, uint64_t>> sender_map;	// [sender => [balance, total fee]]
+	if(tx_template_hash != block->prev || tx_template_height != block->height || is_hardfork) {
+		tx_template.clear();
+	}
+	else if(!tx_template.empty()) {
+		// drop transactions whose sender or inputs were spent from
+		std::unordered_set<addr_t> spent;
+		for(const auto& in : block_inputs) {
+			spent.insert(in.address);
+		}
+		for(auto iter = tx_template.begin(); iter != tx_template.end();) {
+			const auto& tx = iter->second.tx;
+			bool is_dirty = (tx->sender && spent.count(*tx->sender));
+			for(const auto& in : tx->inputs) {
+				is_dirty = is_dirty || spent.count(in.address);
+			}
+			if(is_dirty || tx->expires < height) {
+				iter = tx_template.erase(iter);
+			} else {
+				iter++;
+			}
+		}
+	}
+	tx_template_hash = block->hash;
+	tx_template_height = height;
+}
 
+size_t Node::tx_pool_evict()
+{
 	const uint64_t max_pool_size = uint64_t(max_tx_pool) * params->max_block_size;
+	const uint64_t max_pool_bytes = uint64_t(max_tx_pool_mem) << 20;
 
-	// purge transactions from pool if overflowing
-	for(const auto& entry : all_tx) {
-		const auto& tx = entry.tx;
-		bool fee_overspend = false;
-		if(tx->sender) {
-			const auto sender = *tx->sender;
-			const auto iter = sender_map.emplace(sender, std::make_pair(0, 0));
-			auto& balance = iter.first->second.first;
-			auto& total_fee = iter.first->second.second;
-			if(iter.second) {
-				balance = get_balance(sender, addr_t());
+	size_t num_evicted = 0;
+	while(!tx_pool_fee_index.empty()
+		&& (tx_pool_cost > max_pool_size || (max_pool_bytes && tx_pool_bytes > max_pool_bytes)))
+	{
+		const auto iter = tx_pool_fee_index.begin();
+		const auto txid = iter->second;
+		tx_pool_fee_index.erase(iter);
+		tx_pool_erase(txid);
+		num_evicted++;
+	}
+	tx_pool_evicted += num_evicted;
+	return num_evicted;
+}
+
+void Node::purge_tx_pool()
+{
+	const auto time_begin = get_time_ms();
+
+	size_t num_purged = 0;
+	const std::vector<std::pair<addr_t, uint64_t>> senders(tx_pool_fees.begin(), tx_pool_fees.end());
+
+	// purge lowest fee transactions of senders that cannot pay for all of them anymore
+	for(const auto& entry : senders) {
+		const auto& sender = entry.first;
+		const auto balance = get_balance(sender, addr_t());
+		auto total_fee = entry.second;
+		while(total_fee > balance) {
+			const auto iter = tx_pool_sender_index.lower_bound(std::make_tuple(sender, uint32_t(0), hash_t()));
+			if(iter == tx_pool_sender_index.end() || std::get<0>(*iter) != sender) {
+				break;
+			}
+			const auto txid = std::get<2>(*iter);
+			tx_pool_sender_index.erase(iter);
+
+			const auto iter2 = tx_pool.find(txid);
+			if(iter2 != tx_pool.end()) {
+				total_fee -= std::min<uint64_t>(iter2->second.fee, total_fee);
+				tx_pool_erase(txid);
+				num_purged++;
 			}
-			total_fee += entry.fee;
-			fee_overspend = total_fee > balance;
-		}
-		if(!fee_overspend) {
-			total_pool_size += tx->static_cost;
-		}
-		if(total_pool_size > max_pool_size || fee_overspend) {
-			tx_pool_erase(tx->id);
-			num_purged++;
-		} else {
-			min_pool_fee_ratio = tx->fee_ratio;
 		}
 	}
-	if(total_pool_size < 9 * max_pool_size / 10) {
-		min_pool_fee_ratio = 0;
+	num_purged += tx_pool_evict();
+
+	const uint64_t max_pool_size = uint64_t(max_tx_pool) * params->max_block_size;
+	const uint64_t max_pool_bytes = uint64_t(max_tx_pool_mem) << 20;
+
+	min_pool_fee_ratio = 0;
+	if(!tx_pool_fee_index.empty()) {
+		if(tx_pool_cost >= 9 * max_pool_size / 10 || (max_pool_bytes && tx_pool_bytes >= 9 * max_pool_bytes / 10)) {
+			min_pool_fee_ratio = tx_pool_fee_index.begin()->first;
+		}
 	}
-	if(total_pool_size || num_purged) {
-		log(INFO) << uint64_t((total_pool_size * 10000) / max_pool_size) / 100. << " % mem pool, "
+	if(tx_pool_cost || num_purged) {
+		log(INFO) << uint64_t((tx_pool_cost * 10000) / max_pool_size) / 100. << " % mem pool, "
+				<< tx_pool_bytes / (1 << 20) << " MiB, "
 				<< min_pool_fee_ratio / 1024. << " min fee ratio, " << num_purged << " purged, took "
 				<< (get_time_ms() - time_begin) / 1e3 << " sec";
 	}
@@ -703,12 +833,17 @@ void Node::validate_new()
 		}
 	}
 
+	// keep results of plain transfers for the block template
+	const bool add_template = (state_hash == peak->hash && tx_template_hash == state_hash && tx_template_height == context->height);
+	std::vector<std::shared_ptr<const Transaction>> executed(tx_list.size());
+
 	// verify transactions in parallel
-	for(auto& entry : tx_list) {
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		auto& entry = tx_list[i];
 		if(!entry.is_valid) {
 			continue;
 		}
-		threads->add_task([this, &entry, context, deadline_ms]() {
+		threads->add_task([this, &entry, &executed, i, context, deadline_ms, add_template]() {
 			if(get_time_ms() > deadline_ms) {
 				entry.is_skipped = true;
 				return;
@@ -727,6 +862,12 @@ void Node::validate_new()
 					entry.cost = result->total_cost;
 					entry.fee = result->total_fee;
 					entry.is_valid = true;
+
+					if(add_template && !result->did_fail && is_template_tx(tx)) {
+						auto tmp = vnx::clone(tx);
+						tmp->update(*result, params);
+						executed[i] = tmp;
+					}
 				}
 			} catch(const std::exception& ex) {
 				if(show_warnings) {
@@ -741,11 +882,17 @@ void Node::validate_new()
 	threads->sync();
 
 	// update tx pool
-	for(const auto& entry : tx_list) {
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		const auto& entry = tx_list[i];
 		if(!entry.is_skipped) {
 			const auto& tx = entry.tx;
 			if(entry.is_valid) {
 				if(tx_pool_update(entry)) {
+					if(const auto& exec = executed[i]) {
+						auto tmp = entry;
+						tmp.tx = exec;
+						tx_template[tx->id] = tmp;
+					}
 					publish(tx, output_verified_transactions);
 				}
 			}
@@ -759,31 +906,48 @@ std::vector<Node::tx_pool_t> Node::validate_for_block(const int64_t deadline_ms)
 	const auto peak = get_peak();
 	const auto context = new_exec_context(peak->height + 1);
 
-	std::vector<tx_pool_t> all_tx;
-	all_tx.reserve(tx_pool.size());
-	for(const auto& entry : tx_pool) {
-		all_tx.push_back(entry.second);
-	}
-
-	// sort transactions by fee ratio
-	std::sort(all_tx.begin(), all_tx.end(),
-		[](const tx_pool_t& lhs, const tx_pool_t& rhs) -> bool {
-			return lhs.tx->fee_ratio > rhs.tx->fee_ratio;
-		});
-
 	std::vector<tx_pool_t> tx_list;
 	uint64_t total_verify_cost = 0;
 
-	// select transactions to verify
-	for(const auto& entry : all_tx) {
+	// select transactions to verify (highest fee ratio first)
+	for(auto iter = tx_pool_fee_index.rbegin(); iter != tx_pool_fee_index.rend(); ++iter) {
+		const auto iter2 = tx_pool.find(iter->second);
+		if(iter2 == tx_pool.end()) {
+			continue;
+		}
+		const auto& entry = iter2->second;
 		if(total_verify_cost + entry.cost <= params->max_block_cost) {
 			tx_list.push_back(entry);
 			total_verify_cost += entry.cost;
 		}
+		if(total_verify_cost + params->min_txfee > params->max_block_cost) {
+			break;	// block is full
+		}
 	}
 
-	// prepare synchronization
-	for(auto& entry : tx_list) {
+	if(tx_template_hash != state_hash || tx_template_height != context->height) {
+		tx_template.clear();
+		tx_template_hash = state_hash;
+		tx_template_height = context->height;
+	}
+	const auto tx_version = get_transaction_version(params, context->height);
+
+	// re-use template results, prepare synchronization for the rest
+	size_t num_cached = 0;
+	std::vector<bool> is_cached(tx_list.size());
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		auto& entry = tx_list[i];
+		const auto iter = tx_template.find(entry.tx->id);
+		if(iter != tx_template.end()) {
+			const auto& tx = iter->second.tx;
+			if(tx->version == tx_version && tx->expires >= context->height) {
+				entry = iter->second;
+				is_cached[i] = true;
+				num_cached++;
+				continue;
+			}
+			tx_template.erase(iter);
+		}
 		try {
 			entry.is_valid = true;
 			prepare_context(context, entry.tx);
@@ -793,8 +957,9 @@ std::vector<Node::tx_pool_t> Node::validate_for_block(const int64_t deadline_ms)
 	}
 
 	// verify transactions in parallel
-	for(auto& entry : tx_list) {
-		if(!entry.is_valid) {
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		auto& entry = tx_list[i];
+		if(!entry.is_valid || is_cached[i]) {
 			continue;
 		}
 		threads->add_task([this, &entry, context, deadline_ms]() {
@@ -834,6 +999,17 @@ std::vector<Node::tx_pool_t> Node::validate_for_block(const int64_t deadline_ms)
 	}
 	threads->sync();
 
+	// update template with new results
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		const auto& entry = tx_list[i];
+		if(!is_cached[i] && entry.is_valid && !entry.is_skipped) {
+			const auto& tx = entry.tx;
+			if(!tx->exec_result->did_fail && is_template_tx(tx)) {
+				tx_template[tx->id] = entry;
+			}
+		}
+	}
+
 	uint32_t num_skipped = 0;
 	uint64_t total_cost = 0;
 	uint64_t static_cost = 0;
@@ -888,6 +1064,7 @@ std::vector<Node::tx_pool_t> Node::validate_for_block(const int64_t deadline_ms)
 	if(num_skipped) {
 		log(WARN) << "Skipped " << num_skipped << " transactions due to block creation deadline";
 	}
+	log(DEBUG) << "Block template: re-used " << num_cached << " of " << tx_list.size() << " transactions";
 
 	const uint32_t N = params->min_fee_ratio.size();
 	if(N == 0) {
@@ -14,6 +14,8 @@
 #include <mmx/contract/Executable.hxx>
 #include <mmx/operation/Execute.hxx>
 #include <mmx/operation/Deposit.hxx>
+#include <mmx/solution/PubKey.hxx>
+#include <mmx/solution/MultiSig.hxx>
 #include <mmx/utils.h>
 #include <mmx/vm_interface.h>
 #include <mmx/exception.h>
@@ -22,6 +24,8 @@
 
 #include <vnx/vnx.h>
 
+#include <tuple>
+
 
 namespace mmx {
 
@@ -129,6 +133,10 @@ std::shared_ptr<Node::execution_context_t> Node::validate(std::shared_ptr<const
 	}
 	block->validate();
 
+	// check signatures in background, execution will hit the signature cache
+	// (remaining checks are dropped once we return, since `sig_verify` is the only owner)
+	const auto sig_verify = verify_signatures(block);
+
 	const auto prev = find_prev(block);
 	if(!prev) {
 		throw std::logic_error("missing prev");
@@ -235,25 +243,27 @@ std::shared_ptr<Node::execution_context_t> Node::validate(std::shared_ptr<const
 		throw std::logic_error("invalid project_addr");
 	}
 
-	{
-		std::set<std::pair<addr_t, addr_t>> keys;
-		for(const auto& tx : block->tx_list) {
-			if(tx->sender) {
-				keys.emplace(*tx->sender, addr_t());
-			}
-			for(const auto& in : tx->inputs) {
-				keys.emplace(in.address, in.contract);
-			}
-		}
-		prefetch_balances(keys);
-	}
-
 	auto context = new_exec_context(block->height);
 	{
 		std::unordered_set<addr_t> tx_set;
 		tx_set.reserve(block->tx_count);
 
 		balance_cache_t balance_cache(&balance_table);
+		{
+			std::set<std::pair<addr_t, addr_t>> keys;
+			for(const auto& tx : block->tx_list) {
+				if(!tx) {
+					continue;
+				}
+				if(tx->sender) {
+					keys.emplace(*tx->sender, addr_t());
+				}
+				for(const auto& in : tx->inputs) {
+					keys.emplace(in.address, in.contract);
+				}
+			}
+			balance_cache.prefetch(keys, threads.get());
+		}
 
 		std::shared_ptr<const Transaction> prev;
 
@@ -322,32 +332,36 @@ std::shared_ptr<Node::execution_context_t> Node::validate(std::shared_ptr<const
 			}
 		}
 	}
-	hash_t failed_tx;
-	std::mutex mutex;
-	std::exception_ptr failed_ex;
+	if(exec_optimistic) {
+		validate_optimistic(block, context);
+	} else {
+		hash_t failed_tx;
+		std::mutex mutex;
+		std::exception_ptr failed_ex;
 
-	for(const auto& tx : block->tx_list) {
-		threads->add_task([this, tx, context, &mutex, &failed_tx, &failed_ex]() {
-			context->wait(tx->id);
-			try {
-				if(validate(tx, context)) {
-					throw std::logic_error("missing exec_result");
+		for(const auto& tx : block->tx_list) {
+			threads->add_task([this, tx, context, &mutex, &failed_tx, &failed_ex]() {
+				context->wait(tx->id);
+				try {
+					if(validate(tx, context)) {
+						throw std::logic_error("missing exec_result");
+					}
+				} catch(...) {
+					std::lock_guard<std::mutex> lock(mutex);
+					failed_tx = tx->id;
+					failed_ex = std::current_exception();
 				}
-			} catch(...) {
-				std::lock_guard<std::mutex> lock(mutex);
-				failed_tx = tx->id;
-				failed_ex = std::current_exception();
-			}
-			context->signal(tx->id);
-		});
-	}
-	threads->sync();
+				context->signal(tx->id);
+			});
+		}
+		threads->sync();
 
-	if(failed_ex) {
-		try {
-			std::rethrow_exception(failed_ex);
-		} catch(const std::exception& ex) {
-			throw std::logic_error(std::string(ex.what()) + " (" + failed_tx.to_string() + ")");
+		if(failed_ex) {
+			try {
+				std::rethrow_exception(failed_ex);
+			} catch(const std::exception& ex) {
+				throw std::logic_error(std::string(ex.what()) + " (" + failed_tx.to_string() + ")");
+			}
 		}
 	}
 	if(block->reward_addr) {
@@ -364,6 +378,114 @@ std::shared_ptr<Node::execution_context_t> Node::validate(std::shared_ptr<const
 	return context;
 }
 
+std::shared_ptr<Node::sig_verify_t> Node::verify_signatures(std::shared_ptr<const Block> block) const
+{
+	auto job = std::make_shared<sig_verify_t>();
+	auto& list = job->list;
+	for(const auto& tx : block->tx_list) {
+		for(const auto& sol : tx->solutions) {
+			if(auto pubkey = std::dynamic_pointer_cast<const solution::PubKey>(sol)) {
+				list.emplace_back(pubkey->signature, pubkey->pubkey, tx->id);
+			}
+			else if(auto multi = std::dynamic_pointer_cast<const solution::MultiSig>(sol)) {
+				for(const auto& entry : multi->solutions) {
+					if(auto pubkey = std::dynamic_pointer_cast<const solution::PubKey>(entry.second)) {
+						list.emplace_back(pubkey->signature, pubkey->pubkey, tx->id);
+					}
+				}
+			}
+		}
+	}
+	job->left = list.size();
+	if(list.empty()) {
+		return job;
+	}
+	const int64_t chunk_size = 16;
+	const auto num_tasks = std::min<int64_t>((list.size() + chunk_size - 1) / chunk_size, num_sig_threads);
+
+	// Note: runs on its own pool, nothing waits for it, failures are reported by validate(tx)
+	const std::weak_ptr<sig_verify_t> handle = job;
+	for(int64_t k = 0; k < num_tasks; ++k) {
+		sig_threads->add_task([this, handle, chunk_size]() {
+			while(auto job = handle.lock()) {
+				const auto end = job->left.fetch_sub(chunk_size);
+				if(end <= 0) {
+					break;
+				}
+				const auto begin = std::max<int64_t>(end - chunk_size, 0);
+				const auto time_begin = get_time_us();
+				for(auto i = end - 1; i >= begin; --i) {
+					const auto& entry = job->list[i];
+					try {
+						std::get<0>(entry).verify(std::get<1>(entry), std::get<2>(entry));
+					} catch(...) {
+						// ignore
+					}
+				}
+				sig_verify_count += end - begin;
+				sig_verify_time_us += get_time_us() - time_begin;
+			}
+		});
+	}
+	return job;
+}
+
+void Node::validate_optimistic(std::shared_ptr<const Block> block, std::shared_ptr<execution_context_t> context) const
+{
+	struct speculation_t {
+		std::shared_ptr<vm::StorageTracker> reads;
+		std::shared_ptr<vm::StorageCache> pending;
+		std::exception_ptr failed_ex;
+	};
+	const auto& tx_list = block->tx_list;
+	std::vector<speculation_t> result(tx_list.size());
+
+	// execute all transactions in parallel against the state before this block
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		threads->add_task([this, &tx_list, &result, context, i]() {
+			auto& out = result[i];
+			out.reads = std::make_shared<vm::StorageTracker>(context->storage);
+			try {
+				if(validate(tx_list[i], context, out.reads, &out.pending)) {
+					throw std::logic_error("missing exec_result");
+				}
+			} catch(...) {
+				out.failed_ex = std::current_exception();
+			}
+		});
+	}
+	threads->sync();
+
+	// commit in block order, re-execute when a previous transaction wrote something we read
+	vm::storage_keys_t written;
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		const auto& tx = tx_list[i];
+		auto& out = result[i];
+		if(written.intersects(out.reads->get_reads())) {
+			out.pending = nullptr;
+			out.failed_ex = nullptr;
+			try {
+				if(validate(tx, context, nullptr, &out.pending)) {
+					throw std::logic_error("missing exec_result");
+				}
+			} catch(...) {
+				out.failed_ex = std::current_exception();
+			}
+		}
+		if(out.failed_ex) {
+			try {
+				std::rethrow_exception(out.failed_ex);
+			} catch(const std::exception& ex) {
+				throw std::logic_error(std::string(ex.what()) + " (" + tx->id.to_string() + ")");
+			}
+		}
+		if(out.pending) {
+			written.insert(out.pending->get_writes());
+			out.pending->commit_to(*context->storage);	// speculative caches are backed by a read-only tracker
+		}
+	}
+}
+
 exec_result_t Node::validate(std::shared_ptr<const Transaction> tx) const
 {
 	if(tx->exec_result) {
@@ -499,7 +621,7 @@ void Node::execute(	std::shared_ptr<const Transaction> tx,
 			throw std::logic_error("method is not public: " + method_name);
 		}
 	}
-	vm::load(engine, binary);
+	vm::load(engine, vm::decode_cached(binary, executable->binary));
 
 	if(context->height >= params->hardfork2_height) {
 		// after vm::load() so map keys are initialized
@@ -606,7 +728,9 @@ void Node::execute(	std::shared_ptr<const Transaction> tx,
 
 std::shared_ptr<const exec_result_t>
 Node::validate(	std::shared_ptr<const Transaction> tx,
-				std::shared_ptr<const execution_context_t> context) const
+				std::shared_ptr<const execution_context_t> context,
+				std::shared_ptr<vm::Storage> backend,
+				std::shared_ptr<vm::StorageCache>* pending) const
 {
 	if(!tx->is_valid(params)) {
 		throw mmx::static_failure("invalid tx");
@@ -631,7 +755,7 @@ Node::validate(	std::shared_ptr<const Transaction> tx,
 	std::vector<txin_t> exec_inputs;
 	std::vector<txout_t> exec_outputs;
 	balance_cache_t balance_cache(&balance_table);
-	auto storage_cache = std::make_shared<vm::StorageCache>(context->storage);
+	auto storage_cache = std::make_shared<vm::StorageCache>(backend ? backend : context->storage);
 	std::unordered_map<addr_t, uint128> amounts;
 	std::map<std::pair<addr_t, addr_t>, uint128> deposit_map;
 	std::map<std::pair<addr_t, addr_t>, uint128> exec_spend_map;
@@ -940,7 +1064,11 @@ Node::validate(	std::shared_ptr<const Transaction> tx,
 	}
 
 	if(!failed_ex) {
-		storage_cache->commit();
+		if(pending) {
+			*pending = storage_cache;	// caller commits
+		} else {
+			storage_cache->commit();
+		}
 	}
 	return out;
 }
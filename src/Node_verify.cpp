@@ -13,6 +13,7 @@
 
 #include <vnx/vnx.h>
 #include <sha256_avx2.h>
+#include <sha256_avx512.h>
 #include <sha256_ni.h>
 #include <sha256_arm.h>
 
@@ -71,9 +72,10 @@ void Node::verify(std::shared_ptr<const ProofResponse> value) const
 	publish(value, output_verified_proof);
 }
 
-void Node::verify_proof(std::shared_ptr<const BlockHeader> block) const
+void Node::verify_proof(std::shared_ptr<const BlockHeader> block, const bool skip_pos) const
 {
 	// NOTE: NEEDS TO BE THREAD SAFE
+	// skip_pos: everything except the proof of space itself (trusted checkpoint)
 	const auto prev = find_prev(block);
 	if(!prev) {
 		throw std::logic_error("cannot verify");
@@ -175,13 +177,13 @@ void Node::verify_proof(std::shared_ptr<const BlockHeader> block) const
 	const auto challenge = get_challenge(block, 0, space_diff);
 
 	for(auto proof : block->proof) {
-		verify_proof(proof, challenge, space_diff, block->vdf_height);
+		verify_proof(proof, challenge, space_diff, block->vdf_height, skip_pos);
 	}
 }
 
 template<typename T>
 void Node::verify_proof_impl(
-		std::shared_ptr<const T> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height) const
+		std::shared_ptr<const T> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height, const bool skip_pos) const
 {
 	if(proof->ksize < params->min_ksize) {
 		throw std::logic_error("ksize too low");
@@ -189,6 +191,9 @@ void Node::verify_proof_impl(
 	if(proof->ksize > params->max_ksize) {
 		throw std::logic_error("ksize too high");
 	}
+	if(skip_pos) {
+		return;
+	}
 	const bool hard_fork = vdf_height >= params->hardfork1_height;
 	const auto plot_challenge = get_plot_challenge(challenge, proof->plot_id);
 
@@ -201,7 +206,7 @@ void Node::verify_proof_impl(
 	}
 }
 
-void Node::verify_proof(std::shared_ptr<const ProofOfSpace> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height) const
+void Node::verify_proof(std::shared_ptr<const ProofOfSpace> proof, const hash_t& challenge, const uint64_t space_diff, const uint32_t& vdf_height, const bool skip_pos) const
 {
 	if(space_diff <= 0) {
 		throw std::logic_error("difficulty zero");
@@ -224,9 +229,9 @@ void Node::verify_proof(std::shared_ptr<const ProofOfSpace> proof, const hash_t&
 	const auto nft_proof = std::dynamic_pointer_cast<const ProofOfSpaceNFT>(proof);
 
 	if(og_proof) {
-		verify_proof_impl(og_proof, challenge, space_diff, vdf_height);
+		verify_proof_impl(og_proof, challenge, space_diff, vdf_height, skip_pos);
 	} else if(nft_proof) {
-		verify_proof_impl(nft_proof, challenge, space_diff, vdf_height);
+		verify_proof_impl(nft_proof, challenge, space_diff, vdf_height, skip_pos);
 	} else {
 		throw std::logic_error("invalid proof type: " + proof->get_type_name());
 	}
@@ -267,6 +272,8 @@ void Node::verify_vdf_cpu(std::shared_ptr<const ProofOfTime> proof) const
 {
 	static bool have_sha_ni = sha256_ni_available();
 	static bool have_sha_arm = sha256_arm_available();
+	static bool have_avx2 = avx2_available();
+	static bool have_avx512 = avx512_available();
 
 	const auto& segments = proof->segments;
 	if(segments.empty()) {
@@ -278,6 +285,17 @@ void Node::verify_vdf_cpu(std::shared_ptr<const ProofOfTime> proof) const
 	const uint32_t num_iters = proof->segment_size;
 	const uint32_t num_chunks = (segments.size() + batch_size - 1) / batch_size;
 
+	// lanes per kernel call, AVX-512 x16 is fastest where available, then SHA extensions x2
+	// (x4 needs more than 16 xmm registers and ends up slower, see tools/vdf_bench)
+	uint32_t kernel_lanes = 0;
+	if(have_avx512) {
+		kernel_lanes = 16;
+	} else if(have_sha_ni || have_sha_arm) {
+		kernel_lanes = 2;
+	} else if(have_avx2) {
+		kernel_lanes = 8;
+	}
+
 #pragma omp parallel for
 	for(int chunk = 0; chunk < int(num_chunks); ++chunk)
 	{
@@ -287,8 +305,6 @@ void Node::verify_vdf_cpu(std::shared_ptr<const ProofOfTime> proof) const
 		const auto num_lanes = std::min<uint32_t>(batch_size, segments.size() - chunk * batch_size);
 
 		hash_t point[batch_size];
-		uint8_t hash[batch_size][32];
-		uint8_t input[batch_size][64];
 
 		for(uint32_t j = 0; j < num_lanes; ++j)
 		{
@@ -300,24 +316,45 @@ void Node::verify_vdf_cpu(std::shared_ptr<const ProofOfTime> proof) const
 				point[j] = hash_t(point[j] + proof->reward_addr);
 			}
 		}
-		if(have_sha_ni || have_sha_arm) {
-			// Note: `num_lanes` is always a multiple of 2 (based on chain params)
-			for(uint32_t j = 0; j < num_lanes; j += 2)
+		if(kernel_lanes) {
+			// Note: `num_lanes` is always a multiple of 2 (based on chain params), unused lanes are computed anyway
+			uint8_t hash[batch_size * 32] = {};
+			for(uint32_t j = 0; j < num_lanes; ++j) {
+				::memcpy(hash + j * 32, point[j].data(), 32);
+			}
+			for(uint32_t j = 0; j < num_lanes;)
 			{
-				uint8_t hashx2[32 * 2];
-				::memcpy(hashx2, point[j].data(), 32);
-				::memcpy(hashx2 + 32, point[j + 1].data(), 32);
-				if(have_sha_ni) {
-					recursive_sha256_ni_x2(hashx2, num_iters);
-				} else if(have_sha_arm) {
-					recursive_sha256_arm_x2(hashx2, num_iters);
-				} else {
-					throw std::logic_error("invalid feature state");
+				// narrow down for a partial last chunk instead of hashing mostly empty lanes
+				auto lanes = kernel_lanes;
+				const auto left = num_lanes - j;
+				if(lanes > left) {
+					if(have_sha_ni || have_sha_arm) {
+						lanes = 2;
+					} else if(lanes == 16 && have_avx2 && left <= 8) {
+						lanes = 8;
+					}
 				}
-				::memcpy(point[j].data(), hashx2, 32);
-				::memcpy(point[j + 1].data(), hashx2 + 32, 32);
+				switch(lanes) {
+					case 16: recursive_sha256_avx512_x16(hash + j * 32, num_iters); break;
+					case 8: recursive_sha256_avx2_x8(hash + j * 32, num_iters); break;
+					case 2:
+						if(have_sha_ni) {
+							recursive_sha256_ni_x2(hash + j * 32, num_iters);
+						} else {
+							recursive_sha256_arm_x2(hash + j * 32, num_iters);
+						}
+						break;
+					default: throw std::logic_error("invalid feature state");
+				}
+				j += lanes;
+			}
+			for(uint32_t j = 0; j < num_lanes; ++j) {
+				::memcpy(point[j].data(), hash + j * 32, 32);
 			}
 		} else {
+			uint8_t hash[batch_size][32];
+			uint8_t input[batch_size][64];
+
 			for(uint32_t k = 0; k < num_iters; ++k)
 			{
 				for(uint32_t j = 0; j < num_lanes; ++j) {
@@ -63,6 +63,9 @@ void Wallet::main()
 
 	tx_log.open(database_path + "tx_log");
 
+	watch_id = hash_t::random();
+	subscribe(input_balance_deltas, 10000);
+
 	node = std::make_shared<NodeClient>(node_server);
 	http = std::make_shared<vnx::addons::HttpInterface<Wallet>>(this, vnx_name);
 	add_async_client(http);
@@ -642,9 +645,27 @@ void Wallet::update_cache(const uint32_t& index) const
 	if(now - wallet->last_update > cache_timeout_ms)
 	{
 		const auto height = node->get_height();
+
+		// in between full updates balances are kept current via handle(BalanceDelta)
+		if(wallet->block_hash && now - wallet->last_refresh < cache_refresh_ms
+			&& height >= wallet->height && height <= wallet->height + 1)
+		{
+			wallet->last_update = now;
+			return;
+		}
 		const auto addresses = wallet->get_all_addresses();
-		const auto balances = node->get_all_balances(addresses, token_whitelist);
 		const auto contracts = node->get_contracts_owned_by(addresses);
+		try {
+			// owned contracts are watched too, so their balances can follow deltas
+			auto watched = addresses;
+			watched.insert(watched.end(), contracts.begin(), contracts.end());
+			node->watch_balances(watched, hash_t(watch_id + std::to_string(index)));
+		} catch(const std::exception& ex) {
+			log(DEBUG) << "watch_balances() failed with: " << ex.what();
+		}
+
+		const auto block_hash = node->get_block_hash(height);
+		const auto balances = node->get_all_balances(addresses, token_whitelist);
 		const auto liquidity = node->get_swap_liquidity_by(addresses);
 		const auto history = wallet->pending_tx.empty() ? std::vector<hash_t>() :
 				node->get_tx_ids_since(wallet->height - std::min(params->commit_delay, wallet->height));
@@ -658,8 +679,26 @@ void Wallet::update_cache(const uint32_t& index) const
 				wallet->external_balance_map[entry2.first] += entry2.second;
 			}
 		}
+		wallet->contract_set = std::set<addr_t>(contracts.begin(), contracts.end());
 		wallet->update_cache(balances, history, height);
+
+		// only follow deltas if the chain did not move while fetching
+		if(node->get_height() == height && node->get_block_hash(height) == block_hash) {
+			wallet->block_hash = block_hash;
+		} else {
+			wallet->block_hash = nullptr;
+		}
 		wallet->last_update = now;
+		wallet->last_refresh = now;
+	}
+}
+
+void Wallet::handle(std::shared_ptr<const BalanceDelta> value)
+{
+	for(auto wallet : wallets) {
+		if(wallet && !wallet->update_cache(value, token_whitelist)) {
+			wallet->block_hash = nullptr;
+		}
 	}
 }
 
@@ -1121,6 +1160,12 @@ void Wallet::add_token(const addr_t& address)
 	}
 	vnx::write_config_file(path, object);
 	token_whitelist.insert(address);
+
+	for(auto wallet : wallets) {
+		if(wallet) {
+			wallet->block_hash = nullptr;
+		}
+	}
 }
 
 void Wallet::rem_token(const addr_t& address)
@@ -1143,6 +1188,11 @@ void Wallet::rem_token(const addr_t& address)
 	if(address != addr_t()) {
 		token_whitelist.erase(address);
 	}
+	for(auto wallet : wallets) {
+		if(wallet) {
+			wallet->block_hash = nullptr;
+		}
+	}
 }
 
 hash_t Wallet::get_master_seed(const uint32_t& index) const
@@ -104,6 +104,7 @@ int main(int argc, char** argv)
 		module->config_path = mmx_home + module->config_path;
 		module->storage_path = mmx_home + module->storage_path;
 		module->database_path = mmx_network + module->database_path;
+		proxy->import_list.push_back(module->input_balance_deltas);
 		module.start_detached();
 		{
 			vnx::Handle<vnx::Server> module = new vnx::Server("Server5", vnx::Endpoint::from_url("localhost:11335"));
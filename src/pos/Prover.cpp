@@ -10,10 +10,114 @@
 #include <mmx/pos/verify.h>
 #include <mmx/pos/util.h>
 
+#include <list>
+#include <mutex>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 
 namespace mmx {
 namespace pos {
 
+/*
+ * Cache of open plot files, a file is removed from the cache while in use.
+ */
+typedef std::list<std::pair<std::string, std::unique_ptr<std::ifstream>>> file_list_t;
+
+static std::mutex g_file_mutex;
+static size_t g_max_open_files = 256;		// until set_max_open_files() is called
+static file_list_t g_open_files;		// most recently used first
+static std::unordered_multimap<std::string, file_list_t::iterator> g_open_files_map;
+
+static void purge_files(const size_t max_count)
+{
+	while(g_open_files.size() > max_count) {
+		const auto iter = std::prev(g_open_files.end());
+		const auto range = g_open_files_map.equal_range(iter->first);
+		for(auto iter2 = range.first; iter2 != range.second; ++iter2) {
+			if(iter2->second == iter) {
+				g_open_files_map.erase(iter2);
+				break;
+			}
+		}
+		g_open_files.erase(iter);
+	}
+}
+
+size_t set_max_open_files(size_t count)
+{
+	if(!count) {
+#ifdef _WIN32
+		count = _getmaxstdio() / 2;
+#else
+		struct rlimit limit = {};
+		if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+			count = limit.rlim_cur / 2;
+		} else {
+			count = 512;
+		}
+#endif
+	}
+	std::lock_guard<std::mutex> lock(g_file_mutex);
+	g_max_open_files = count;
+	purge_files(count);
+	return count;
+}
+
+class plot_file_t {
+public:
+	plot_file_t(const std::string& file_path)
+		:	file_path(file_path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(g_file_mutex);
+			const auto iter = g_open_files_map.find(file_path);
+			if(iter != g_open_files_map.end()) {
+				file = std::move(iter->second->second);
+				g_open_files.erase(iter->second);
+				g_open_files_map.erase(iter);
+			}
+		}
+		if(!file) {
+			file = std::make_unique<std::ifstream>(file_path, std::ios_base::binary);
+		}
+		if(!file->good()) {
+			throw std::runtime_error("failed to open file");
+		}
+	}
+
+	~plot_file_t() {
+		close();
+	}
+
+	// returns file to the cache
+	void close() {
+		// don't keep files after a read error
+		if(file && file->good()) {
+			std::lock_guard<std::mutex> lock(g_file_mutex);
+			g_open_files.emplace_front(file_path, std::move(file));
+			g_open_files_map.emplace(file_path, g_open_files.begin());
+			purge_files(g_max_open_files);
+		}
+		file = nullptr;
+	}
+
+	std::ifstream* operator->() {
+		return file.get();
+	}
+
+private:
+	const std::string file_path;
+	std::unique_ptr<std::ifstream> file;
+
+};
+
+
 Prover::Prover(const std::string& file_path)
 	:	file_path(file_path)
 {
@@ -26,12 +130,40 @@ Prover::Prover(const std::string& file_path)
 	}
 }
 
-std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const int plot_filter) const
+Prover::~Prover()
 {
-	std::ifstream file(file_path, std::ios_base::binary);
-	if(!file.good()) {
-		throw std::runtime_error("failed to open file");
+	// close cached handles, file might be deleted or replaced
+	std::lock_guard<std::mutex> lock(g_file_mutex);
+	const auto range = g_open_files_map.equal_range(file_path);
+	for(auto iter = range.first; iter != range.second; ++iter) {
+		g_open_files.erase(iter->second);
 	}
+	g_open_files_map.erase(range.first, range.second);
+}
+
+void Prover::load_index()
+{
+	plot_file_t file(file_path);
+
+	const uint64_t num_parks_y = cdiv<uint64_t>(header->num_entries_y, header->park_size_y);
+
+	std::vector<uint32_t> index(num_parks_y);
+	for(uint64_t i = 0; i < num_parks_y; ++i)
+	{
+		uint64_t tmp = 0;
+		file->seekg(header->table_offset_y + i * header->park_bytes_y);
+		file->read((char*)&tmp, 4);
+		if(!file->good()) {
+			throw std::runtime_error("failed to read Y park header " + std::to_string(i));
+		}
+		index[i] = read_bits(&tmp, 0, header->ksize);
+	}
+	park_y_index = std::move(index);
+}
+
+std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const int plot_filter) const
+{
+	plot_file_t file(file_path);
 	const uint32_t kmask = ((uint64_t(1) << header->ksize) - 1);
 
 	const uint32_t Y_begin = bytes_t<4>(challenge.data(), 4).to_uint<uint32_t>() & kmask;
@@ -46,9 +178,17 @@ std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const i
 	{
 		const int32_t num_parks_y = cdiv<uint64_t>(header->num_entries_y, header->park_size_y);
 
-		const uint32_t Y_try_first = std::max<int64_t>(int64_t(Y_begin) + initial_y_shift, 0);
-		int32_t park_index = ((uint64_t(Y_try_first >> 1) * header->num_entries_y) >> (header->ksize - 1)) / header->park_size_y;
+		const bool have_index = !park_y_index.empty();
 
+		int32_t park_index = 0;
+		if(have_index) {
+			// last park starting before Y_begin (previous park can contain Y_begin if first Y == Y_begin)
+			const auto iter = std::lower_bound(park_y_index.begin(), park_y_index.end(), Y_begin);
+			park_index = std::max<int64_t>(iter - park_y_index.begin() - 1, 0);
+		} else {
+			const uint32_t Y_try_first = std::max<int64_t>(int64_t(Y_begin) + initial_y_shift, 0);
+			park_index = ((uint64_t(Y_try_first >> 1) * header->num_entries_y) >> (header->ksize - 1)) / header->park_size_y;
+		}
 		park_index = std::min<int32_t>(park_index, num_parks_y - 1);
 
 		std::vector<uint64_t> bit_stream(cdiv(header->park_bytes_y - 4, 8));
@@ -59,15 +199,21 @@ std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const i
 			if(i > 100) {
 				throw std::runtime_error("failed to find Y park");
 			}
-			file.seekg(header->table_offset_y + uint64_t(park_index) * header->park_bytes_y);
-
 			uint32_t Y_i = 0;
-			{
+			if(have_index) {
+				Y_i = park_y_index[park_index];
+				if(Y_i >= Y_end) {
+					break;
+				}
+				file->seekg(header->table_offset_y + uint64_t(park_index) * header->park_bytes_y + 4);
+			} else {
+				file->seekg(header->table_offset_y + uint64_t(park_index) * header->park_bytes_y);
+
 				uint64_t tmp = 0;
-				file.read((char*)&tmp, 4);
+				file->read((char*)&tmp, 4);
 				Y_i = read_bits(&tmp, 0, header->ksize);
 			}
-			if(!file.good()) {
+			if(!file->good()) {
 				throw std::runtime_error("failed to read Y park header " + std::to_string(park_index));
 			}
 			if(debug) {
@@ -85,9 +231,9 @@ std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const i
 			}
 			have_begin = true;
 
-			file.read((char*)bit_stream.data(), header->park_bytes_y - 4);
+			file->read((char*)bit_stream.data(), header->park_bytes_y - 4);
 
-			if(!file.good()) {
+			if(!file->good()) {
 				throw std::runtime_error("failed to read Y park " + std::to_string(park_index));
 			}
 			const auto deltas = decode(bit_stream, header->park_size_y - 1);
@@ -138,9 +284,9 @@ std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const i
 		if(header->has_meta) {
 			const uint64_t park_index =  final_index / header->park_size_meta;
 			const uint32_t park_offset = final_index % header->park_size_meta;
-			file.seekg(header->table_offset_meta + park_index * header->park_bytes_meta);
-			file.read((char*)meta_park.data(), header->park_bytes_meta);
-			if(!file.good()) {
+			file->seekg(header->table_offset_meta + park_index * header->park_bytes_meta);
+			file->read((char*)meta_park.data(), header->park_bytes_meta);
+			if(!file->good()) {
 				throw std::runtime_error("failed to read meta park " + std::to_string(park_index));
 			}
 			uint32_t meta[N_META_OUT] = {};
@@ -164,10 +310,7 @@ std::vector<proof_data_t> Prover::get_qualities(const hash_t& challenge, const i
 
 proof_data_t Prover::get_full_proof(const uint64_t final_index) const
 {
-	std::ifstream file(file_path, std::ios_base::binary);
-	if(!file.good()) {
-		throw std::runtime_error("failed to open file");
-	}
+	plot_file_t file(file_path);
 	std::vector<uint32_t> X_values;
 	std::vector<uint64_t> pointers;
 	pointers.push_back(final_index);
@@ -182,9 +325,9 @@ proof_data_t Prover::get_full_proof(const uint64_t final_index) const
 		{
 			const uint64_t park_index =  index / header->park_size_pd;
 			const uint32_t park_offset = index % header->park_size_pd;
-			file.seekg(pd_offset + park_index * header->park_bytes_pd);
-			file.read((char*)pd_park.data(), header->park_bytes_pd);
-			if(!file.good()) {
+			file->seekg(pd_offset + park_index * header->park_bytes_pd);
+			file->read((char*)pd_park.data(), header->park_bytes_pd);
+			if(!file->good()) {
 				throw std::runtime_error("failed to read PD park " + std::to_string(park_index) + " at table " + std::to_string(table)); 
 			}
 			const uint64_t position = read_bits(pd_park.data(), park_offset * header->ksize, header->ksize);
@@ -212,9 +355,9 @@ proof_data_t Prover::get_full_proof(const uint64_t final_index) const
 	{
 		const uint64_t park_index =  index / header->park_size_x;
 		const uint32_t park_offset = index % header->park_size_x;
-		file.seekg(header->table_offset_x + park_index * header->park_bytes_x);
-		file.read((char*)x_park.data(), header->park_bytes_x);
-		if(!file.good()) {
+		file->seekg(header->table_offset_x + park_index * header->park_bytes_x);
+		file->read((char*)x_park.data(), header->park_bytes_x);
+		if(!file->good()) {
 			throw std::runtime_error("failed to read X park " + std::to_string(park_index));
 		}
 		const uint64_t line_point = read_bits(x_park.data(), park_offset * header->entry_bits_x, header->entry_bits_x);
@@ -235,6 +378,8 @@ proof_data_t Prover::get_full_proof(const uint64_t final_index) const
 		}
 		std::cout << std::endl;
 	}
+	file.close();
+
 	std::vector<uint32_t> X_out;
 	const auto res = compute(X_values, &X_out, header->plot_id, header->ksize, header->ksize - header->xbits);
 	if(res.empty()) {
@@ -7,6 +7,9 @@
 
 #include <mmx/pos/mem_hash.h>
 
+#include <sha256_avx2.h>
+#include <sha256_avx512.h>
+
 #include <map>
 #include <cstring>
 #include <iostream>
@@ -82,6 +85,20 @@ void calc_mem_hash(uint32_t* mem, uint8_t* hash, const int num_iter)
 	::memcpy(hash, state, N * 4);
 }
 
+int get_mem_hash_lanes()
+{
+	static const bool have_avx2 = avx2_available();
+	static const bool have_avx512 = avx512_available();
+
+	if(have_avx512) {
+		return 16;
+	}
+	if(have_avx2) {
+		return 8;
+	}
+	return 1;
+}
+
 
 } // pos
 } // mmx
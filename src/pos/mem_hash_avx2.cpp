@@ -0,0 +1,146 @@
+#include <mmx/pos/mem_hash.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(_WIN32)
+
+#include <immintrin.h>
+
+
+namespace mmx {
+namespace pos {
+
+static constexpr int LANES = 8;
+
+static const uint32_t MEM_HASH_INIT[16] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174
+};
+
+#define ADD _mm256_add_epi32
+#define XOR _mm256_xor_si256
+#define ROTL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define MMXPOS_HASHROUND_AVX2(a, b, c, d) \
+	a = ADD(a, b);              \
+	d = ROTL(XOR(d, a), 16);    \
+	c = ADD(c, d);              \
+	b = ROTL(XOR(b, c), 12);    \
+	a = ADD(a, b);              \
+	d = ROTL(XOR(d, a), 8);     \
+	c = ADD(c, d);              \
+	b = ROTL(XOR(b, c), 7);
+
+void gen_mem_array_avx2_x8(uint32_t* mem, const uint8_t* key, const uint32_t mem_size)
+{
+	if(mem_size % 32) {
+		throw std::logic_error("mem_size % 32 != 0");
+	}
+	__m256i state[32];
+
+	for(int i = 0; i < 16; ++i) {
+		alignas(32) uint32_t tmp[LANES];
+		for(int j = 0; j < LANES; ++j) {
+			::memcpy(&tmp[j], key + j * 64 + i * 4, 4);
+		}
+		state[i] = _mm256_load_si256((const __m256i*)tmp);
+	}
+	for(int i = 0; i < 16; ++i) {
+		state[16 + i] = _mm256_set1_epi32(MEM_HASH_INIT[i]);
+	}
+
+	__m256i b = _mm256_setzero_si256();
+	__m256i c = _mm256_setzero_si256();
+
+	for(uint32_t i = 0; i < mem_size; i += 32)
+	{
+		for(int j = 0; j < 4; ++j) {
+			for(int k = 0; k < 16; ++k) {
+				MMXPOS_HASHROUND_AVX2(state[k], b, c, state[16 + k]);
+			}
+		}
+		for(int k = 0; k < 32; ++k) {
+			_mm256_storeu_si256((__m256i*)(mem + (i + k) * LANES), state[k]);
+		}
+	}
+}
+
+void calc_mem_hash_avx2_x8(uint32_t* mem, uint8_t* hash, const int num_iter)
+{
+	static constexpr int N = 32;
+
+	const __m256i lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i bit_mask = _mm256_set1_epi32(31);
+	const __m256i num_bits = _mm256_set1_epi32(32);
+
+	__m256i state[N];
+	for(int i = 0; i < N; ++i) {
+		state[i] = _mm256_loadu_si256((const __m256i*)(mem + ((N - 1) * N + i) * LANES));
+	}
+
+	for(int iter = 0; iter < num_iter; ++iter)
+	{
+		__m256i sum = state[0];
+		for(int i = 1; i < N; ++i) {
+			sum = ADD(sum, ROTL(state[i], i));
+		}
+		const __m256i dir = ADD(ADD(sum, _mm256_slli_epi32(sum, 11)), _mm256_slli_epi32(sum, 22));
+
+		const __m256i bits = _mm256_and_si256(_mm256_srli_epi32(dir, 22), bit_mask);
+		const __m256i bits_inv = _mm256_sub_epi32(num_bits, bits);
+		const __m256i offset = _mm256_srli_epi32(dir, 27);
+
+		// index of mem[offset * N] for each lane
+		const __m256i base = ADD(_mm256_mullo_epi32(offset, _mm256_set1_epi32(N * LANES)), lane_index);
+
+		for(int i = 0; i < N; ++i) {
+			const auto index = ADD(base, _mm256_set1_epi32(((iter + i) % N) * LANES));
+			const auto value = _mm256_i32gather_epi32((const int*)mem, index, 4);
+			const auto rot = _mm256_or_si256(_mm256_sllv_epi32(value, bits), _mm256_srlv_epi32(value, bits_inv));
+			state[i] = ADD(state[i], XOR(rot, sum));
+		}
+
+		// no scatter in AVX2
+		alignas(32) uint32_t base_tmp[LANES];
+		_mm256_store_si256((__m256i*)base_tmp, base);
+
+		for(int i = 0; i < N; ++i) {
+			alignas(32) uint32_t tmp[LANES];
+			_mm256_store_si256((__m256i*)tmp, state[i]);
+			for(int j = 0; j < LANES; ++j) {
+				mem[base_tmp[j] + i * LANES] ^= tmp[j];
+			}
+		}
+	}
+
+	for(int i = 0; i < N; ++i) {
+		alignas(32) uint32_t tmp[LANES];
+		_mm256_store_si256((__m256i*)tmp, state[i]);
+		for(int j = 0; j < LANES; ++j) {
+			::memcpy(hash + j * N * 4 + i * 4, &tmp[j], 4);
+		}
+	}
+}
+
+
+} // pos
+} // mmx
+
+#else
+
+namespace mmx {
+namespace pos {
+
+void gen_mem_array_avx2_x8(uint32_t* mem, const uint8_t* key, const uint32_t mem_size) {
+	throw std::logic_error("gen_mem_array_avx2_x8() not available");
+}
+
+void calc_mem_hash_avx2_x8(uint32_t* mem, uint8_t* hash, const int num_iter) {
+	throw std::logic_error("calc_mem_hash_avx2_x8() not available");
+}
+
+} // pos
+} // mmx
+
+#endif // __AVX2__
@@ -0,0 +1,138 @@
+#include <mmx/pos/mem_hash.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(_WIN32)
+
+#include <immintrin.h>
+
+
+namespace mmx {
+namespace pos {
+
+static constexpr int LANES = 16;
+
+static const uint32_t MEM_HASH_INIT[16] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174
+};
+
+#define ADD _mm512_add_epi32
+#define XOR _mm512_xor_si512
+#define ROTL(x, n) _mm512_rolv_epi32(x, _mm512_set1_epi32(n))
+
+#define MMXPOS_HASHROUND_AVX512(a, b, c, d) \
+	a = ADD(a, b);              \
+	d = ROTL(XOR(d, a), 16);    \
+	c = ADD(c, d);              \
+	b = ROTL(XOR(b, c), 12);    \
+	a = ADD(a, b);              \
+	d = ROTL(XOR(d, a), 8);     \
+	c = ADD(c, d);              \
+	b = ROTL(XOR(b, c), 7);
+
+void gen_mem_array_avx512_x16(uint32_t* mem, const uint8_t* key, const uint32_t mem_size)
+{
+	if(mem_size % 32) {
+		throw std::logic_error("mem_size % 32 != 0");
+	}
+	__m512i state[32];
+
+	for(int i = 0; i < 16; ++i) {
+		alignas(64) uint32_t tmp[LANES];
+		for(int j = 0; j < LANES; ++j) {
+			::memcpy(&tmp[j], key + j * 64 + i * 4, 4);
+		}
+		state[i] = _mm512_load_si512((const __m512i*)tmp);
+	}
+	for(int i = 0; i < 16; ++i) {
+		state[16 + i] = _mm512_set1_epi32(MEM_HASH_INIT[i]);
+	}
+
+	__m512i b = _mm512_setzero_si512();
+	__m512i c = _mm512_setzero_si512();
+
+	for(uint32_t i = 0; i < mem_size; i += 32)
+	{
+		for(int j = 0; j < 4; ++j) {
+			for(int k = 0; k < 16; ++k) {
+				MMXPOS_HASHROUND_AVX512(state[k], b, c, state[16 + k]);
+			}
+		}
+		for(int k = 0; k < 32; ++k) {
+			_mm512_storeu_si512((__m512i*)(mem + (i + k) * LANES), state[k]);
+		}
+	}
+}
+
+void calc_mem_hash_avx512_x16(uint32_t* mem, uint8_t* hash, const int num_iter)
+{
+	static constexpr int N = 32;
+
+	const __m512i lane_index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m512i bit_mask = _mm512_set1_epi32(31);
+
+	__m512i state[N];
+	for(int i = 0; i < N; ++i) {
+		state[i] = _mm512_loadu_si512((const __m512i*)(mem + ((N - 1) * N + i) * LANES));
+	}
+
+	for(int iter = 0; iter < num_iter; ++iter)
+	{
+		__m512i sum = state[0];
+		for(int i = 1; i < N; ++i) {
+			sum = ADD(sum, ROTL(state[i], i));
+		}
+		const __m512i dir = ADD(ADD(sum, _mm512_slli_epi32(sum, 11)), _mm512_slli_epi32(sum, 22));
+
+		const __m512i bits = _mm512_and_si512(_mm512_srli_epi32(dir, 22), bit_mask);
+		const __m512i offset = _mm512_srli_epi32(dir, 27);
+
+		// index of mem[offset * N] for each lane
+		const __m512i base = ADD(_mm512_mullo_epi32(offset, _mm512_set1_epi32(N * LANES)), lane_index);
+
+		for(int i = 0; i < N; ++i) {
+			const auto index = ADD(base, _mm512_set1_epi32(((iter + i) % N) * LANES));
+			const auto value = _mm512_i32gather_epi32(index, mem, 4);
+			const auto rot = _mm512_rolv_epi32(value, bits);
+			state[i] = ADD(state[i], XOR(rot, sum));
+		}
+
+		for(int i = 0; i < N; ++i) {
+			const auto index = ADD(base, _mm512_set1_epi32(i * LANES));
+			const auto value = _mm512_i32gather_epi32(index, mem, 4);
+			_mm512_i32scatter_epi32(mem, index, XOR(value, state[i]), 4);
+		}
+	}
+
+	for(int i = 0; i < N; ++i) {
+		alignas(64) uint32_t tmp[LANES];
+		_mm512_store_si512((__m512i*)tmp, state[i]);
+		for(int j = 0; j < LANES; ++j) {
+			::memcpy(hash + j * N * 4 + i * 4, &tmp[j], 4);
+		}
+	}
+}
+
+
+} // pos
+} // mmx
+
+#else
+
+namespace mmx {
+namespace pos {
+
+void gen_mem_array_avx512_x16(uint32_t* mem, const uint8_t* key, const uint32_t mem_size) {
+	throw std::logic_error("gen_mem_array_avx512_x16() not available");
+}
+
+void calc_mem_hash_avx512_x16(uint32_t* mem, uint8_t* hash, const int num_iter) {
+	throw std::logic_error("calc_mem_hash_avx512_x16() not available");
+}
+
+} // pos
+} // mmx
+
+#endif // __AVX512F__
@@ -44,49 +44,82 @@ void compute_f1(std::vector<uint32_t>* X_out,
 				std::vector<uint32_t>& Y_out,
 				std::vector<std::array<uint32_t, N_META>>& M_out,
 				std::mutex& mutex,
-				const uint32_t X,
-				const hash_t& id, const int ksize, const int xbits)
+				const std::vector<uint32_t>& X_in,
+				const hash_t& id, const int ksize)
 {
+	static const int num_lanes = get_mem_hash_lanes();
+
 	const uint32_t kmask = ((uint64_t(1) << ksize) - 1);
 
-	std::vector<uint32_t> mem_buf(MEM_SIZE);
+	std::vector<uint32_t> mem_buf(MEM_SIZE * num_lanes);
+	std::vector<uint8_t> key_buf(64 * num_lanes);
+	std::vector<uint8_t> hash_buf(128 * num_lanes);
 
-	for(uint32_t x_i = 0; x_i < (uint64_t(1) << xbits); ++x_i)
+	// local output, merged at the end
+	std::vector<uint32_t> Y_tmp;
+	std::vector<std::array<uint32_t, N_META>> M_tmp;
+	Y_tmp.reserve(X_in.size());
+	M_tmp.reserve(X_in.size());
+
+	for(size_t offset = 0; offset < X_in.size(); offset += num_lanes)
 	{
-		const uint32_t X_i = (X << xbits) | x_i;
+		const auto count = std::min<size_t>(X_in.size() - offset, num_lanes);
 
-		uint32_t msg[9] = {};
-		msg[0] = X_i;
-		::memcpy(msg + 1, id.data(), id.size());
+		for(size_t k = 0; k < count; ++k)
+		{
+			uint32_t msg[9] = {};
+			msg[0] = X_in[offset + k];
+			::memcpy(msg + 1, id.data(), id.size());
 
-		const hash_512_t key(&msg, sizeof(msg));
-		gen_mem_array(mem_buf.data(), key.data(), MEM_SIZE);
+			const hash_512_t key(&msg, sizeof(msg));
+			::memcpy(key_buf.data() + k * 64, key.data(), key.size());
+		}
 
-		uint8_t mem_hash[64 + 128] = {};
-		::memcpy(mem_hash, key.data(), key.size());
+		// unused lanes are computed anyway
+		switch(num_lanes) {
+			case 16:
+				gen_mem_array_avx512_x16(mem_buf.data(), key_buf.data(), MEM_SIZE);
+				calc_mem_hash_avx512_x16(mem_buf.data(), hash_buf.data(), MEM_HASH_ITER);
+				break;
+			case 8:
+				gen_mem_array_avx2_x8(mem_buf.data(), key_buf.data(), MEM_SIZE);
+				calc_mem_hash_avx2_x8(mem_buf.data(), hash_buf.data(), MEM_HASH_ITER);
+				break;
+			default:
+				gen_mem_array(mem_buf.data(), key_buf.data(), MEM_SIZE);
+				calc_mem_hash(mem_buf.data(), hash_buf.data(), MEM_HASH_ITER);
+		}
 
-		calc_mem_hash(mem_buf.data(), mem_hash + 64, MEM_HASH_ITER);
+		for(size_t k = 0; k < count; ++k)
+		{
+			uint8_t mem_hash[64 + 128] = {};
+			::memcpy(mem_hash, key_buf.data() + k * 64, 64);
+			::memcpy(mem_hash + 64, hash_buf.data() + k * 128, 128);
 
-		const hash_512_t mem_hash_hash(mem_hash, sizeof(mem_hash));
+			const hash_512_t mem_hash_hash(mem_hash, sizeof(mem_hash));
 
-		uint32_t hash[16] = {};
-		::memcpy(hash, mem_hash_hash.data(), mem_hash_hash.size());
+			uint32_t hash[16] = {};
+			::memcpy(hash, mem_hash_hash.data(), mem_hash_hash.size());
 
-		uint32_t Y_i = 0;
-		std::array<uint32_t, N_META> meta = {};
-		for(int i = 0; i < N_META; ++i) {
-			Y_i = Y_i ^ hash[i];
-			meta[i] = hash[i] & kmask;
-		}
-		Y_i &= kmask;
+			uint32_t Y_i = 0;
+			std::array<uint32_t, N_META> meta = {};
+			for(int i = 0; i < N_META; ++i) {
+				Y_i = Y_i ^ hash[i];
+				meta[i] = hash[i] & kmask;
+			}
+			Y_i &= kmask;
 
-		std::lock_guard<std::mutex> lock(mutex);
-		if(X_out) {
-			X_out->push_back(X_i);
+			Y_tmp.push_back(Y_i);
+			M_tmp.push_back(meta);
 		}
-		Y_out.push_back(Y_i);
-		M_out.push_back(meta);
 	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(X_out) {
+		X_out->insert(X_out->end(), X_in.begin(), X_in.end());
+	}
+	Y_out.insert(Y_out.end(), Y_tmp.begin(), Y_tmp.end());
+	M_out.insert(M_out.end(), M_tmp.begin(), M_tmp.end());
 }
 
 std::vector<std::pair<uint32_t, bytes_t<META_BYTES_OUT>>>
@@ -166,7 +199,6 @@ compute(const std::vector<uint32_t>& X_values, std::vector<uint32_t>* X_out, con
 	std::vector<int64_t> jobs;
 	std::vector<uint32_t> X_tmp;
 	std::vector<uint32_t> Y_tmp;
-	std::vector<uint32_t> mem_buf(MEM_SIZE);
 	std::vector<std::array<uint32_t, N_META>> M_tmp;
 
 //	const auto t1_begin = get_time_ms();
@@ -177,17 +209,30 @@ compute(const std::vector<uint32_t>& X_values, std::vector<uint32_t>* X_out, con
 	Y_tmp.reserve(num_entries_1);
 	M_tmp.reserve(num_entries_1);
 
-	for(const auto X : X_set)
-	{
-		if(use_threads) {
+	if(use_threads) {
+		for(const auto X : X_set)
+		{
+			std::vector<uint32_t> X_in;
+			X_in.reserve(uint64_t(1) << xbits);
+			for(uint32_t x_i = 0; x_i < (uint64_t(1) << xbits); ++x_i) {
+				X_in.push_back((X << xbits) | x_i);
+			}
 			const auto job = g_threads->add_task(
-				[X_out, &X_tmp, &Y_tmp, &M_tmp, &mutex, X, id, ksize, xbits]() {
-					compute_f1(X_out ? &X_tmp : nullptr, Y_tmp, M_tmp, mutex, X, id, ksize, xbits);
+				[X_out, &X_tmp, &Y_tmp, &M_tmp, &mutex, X_in, id, ksize]() {
+					compute_f1(X_out ? &X_tmp : nullptr, Y_tmp, M_tmp, mutex, X_in, id, ksize);
 				});
 			jobs.push_back(job);
-		} else {
-			compute_f1(X_out ? &X_tmp : nullptr, Y_tmp, M_tmp, mutex, X, id, ksize, xbits);
 		}
+	} else {
+		// all at once to fill the SIMD lanes (xbits is usually zero here)
+		std::vector<uint32_t> X_in;
+		X_in.reserve(num_entries_1);
+		for(const auto X : X_set) {
+			for(uint32_t x_i = 0; x_i < (uint64_t(1) << xbits); ++x_i) {
+				X_in.push_back((X << xbits) | x_i);
+			}
+		}
+		compute_f1(X_out ? &X_tmp : nullptr, Y_tmp, M_tmp, mutex, X_in, id, ksize);
 	}
 
 	if(use_threads) {
@@ -39,3 +39,30 @@ void sha256_64_x8(uint8_t* out, uint8_t* in, const uint64_t length)
 	}
 }
 
+
+void sha256_64b_batch(uint8_t* out, const uint8_t* in, const uint64_t count)
+{
+	static bool have_avx2 = avx2_available();
+	static bool have_sha_ni = sha256_ni_available();
+	static bool have_sha_arm = sha256_arm_available();
+
+	// Note: processing in ascending order, so out <= in is safe
+	uint64_t i = 0;
+	if(have_sha_ni) {
+		for(; i < count; ++i) {
+			sha256_ni(out + i * 32, in + i * 64, 64);
+		}
+	} else if(have_sha_arm) {
+		for(; i < count; ++i) {
+			sha256_arm(out + i * 32, in + i * 64, 64);
+		}
+	} else if(have_avx2) {
+		for(; i + 8 <= count; i += 8) {
+			sha256_avx2_64b_x8(out + i * 32, in + i * 64);
+		}
+	}
+	for(; i < count; ++i) {
+		const mmx::hash_t hash(in + i * 64, 64);
+		::memcpy(out + i * 32, hash.data(), 32);
+	}
+}
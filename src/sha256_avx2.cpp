@@ -315,6 +315,156 @@ void sha256_avx2_64_x8(uint8_t* out, uint8_t* in, const uint64_t length)
 	}
 }
 
+#define SHA256ROUNDS8_AVX(i) \
+	SHA256ROUND_AVX(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], i + 0, w[i + 0]); \
+	SHA256ROUND_AVX(s[7], s[0], s[1], s[2], s[3], s[4], s[5], s[6], i + 1, w[i + 1]); \
+	SHA256ROUND_AVX(s[6], s[7], s[0], s[1], s[2], s[3], s[4], s[5], i + 2, w[i + 2]); \
+	SHA256ROUND_AVX(s[5], s[6], s[7], s[0], s[1], s[2], s[3], s[4], i + 3, w[i + 3]); \
+	SHA256ROUND_AVX(s[4], s[5], s[6], s[7], s[0], s[1], s[2], s[3], i + 4, w[i + 4]); \
+	SHA256ROUND_AVX(s[3], s[4], s[5], s[6], s[7], s[0], s[1], s[2], i + 5, w[i + 5]); \
+	SHA256ROUND_AVX(s[2], s[3], s[4], s[5], s[6], s[7], s[0], s[1], i + 6, w[i + 6]); \
+	SHA256ROUND_AVX(s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[0], i + 7, w[i + 7]);
+
+void recursive_sha256_avx2_x8(uint8_t* hash, const uint64_t num_iters)
+{
+	if(num_iters <= 0) {
+		return;
+	}
+	static const u32 H0[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	u256 h[8], s[8], w[64], T0, T1;
+
+	// state is kept transposed (one word of all lanes per vector) across iterations
+	for(int k = 0; k < 8; ++k) {
+		alignas(32) u32 tmp[8];
+		for(int j = 0; j < 8; ++j) {
+			u32 word;
+			::memcpy(&word, hash + j * 32 + k * 4, 4);
+			tmp[j] = bswap_32(word);
+		}
+		h[k] = _mm256_load_si256((const __m256i*)tmp);
+	}
+	// padding for 32 byte message
+	const u256 PAD0 = _mm256_set1_epi32(0x80000000);
+	const u256 PAD15 = _mm256_set1_epi32(256);
+	const u256 ZERO = _mm256_setzero_si256();
+
+	for(uint64_t iter = 0; iter < num_iters; ++iter)
+	{
+		for(int k = 0; k < 8; ++k) {
+			w[k] = h[k];
+			s[k] = _mm256_set1_epi32(H0[k]);
+		}
+		w[8] = PAD0;
+		for(int k = 9; k < 15; ++k) {
+			w[k] = ZERO;
+		}
+		w[15] = PAD15;
+
+		for(int k = 16; k < 64; ++k) {
+			w[k] = ADD4_32(WSIGMA1_AVX(w[k - 2]), w[k - 16], w[k - 7], WSIGMA0_AVX(w[k - 15]));
+		}
+		SHA256ROUNDS8_AVX(0);
+		SHA256ROUNDS8_AVX(8);
+		SHA256ROUNDS8_AVX(16);
+		SHA256ROUNDS8_AVX(24);
+		SHA256ROUNDS8_AVX(32);
+		SHA256ROUNDS8_AVX(40);
+		SHA256ROUNDS8_AVX(48);
+		SHA256ROUNDS8_AVX(56);
+
+		for(int k = 0; k < 8; ++k) {
+			h[k] = ADD32(s[k], _mm256_set1_epi32(H0[k]));
+		}
+	}
+	for(int k = 0; k < 8; ++k) {
+		alignas(32) u32 tmp[8];
+		_mm256_store_si256((__m256i*)tmp, h[k]);
+		for(int j = 0; j < 8; ++j) {
+			const u32 word = bswap_32(tmp[j]);
+			::memcpy(hash + j * 32 + k * 4, &word, 4);
+		}
+	}
+}
+
+void sha256_avx2_64b_x8(uint8_t* out, const uint8_t* in)
+{
+	static const u32 H0[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	// message schedule of the padding block (64 byte message)
+	static const struct pad_schedule_t {
+		u32 w[64];
+		pad_schedule_t() {
+			for(int k = 0; k < 16; ++k) {
+				w[k] = 0;
+			}
+			w[0] = 0x80000000;
+			w[15] = 512;
+			for(int k = 16; k < 64; ++k) {
+				const auto s0 = ((w[k - 15] >> 7) | (w[k - 15] << 25)) ^ ((w[k - 15] >> 18) | (w[k - 15] << 14)) ^ (w[k - 15] >> 3);
+				const auto s1 = ((w[k - 2] >> 17) | (w[k - 2] << 15)) ^ ((w[k - 2] >> 19) | (w[k - 2] << 13)) ^ (w[k - 2] >> 10);
+				w[k] = w[k - 16] + s0 + w[k - 7] + s1;
+			}
+		}
+	} PAD;
+
+	u256 h[8], s[8], w[64], T0, T1;
+
+	for(int k = 0; k < 8; ++k) {
+		alignas(32) u32 tmp[2][8];
+		for(int j = 0; j < 8; ++j) {
+			u32 word[2];
+			::memcpy(&word[0], in + j * 64 + k * 4, 4);
+			::memcpy(&word[1], in + j * 64 + 32 + k * 4, 4);
+			tmp[0][j] = bswap_32(word[0]);
+			tmp[1][j] = bswap_32(word[1]);
+		}
+		w[k] = _mm256_load_si256((const __m256i*)tmp[0]);
+		w[k + 8] = _mm256_load_si256((const __m256i*)tmp[1]);
+	}
+	for(int k = 16; k < 64; ++k) {
+		w[k] = ADD4_32(WSIGMA1_AVX(w[k - 2]), w[k - 16], w[k - 7], WSIGMA0_AVX(w[k - 15]));
+	}
+	for(int k = 0; k < 8; ++k) {
+		s[k] = _mm256_set1_epi32(H0[k]);
+	}
+	SHA256ROUNDS8_AVX(0);
+	SHA256ROUNDS8_AVX(8);
+	SHA256ROUNDS8_AVX(16);
+	SHA256ROUNDS8_AVX(24);
+	SHA256ROUNDS8_AVX(32);
+	SHA256ROUNDS8_AVX(40);
+	SHA256ROUNDS8_AVX(48);
+	SHA256ROUNDS8_AVX(56);
+
+	for(int k = 0; k < 8; ++k) {
+		h[k] = ADD32(s[k], _mm256_set1_epi32(H0[k]));
+		s[k] = h[k];
+	}
+	for(int k = 0; k < 64; ++k) {
+		w[k] = _mm256_set1_epi32(PAD.w[k]);
+	}
+	SHA256ROUNDS8_AVX(0);
+	SHA256ROUNDS8_AVX(8);
+	SHA256ROUNDS8_AVX(16);
+	SHA256ROUNDS8_AVX(24);
+	SHA256ROUNDS8_AVX(32);
+	SHA256ROUNDS8_AVX(40);
+	SHA256ROUNDS8_AVX(48);
+	SHA256ROUNDS8_AVX(56);
+
+	for(int k = 0; k < 8; ++k) {
+		alignas(32) u32 tmp[8];
+		_mm256_store_si256((__m256i*)tmp, ADD32(s[k], h[k]));
+		for(int j = 0; j < 8; ++j) {
+			const u32 word = bswap_32(tmp[j]);
+			::memcpy(out + j * 32 + k * 4, &word, 4);
+		}
+	}
+}
+
 bool avx2_available()
 {
 	bool HW_AVX2 = false;
@@ -345,6 +495,14 @@ void sha256_avx2_64_x8(uint8_t* out, uint8_t* in, const uint64_t length) {
 	throw std::logic_error("sha256_avx2() not available");
 }
 
+void recursive_sha256_avx2_x8(uint8_t* hash, const uint64_t num_iters) {
+	throw std::logic_error("recursive_sha256_avx2_x8() not available");
+}
+
+void sha256_avx2_64b_x8(uint8_t* out, const uint8_t* in) {
+	throw std::logic_error("sha256_avx2_64b_x8() not available");
+}
+
 bool avx2_available() {
 	return false;
 }
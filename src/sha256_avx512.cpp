@@ -0,0 +1,191 @@
+// prerequisite: length is 32 bytes (recursive sha256)
+
+#include <sha256_avx512.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(_WIN32)
+
+#include <immintrin.h>
+
+#ifdef _WIN32
+#include <intrin.h>
+#define cpuid(info, x)    __cpuidex(info, x, 0)
+#else
+#include <cpuid.h>
+inline void cpuid(int info[4], int InfoType) {
+	__cpuid_count(InfoType, 0, info[0], info[1], info[2], info[3]);
+}
+#endif
+
+static uint64_t xgetbv() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax = 0, edx = 0;
+  __asm__ __volatile__("xgetbv\n" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+#define u32 uint32_t
+#define u512 __m512i
+
+static const u32 RC[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ADD32 _mm512_add_epi32
+// masked forms with a zero source, the plain ones pass _mm512_undefined_epi32() which GCC 12 reports as -Wmaybe-uninitialized
+#define ROTR32(x, y) _mm512_mask_ror_epi32(_mm512_setzero_si512(), 0xFFFF, x, y)
+#define SHIFTR32(x, y) _mm512_mask_srli_epi32(_mm512_setzero_si512(), 0xFFFF, x, y)
+
+// ternary logic: 0x96 = a ^ b ^ c, 0xE8 = majority, 0xCA = a ? b : c
+#define XOR3(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0x96)
+#define MAJ_AVX(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0xE8)
+#define CH_AVX(a, b, c) _mm512_ternarylogic_epi32(a, b, c, 0xCA)
+
+#define ADD4_32(a, b, c, d) ADD32(ADD32(a, b), ADD32(c, d))
+#define ADD5_32(a, b, c, d, e) ADD32(ADD32(ADD32(a, b), ADD32(c, d)), e)
+
+#define SIGMA1_AVX(x) XOR3(ROTR32(x, 6), ROTR32(x, 11), ROTR32(x, 25))
+#define SIGMA0_AVX(x) XOR3(ROTR32(x, 2), ROTR32(x, 13), ROTR32(x, 22))
+
+#define WSIGMA1_AVX(x) XOR3(ROTR32(x, 17), ROTR32(x, 19), SHIFTR32(x, 10))
+#define WSIGMA0_AVX(x) XOR3(ROTR32(x, 7), ROTR32(x, 18), SHIFTR32(x, 3))
+
+#define SHA256ROUND_AVX(a, b, c, d, e, f, g, h, rc, w) \
+    T0 = ADD5_32(h, SIGMA1_AVX(e), CH_AVX(e, f, g), _mm512_set1_epi32(RC[rc]), w); \
+    d = ADD32(d, T0); \
+    T1 = ADD32(SIGMA0_AVX(a), MAJ_AVX(a, b, c)); \
+    h = ADD32(T0, T1);
+
+#define SHA256ROUNDS8_AVX(i) \
+	SHA256ROUND_AVX(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], i + 0, w[i + 0]); \
+	SHA256ROUND_AVX(s[7], s[0], s[1], s[2], s[3], s[4], s[5], s[6], i + 1, w[i + 1]); \
+	SHA256ROUND_AVX(s[6], s[7], s[0], s[1], s[2], s[3], s[4], s[5], i + 2, w[i + 2]); \
+	SHA256ROUND_AVX(s[5], s[6], s[7], s[0], s[1], s[2], s[3], s[4], i + 3, w[i + 3]); \
+	SHA256ROUND_AVX(s[4], s[5], s[6], s[7], s[0], s[1], s[2], s[3], i + 4, w[i + 4]); \
+	SHA256ROUND_AVX(s[3], s[4], s[5], s[6], s[7], s[0], s[1], s[2], i + 5, w[i + 5]); \
+	SHA256ROUND_AVX(s[2], s[3], s[4], s[5], s[6], s[7], s[0], s[1], i + 6, w[i + 6]); \
+	SHA256ROUND_AVX(s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[0], i + 7, w[i + 7]);
+
+
+inline uint32_t bswap_32(const uint32_t val) {
+	return ((val & 0xFF) << 24) | ((val & 0xFF00) << 8) | ((val & 0xFF0000) >> 8) | ((val & 0xFF000000) >> 24);
+}
+
+void recursive_sha256_avx512_x16(uint8_t* hash, const uint64_t num_iters)
+{
+	if(num_iters <= 0) {
+		return;
+	}
+	static const u32 H0[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	u512 h[8], s[8], w[64];
+	u512 T0 = _mm512_setzero_si512();
+	u512 T1 = _mm512_setzero_si512();
+
+	// state is kept transposed (one word of all lanes per vector) across iterations
+	for(int k = 0; k < 8; ++k) {
+		alignas(64) u32 tmp[16];
+		for(int j = 0; j < 16; ++j) {
+			u32 word;
+			::memcpy(&word, hash + j * 32 + k * 4, 4);
+			tmp[j] = bswap_32(word);
+		}
+		h[k] = _mm512_load_si512(tmp);
+	}
+	// padding for 32 byte message
+	const u512 PAD0 = _mm512_set1_epi32(0x80000000);
+	const u512 PAD15 = _mm512_set1_epi32(256);
+	const u512 ZERO = _mm512_setzero_si512();
+
+	for(uint64_t iter = 0; iter < num_iters; ++iter)
+	{
+		for(int k = 0; k < 8; ++k) {
+			w[k] = h[k];
+			s[k] = _mm512_set1_epi32(H0[k]);
+		}
+		w[8] = PAD0;
+		for(int k = 9; k < 15; ++k) {
+			w[k] = ZERO;
+		}
+		w[15] = PAD15;
+
+		for(int k = 16; k < 64; ++k) {
+			w[k] = ADD4_32(WSIGMA1_AVX(w[k - 2]), w[k - 16], w[k - 7], WSIGMA0_AVX(w[k - 15]));
+		}
+		SHA256ROUNDS8_AVX(0);
+		SHA256ROUNDS8_AVX(8);
+		SHA256ROUNDS8_AVX(16);
+		SHA256ROUNDS8_AVX(24);
+		SHA256ROUNDS8_AVX(32);
+		SHA256ROUNDS8_AVX(40);
+		SHA256ROUNDS8_AVX(48);
+		SHA256ROUNDS8_AVX(56);
+
+		for(int k = 0; k < 8; ++k) {
+			h[k] = ADD32(s[k], _mm512_set1_epi32(H0[k]));
+		}
+	}
+	for(int k = 0; k < 8; ++k) {
+		alignas(64) u32 tmp[16];
+		_mm512_store_si512(tmp, h[k]);
+		for(int j = 0; j < 16; ++j) {
+			const u32 word = bswap_32(tmp[j]);
+			::memcpy(hash + j * 32 + k * 4, &word, 4);
+		}
+	}
+}
+
+bool avx512_available()
+{
+	bool HW_AVX512 = false;
+
+	int info[4];
+	cpuid(info, 0);
+	const int nIds = info[0];
+
+	cpuid(info, 1);
+
+	if(info[2] & (1UL << 27)) { // OSXSAVE
+		const uint64_t mask = xgetbv();
+		if((mask & 0xE6) == 0xE6) { // SSE, AVX and AVX-512 states
+			if(nIds >= 7) {
+				cpuid(info, 7);
+				HW_AVX512 = (info[1] & ((int)1 << 16)) != 0;	// AVX512F
+			}
+		}
+	}
+	return HW_AVX512;
+}
+
+#else
+
+void recursive_sha256_avx512_x16(uint8_t* hash, const uint64_t num_iters) {
+	throw std::logic_error("recursive_sha256_avx512_x16() not available");
+}
+
+bool avx512_available() {
+	return false;
+}
+
+#endif // __AVX512F__
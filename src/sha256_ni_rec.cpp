@@ -7,6 +7,7 @@
 
 // prerequisite: length is 32 bytes (recursive sha256)
 // prerequisite: length is 64 bytes, 2x 32bytes (_x2)
+// prerequisite: length is 128 bytes, 4x 32bytes (_x4)
 // optimization: https://github.com/voidxno/fast-recursive-sha256
 
 #include <sha256_ni.h>
@@ -428,6 +429,213 @@ msg_p2, msgtmp0_p2, msgtmp1_p2, msgtmp2_p2, msgtmp3_p2, state0_p2, state1_p2, kv
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(&hash[48]),HASH1_SAVE_P2);
 }
 
+void recursive_sha256_ni_x4(uint8_t* hash, const uint64_t num_iters)
+{
+	if(num_iters <= 0) {
+		return;
+	}
+
+	alignas(64)
+	static const uint32_t K64[64] = {
+		0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+		0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+		0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+		0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+		0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+		0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+		0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+		0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+		0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+		0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+		0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+		0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+		0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+		0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+		0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+		0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+	};
+
+	// shuffle mask
+	const __m128i SHUF_MASK = _mm_set_epi64x(0x0c0d0e0f08090a0b,0x0405060700010203);
+
+	// init values
+	const __m128i ABEF_INIT = _mm_set_epi64x(0x6a09e667bb67ae85,0x510e527f9b05688c);
+	const __m128i CDGH_INIT = _mm_set_epi64x(0x3c6ef372a54ff53a,0x1f83d9ab5be0cd19);
+
+	// pre-calc/cache padding
+	const __m128i HPAD0_CACHE = _mm_set_epi64x(0x0000000000000000,0x0000000080000000);
+	const __m128i HPAD1_CACHE = _mm_set_epi64x(0x0000010000000000,0x0000000000000000);
+
+	// same as x2 with four interleaved lanes, loops over P are fully unrolled by the compiler
+	constexpr int N = 4;
+
+	__m128i STATE0[N];
+	__m128i STATE1[N];
+	__m128i MSG[N];
+	__m128i MSGTMP0[N];
+	__m128i MSGTMP1[N];
+	__m128i MSGTMP2[N];
+	__m128i MSGTMP3[N];
+	__m128i HASH0_SAVE[N];
+	__m128i HASH1_SAVE[N];
+
+	// init/shuffle hash
+	for(int P = 0; P < N; ++P) {
+		HASH0_SAVE[P] = _mm_loadu_si128(reinterpret_cast<__m128i*>(&hash[P * 32]));
+		HASH1_SAVE[P] = _mm_loadu_si128(reinterpret_cast<__m128i*>(&hash[P * 32 + 16]));
+		HASH0_SAVE[P] = _mm_shuffle_epi8(HASH0_SAVE[P],SHUF_MASK);
+		HASH1_SAVE[P] = _mm_shuffle_epi8(HASH1_SAVE[P],SHUF_MASK);
+	}
+
+#define SHA256ROUND_X4(msgtmp0, msgtmp1, msgtmp2, msgtmp3, kvalue) \
+	for(int P = 0; P < N; ++P) { \
+		MSG[P] = msgtmp0[P]; \
+		MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(kvalue))); \
+		STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]); \
+	} \
+	for(int P = 0; P < N; ++P) { \
+		msgtmp1[P] = _mm_add_epi32(msgtmp1[P],_mm_alignr_epi8(msgtmp0[P],msgtmp3[P],4)); \
+		msgtmp1[P] = _mm_sha256msg2_epu32(msgtmp1[P],msgtmp0[P]); \
+		MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E); \
+		STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]); \
+	} \
+	for(int P = 0; P < N; ++P) { \
+		msgtmp3[P] = _mm_sha256msg1_epu32(msgtmp3[P],msgtmp0[P]); \
+	}
+
+	for(uint64_t i = 0; i < num_iters; ++i) {
+
+		for(int P = 0; P < N; ++P) {
+			// init state
+			STATE0[P] = ABEF_INIT;
+			STATE1[P] = CDGH_INIT;
+
+			// rounds 0-3
+			MSG[P] = HASH0_SAVE[P];
+			MSGTMP0[P] = MSG[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[0])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+		}
+
+		// rounds 4-7
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = HASH1_SAVE[P];
+			MSGTMP1[P] = MSG[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[4])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+			MSGTMP0[P] = _mm_sha256msg1_epu32(MSGTMP0[P],MSGTMP1[P]);
+		}
+
+		// rounds 8-11
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = HPAD0_CACHE;
+			MSGTMP2[P] = MSG[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[8])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+			MSGTMP1[P] = _mm_sha256msg1_epu32(MSGTMP1[P],MSGTMP2[P]);
+		}
+
+		// rounds 12-15
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = HPAD1_CACHE;
+			MSGTMP3[P] = MSG[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[12])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSGTMP0[P] = _mm_add_epi32(MSGTMP0[P],_mm_alignr_epi8(MSGTMP3[P],MSGTMP2[P],4));
+			MSGTMP0[P] = _mm_sha256msg2_epu32(MSGTMP0[P],MSGTMP3[P]);
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+			MSGTMP2[P] = _mm_sha256msg1_epu32(MSGTMP2[P],MSGTMP3[P]);
+		}
+
+		//-- rounds 16-19, 20-23, 24-27, 28-31
+		SHA256ROUND_X4(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,&K64[16]);
+		SHA256ROUND_X4(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,&K64[20]);
+		SHA256ROUND_X4(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,&K64[24]);
+		SHA256ROUND_X4(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,&K64[28]);
+
+		//-- rounds 32-35, 36-39, 40-43, 44-47
+		SHA256ROUND_X4(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,&K64[32]);
+		SHA256ROUND_X4(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,&K64[36]);
+		SHA256ROUND_X4(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,&K64[40]);
+		SHA256ROUND_X4(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,&K64[44]);
+
+		//-- rounds 48-51
+		SHA256ROUND_X4(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,&K64[48]);
+
+		// rounds 52-55
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = MSGTMP1[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[52])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSGTMP2[P] = _mm_add_epi32(MSGTMP2[P],_mm_alignr_epi8(MSGTMP1[P],MSGTMP0[P],4));
+			MSGTMP2[P] = _mm_sha256msg2_epu32(MSGTMP2[P],MSGTMP1[P]);
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+		}
+
+		// rounds 56-59
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = MSGTMP2[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[56])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSGTMP3[P] = _mm_add_epi32(MSGTMP3[P],_mm_alignr_epi8(MSGTMP2[P],MSGTMP1[P],4));
+			MSGTMP3[P] = _mm_sha256msg2_epu32(MSGTMP3[P],MSGTMP2[P]);
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+		}
+
+		// rounds 60-63
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = MSGTMP3[P];
+			MSG[P] = _mm_add_epi32(MSG[P],_mm_load_si128(reinterpret_cast<const __m128i*>(&K64[60])));
+			STATE1[P] = _mm_sha256rnds2_epu32(STATE1[P],STATE0[P],MSG[P]);
+		}
+		for(int P = 0; P < N; ++P) {
+			MSG[P] = _mm_shuffle_epi32(MSG[P],0x0E);
+			STATE0[P] = _mm_sha256rnds2_epu32(STATE0[P],STATE1[P],MSG[P]);
+		}
+
+		for(int P = 0; P < N; ++P) {
+			// add to state
+			STATE0[P] = _mm_add_epi32(STATE0[P],ABEF_INIT);
+			STATE1[P] = _mm_add_epi32(STATE1[P],CDGH_INIT);
+
+			// reorder hash
+			STATE0[P] = _mm_shuffle_epi32(STATE0[P],0x1B); // FEBA
+			STATE1[P] = _mm_shuffle_epi32(STATE1[P],0xB1); // DCHG
+			HASH0_SAVE[P] = _mm_blend_epi16(STATE0[P],STATE1[P],0xF0); // DCBA
+			HASH1_SAVE[P] = _mm_alignr_epi8(STATE1[P],STATE0[P],8); // HGFE
+		}
+	}
+
+	// shuffle/return hash
+	for(int P = 0; P < N; ++P) {
+		HASH0_SAVE[P] = _mm_shuffle_epi8(HASH0_SAVE[P],SHUF_MASK);
+		HASH1_SAVE[P] = _mm_shuffle_epi8(HASH1_SAVE[P],SHUF_MASK);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&hash[P * 32]),HASH0_SAVE[P]);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&hash[P * 32 + 16]),HASH1_SAVE[P]);
+	}
+}
+
 #else // __SHA__
 
 void recursive_sha256_ni(uint8_t* hash, const uint64_t num_iters) {
@@ -438,5 +646,9 @@ void recursive_sha256_ni_x2(uint8_t* hash, const uint64_t num_iters) {
 	throw std::logic_error("recursive_sha256_ni_x2() not available");
 }
 
+void recursive_sha256_ni_x4(uint8_t* hash, const uint64_t num_iters) {
+	throw std::logic_error("recursive_sha256_ni_x4() not available");
+}
+
 #endif // __SHA__
 
@@ -7,17 +7,110 @@
 
 #include <mmx/signature_t.hpp>
 
-#include <tuple>
+#include <list>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
 
 
 namespace mmx {
 
-std::mutex g_mutex;
-
 // prevent attacker from generating cache collisions on every node
 const auto hash_salt = vnx::Hash64::rand();
 
-std::array<std::tuple<hash_t, pubkey_t, signature_t>, 16384> g_sig_cache;
+/*
+ * Signature cache entry, protected by a sequence lock (odd = write in progress).
+ * Readers never block, writers skip the update if another write is in progress.
+ */
+struct sig_cache_entry_t {
+	static constexpr size_t num_words = (32 + 33 + 64 + 7) / 8;		// hash + pubkey + signature
+
+	std::atomic<uint64_t> seq {0};
+	std::atomic<uint64_t> data[num_words] = {};
+};
+
+std::array<sig_cache_entry_t, 16384> g_sig_cache;
+
+/*
+ * LRU cache of parsed public keys, sharded to reduce lock contention.
+ */
+struct pubkey_cache_shard_t {
+	static constexpr size_t max_size = 256;
+
+	std::mutex mutex;
+	std::list<std::pair<pubkey_t, secp256k1_pubkey>> list;		// most recently used first
+	std::unordered_map<pubkey_t, decltype(list)::iterator> map;
+};
+
+std::array<pubkey_cache_shard_t, 64> g_pubkey_cache;
+
+
+static void pack_sig_entry(uint64_t* out, const hash_t& hash, const pubkey_t& pubkey, const signature_t& sig)
+{
+	auto* dst = (uint8_t*)out;
+	::memset(dst, 0, sig_cache_entry_t::num_words * 8);
+	::memcpy(dst, hash.data(), hash.size());
+	::memcpy(dst + 32, pubkey.data(), pubkey.size());
+	::memcpy(dst + 32 + 33, sig.data(), sig.size());
+}
+
+static bool check_sig_cache(const sig_cache_entry_t& entry, const uint64_t* key)
+{
+	const auto seq = entry.seq.load(std::memory_order_acquire);
+	if(seq == 0 || (seq & 1)) {
+		return false;
+	}
+	uint64_t tmp[sig_cache_entry_t::num_words];
+	for(size_t i = 0; i < sig_cache_entry_t::num_words; ++i) {
+		tmp[i] = entry.data[i].load(std::memory_order_relaxed);
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	if(entry.seq.load(std::memory_order_relaxed) != seq) {
+		return false;
+	}
+	return ::memcmp(tmp, key, sizeof(tmp)) == 0;
+}
+
+static void update_sig_cache(sig_cache_entry_t& entry, const uint64_t* key)
+{
+	auto seq = entry.seq.load(std::memory_order_relaxed);
+	if((seq & 1) || !entry.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+		return;
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for(size_t i = 0; i < sig_cache_entry_t::num_words; ++i) {
+		entry.data[i].store(key[i], std::memory_order_relaxed);
+	}
+	entry.seq.store(seq + 2, std::memory_order_release);
+}
+
+static secp256k1_pubkey get_secp256k1_pubkey(const pubkey_t& pubkey)
+{
+	auto& shard = g_pubkey_cache[std::hash<pubkey_t>{}(pubkey) % g_pubkey_cache.size()];
+	{
+		std::lock_guard lock(shard.mutex);
+		auto iter = shard.map.find(pubkey);
+		if(iter != shard.map.end()) {
+			shard.list.splice(shard.list.begin(), shard.list, iter->second);
+			return iter->second->second;
+		}
+	}
+	const auto key = pubkey.to_secp256k1();
+	{
+		std::lock_guard lock(shard.mutex);
+		if(!shard.map.count(pubkey)) {
+			shard.list.emplace_front(pubkey, key);
+			shard.map[pubkey] = shard.list.begin();
+			if(shard.list.size() > shard.max_size) {
+				shard.map.erase(shard.list.back().first);
+				shard.list.pop_back();
+			}
+		}
+	}
+	return key;
+}
 
 
 signature_t::signature_t(const secp256k1_ecdsa_signature& sig)
@@ -55,24 +148,20 @@ bool signature_t::verify(const pubkey_t& pubkey, const hash_t& hash) const
 {
 	const size_t sig_hash = vnx::Hash64(crc64(), hash_salt);
 
-	const auto entry = std::make_tuple(hash, pubkey, *this);
+	uint64_t key[sig_cache_entry_t::num_words];
+	pack_sig_entry(key, hash, pubkey, *this);
 
 	auto& cache = g_sig_cache[sig_hash % g_sig_cache.size()];
-	{
-		std::lock_guard lock(g_mutex);
-		if(entry == cache) {
-			return true;
-		}
+	if(check_sig_cache(cache, key)) {
+		return true;
 	}
 	const auto sig = to_secp256k1();
-	const auto key = pubkey.to_secp256k1();
-	const bool res = secp256k1_ecdsa_verify(g_secp256k1, &sig, hash.data(), &key);
+	const auto pub = get_secp256k1_pubkey(pubkey);
+	const bool res = secp256k1_ecdsa_verify(g_secp256k1, &sig, hash.data(), &pub);
 	if(res) {
-		std::lock_guard lock(g_mutex);
-		cache = entry;
+		update_sig_cache(cache, key);
 	}
 	return res;
 }
 
-
 } // mmx
@@ -19,6 +19,39 @@ namespace vm {
 
 static const uint64_t MEM_HEAP_NEXT_ALLOC = MEM_HEAP + GLOBAL_NEXT_ALLOC;
 
+decoded_instr_t decode(const instr_t& instr)
+{
+	decoded_instr_t out;
+	out.code = instr.code;
+	out.flags = instr.flags;
+	out.arg[0] = instr.a;
+	out.arg[1] = instr.b;
+	out.arg[2] = instr.c;
+	out.arg[3] = instr.d;
+
+	const uint8_t ref_flags[4] = {OPFLAG_REF_A, OPFLAG_REF_B, OPFLAG_REF_C, OPFLAG_REF_D};
+	for(int i = 0; i < 4; ++i) {
+		const auto src = out.arg[i];
+		if(src >= MEM_STACK && src < MEM_STATIC) {
+			out.mode[i] |= OPMODE_STACK;
+		}
+		if(instr.flags & ref_flags[i]) {
+			out.mode[i] |= OPMODE_REF;
+		}
+	}
+	return out;
+}
+
+std::vector<decoded_instr_t> decode(const std::vector<instr_t>& code)
+{
+	std::vector<decoded_instr_t> out;
+	out.reserve(code.size());
+	for(const auto& instr : code) {
+		out.push_back(decode(instr));
+	}
+	return out;
+}
+
 Engine::Engine(
 		const addr_t& contract, std::shared_ptr<Storage> backend, bool read_only, const uint32_t protocol_version)
 	:	contract(contract),
@@ -406,9 +439,8 @@ void Engine::erase_entries(const uint64_t dst)
 
 void Engine::erase(const uint64_t dst)
 {
-	const auto iter = memory.find(dst);
-	if(iter != memory.end()) {
-		erase(iter->second);
+	if(auto var = memory.find(dst)) {
+		erase(*var);
 	}
 	else if(dst >= MEM_STATIC) {
 		if(auto var = storage->read(contract, dst)) {
@@ -477,9 +509,8 @@ void Engine::clear(var_t* var)
 
 var_t* Engine::read(const uint64_t src, const bool mem_only)
 {
-	auto iter = memory.find(src);
-	if(iter != memory.end()) {
-		auto var = iter->second.get();
+	if(auto slot = memory.find(src)) {
+		auto var = slot->get();
 		if(var) {
 			if(var->flags & FLAG_DELETED) {
 				return nullptr;
@@ -593,12 +624,13 @@ void Engine::init()
 		throw std::logic_error("init(): already initialized");
 	}
 	// Note: address 0 is not a valid key (used to denote "key not found")
-	for(auto iter = memory.lower_bound(1); iter != memory.lower_bound(MEM_EXTERN); ++iter) {
-		const auto* key = iter->second.get();
-		if(num_bytes(key) <= MAX_KEY_BYTES) {
-			key_map.emplace(key, iter->first);
-		}
-	}
+	memory.for_each(1, MEM_EXTERN,
+		[this](const uint64_t addr, std::unique_ptr<var_t>& var) {
+			const auto* key = var.get();
+			if(num_bytes(key) <= MAX_KEY_BYTES) {
+				key_map.emplace(key, addr);
+			}
+		});
 	have_init = true;
 }
 
@@ -610,12 +642,19 @@ void Engine::begin(const uint64_t instr_ptr)
 	if(!call_stack.empty()) {
 		throw std::logic_error("begin(): call stack not empty");
 	}
-	for(auto iter = memory.begin(); iter != memory.lower_bound(MEM_STACK); ++iter) {
-		if(auto var = iter->second.get()) {
-			var->flags |= FLAG_CONST;
-			var->flags &= ~FLAG_DIRTY;
-		}
+	if(shared_code) {
+		program = shared_code.get();
+	} else {
+		decoded = decode(code);
+		program = &decoded;
 	}
+	memory.for_each(0, MEM_STACK,
+		[](const uint64_t addr, std::unique_ptr<var_t>& var) {
+			if(var) {
+				var->flags |= FLAG_CONST;
+				var->flags &= ~FLAG_DIRTY;
+			}
+		});
 	frame_t frame;
 	frame.instr_ptr = instr_ptr;
 	call_stack.push_back(frame);
@@ -623,19 +662,46 @@ void Engine::begin(const uint64_t instr_ptr)
 
 void Engine::run()
 {
-	while(!call_stack.empty()) {
-		step();
+	// single exception boundary for the whole run, same semantics as step()
+	uint64_t instr_ptr = -1;
+	try {
+		dispatch(nullptr, &instr_ptr);
+	} catch(...) {
+		if(instr_ptr != uint64_t(-1)) {
+			if(is_debug) {
+				dump_memory();
+			}
+			error_addr = instr_ptr;
+		}
+		throw;
 	}
 }
 
+inline const decoded_instr_t* Engine::fetch(uint64_t* p_instr_ptr, const bool check)
+{
+	if(check) {
+		check_gas();		// for the previous instruction
+	}
+	if(call_stack.empty()) {
+		return nullptr;
+	}
+	const auto instr_ptr = call_stack.back().instr_ptr;
+	if(instr_ptr >= program->size()) {
+		*p_instr_ptr = -1;
+		throw std::logic_error("instr_ptr out of bounds: " + to_hex(instr_ptr) + " > " + to_hex(program->size()));
+	}
+	*p_instr_ptr = instr_ptr;
+	return &(*program)[instr_ptr];
+}
+
 void Engine::step()
 {
 	const auto instr_ptr = get_frame().instr_ptr;
-	if(instr_ptr >= code.size()) {
-		throw std::logic_error("instr_ptr out of bounds: " + to_hex(instr_ptr) + " > " + to_hex(code.size()));
+	if(instr_ptr >= program->size()) {
+		throw std::logic_error("instr_ptr out of bounds: " + to_hex(instr_ptr) + " > " + to_hex(program->size()));
 	}
 	try {
-		exec(code[instr_ptr]);
+		exec((*program)[instr_ptr]);
 		check_gas();
 	} catch(...) {
 		if(is_debug) {
@@ -1265,105 +1331,196 @@ uint64_t Engine::deref(const uint64_t src)
 	return ((const ref_t&)var).address;
 }
 
-uint64_t Engine::deref_addr(uint32_t src, const bool flag)
+inline uint64_t Engine::deref_addr(const decoded_instr_t& instr, const uint32_t i)
 {
-	if(src >= MEM_STACK && src < MEM_STATIC) {
+	uint64_t src = instr.arg[i];
+	if(instr.mode[i] & OPMODE_STACK) {
 		const auto& frame = get_frame();
-		if(uint64_t(src) + frame.stack_ptr >= MEM_STATIC) {
+		if(src + frame.stack_ptr >= MEM_STATIC) {
 			throw std::runtime_error("stack overflow");
 		}
 		src += frame.stack_ptr;
 	}
-	return flag ? deref(src) : src;
+	return (instr.mode[i] & OPMODE_REF) ? deref(src) : src;
 }
 
-uint64_t Engine::deref_value(uint32_t src, const bool flag)
+inline uint64_t Engine::deref_value(const decoded_instr_t& instr, const uint32_t i)
 {
-	if(flag) {
-		return read_fail<uint_t>(deref_addr(src, false), TYPE_UINT).value;
+	if(instr.mode[i] & OPMODE_REF) {
+		uint64_t src = instr.arg[i];
+		if(instr.mode[i] & OPMODE_STACK) {
+			const auto& frame = get_frame();
+			if(src + frame.stack_ptr >= MEM_STATIC) {
+				throw std::runtime_error("stack overflow");
+			}
+			src += frame.stack_ptr;
+		}
+		return read_fail<uint_t>(src, TYPE_UINT).value;
 	}
-	return src;
+	return instr.arg[i];
 }
 
 void Engine::exec(const instr_t& instr)
 {
+	exec(decode(instr));
+}
+
+void Engine::exec(const decoded_instr_t& instr)
+{
+	dispatch(&instr, nullptr);
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(MMX_VM_NO_THREADED_DISPATCH)
+#define MMX_VM_THREADED_DISPATCH
+#endif
+
+/*
+ * Executes `instr` only, or when null the program until the call stack is empty.
+ * With GCC / Clang every handler jumps directly to the next one via a label table (threaded dispatch),
+ * otherwise this is a plain switch loop. Both behave exactly the same.
+ */
+void Engine::dispatch(const decoded_instr_t* instr, uint64_t* p_instr_ptr)
+{
+	const bool single = instr;
+
+#ifdef MMX_VM_THREADED_DISPATCH
+	// indexed by opcode, X = invalid
+	static_assert(OP_RET == 0x08 && OP_MOD == 0x24 && OP_SHR == 0x47 && OP_CMP_GTE == 0x65
+			&& OP_POP_BACK == 0x86 && OP_VERIFY == 0xA4 && OP_BALANCE == 0xC7, "opcodes changed, update labels");
+#define X &&L_INVALID
+	static void* const labels[256] = {
+		&&L_OP_NOP, &&L_OP_CLR, &&L_OP_COPY, &&L_OP_CLONE, &&L_OP_JUMP, &&L_OP_JUMPI, &&L_OP_JUMPN, &&L_OP_CALL,	// 0x00
+		&&L_OP_RET, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_ADD, &&L_OP_SUB, &&L_OP_MUL, &&L_OP_DIV, &&L_OP_MOD, X, X, X,	// 0x20
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_NOT, &&L_OP_XOR, &&L_OP_AND, &&L_OP_OR, &&L_OP_MIN, &&L_OP_MAX, &&L_OP_SHL, &&L_OP_SHR,	// 0x40
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_CMP_EQ, &&L_OP_CMP_NEQ, &&L_OP_CMP_LT, &&L_OP_CMP_GT, &&L_OP_CMP_LTE, &&L_OP_CMP_GTE, X, X,	// 0x60
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_TYPE, &&L_OP_SIZE, &&L_OP_GET, &&L_OP_SET, &&L_OP_ERASE, &&L_OP_PUSH_BACK, &&L_OP_POP_BACK, X,	// 0x80
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_CONV, &&L_OP_CONCAT, &&L_OP_MEMCPY, &&L_OP_SHA256, &&L_OP_VERIFY, X, X, X,	// 0xA0
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		&&L_OP_LOG, &&L_OP_SEND, &&L_OP_MINT, &&L_OP_EVENT, &&L_OP_FAIL, &&L_OP_RCALL, &&L_OP_CREAD, &&L_OP_BALANCE,	// 0xC0
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,	// 0xE0
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+		X, X, X, X, X, X, X, X,
+	};
+#undef X
+#define VM_CASE(op) L_##op
+#define VM_DEFAULT L_INVALID
+#define VM_NEXT() { get_frame().instr_ptr++; VM_JUMPED(); }
+#define VM_JUMPED() { if(single || !(instr = fetch(p_instr_ptr))) { return; } gas_used += INSTR_COST; goto *labels[instr->code]; }
+#else
+#define VM_CASE(op) case op
+#define VM_DEFAULT default
+#define VM_NEXT() { get_frame().instr_ptr++; goto next; }
+#define VM_JUMPED() goto next
+#endif
+
+	if(!single && !(instr = fetch(p_instr_ptr, false))) {
+		return;
+	}
+#ifndef MMX_VM_THREADED_DISPATCH
+	for(;;) {
+#endif
 	gas_used += INSTR_COST;
 
-	switch(instr.code) {
-	case OP_NOP:
-		break;
-	case OP_CLR:
-		if(instr.flags & OPFLAG_REF_A) {
+#ifdef MMX_VM_THREADED_DISPATCH
+	goto *labels[instr->code];
+	{
+#else
+	switch(instr->code) {
+#endif
+	VM_CASE(OP_NOP):
+		VM_NEXT();
+	VM_CASE(OP_CLR):
+		if(instr->flags & OPFLAG_REF_A) {
 			throw std::logic_error("OPFLAG_REF_A not supported");
 		}
-		erase(instr.a);
-		break;
-	case OP_COPY:
-		copy(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_CLONE:
-		clone(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_JUMP: {
-		jump(	deref_value(instr.a, instr.flags & OPFLAG_REF_A));
-		return;
-	}
-	case OP_JUMPI:
-		if(is_true(deref_addr(instr.b, instr.flags & OPFLAG_REF_B))) {
-			jump(deref_value(instr.a, instr.flags & OPFLAG_REF_A));
-			return;
+		erase(instr->arg[0]);
+		VM_NEXT();
+	VM_CASE(OP_COPY):
+		copy(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_CLONE):
+		clone(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_JUMP):
+		jump(	deref_value(*instr, 0));
+		VM_JUMPED();
+	VM_CASE(OP_JUMPI):
+		if(is_true(deref_addr(*instr, 1))) {
+			jump(deref_value(*instr, 0));
+			VM_JUMPED();
 		}
-		break;
-	case OP_JUMPN:
-		if(!is_true(deref_addr(instr.b, instr.flags & OPFLAG_REF_B))) {
-			jump(deref_value(instr.a, instr.flags & OPFLAG_REF_A));
-			return;
+		VM_NEXT();
+	VM_CASE(OP_JUMPN):
+		if(!is_true(deref_addr(*instr, 1))) {
+			jump(deref_value(*instr, 0));
+			VM_JUMPED();
 		}
-		break;
-	case OP_CALL:
-		if(instr.flags & OPFLAG_REF_B) {
+		VM_NEXT();
+	VM_CASE(OP_CALL):
+		if(instr->flags & OPFLAG_REF_B) {
 			throw std::logic_error("OPFLAG_REF_B not supported");
 		}
-		call(	deref_value(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_value(instr.b, instr.flags & OPFLAG_REF_B));
-		return;
-	case OP_RET:
+		call(	deref_value(*instr, 0),
+				deref_value(*instr, 1));
+		VM_JUMPED();
+	VM_CASE(OP_RET):
 		if(ret()) {
-			return;
+			VM_JUMPED();
 		}
-		break;
-	case OP_ADD: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+		VM_NEXT();
+	VM_CASE(OP_ADD): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		const uint256_t D = L + R;
-		if((instr.flags & OPFLAG_CATCH_OVERFLOW) && D < L) {
+		if((instr->flags & OPFLAG_CATCH_OVERFLOW) && D < L) {
 			throw std::runtime_error("integer overflow");
 		}
 		write(dst, uint_t(D));
-		break;
+		VM_NEXT();
 	}
-	case OP_SUB: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_SUB): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		const uint256_t D = L - R;
-		if((instr.flags & OPFLAG_CATCH_OVERFLOW) && D > L) {
+		if((instr->flags & OPFLAG_CATCH_OVERFLOW) && D > L) {
 			throw std::runtime_error("integer overflow");
 		}
 		write(dst, uint_t(D));
-		break;
+		VM_NEXT();
 	}
-	case OP_MUL: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_MUL): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		if((L >> 64) || (R >> 64)) {
@@ -1372,7 +1529,7 @@ void Engine::exec(const instr_t& instr)
 			gas_used += INSTR_MUL_128_COST;
 		}
 		const uint256_t D = L * R;
-		if(instr.flags & OPFLAG_CATCH_OVERFLOW) {
+		if(instr->flags & OPFLAG_CATCH_OVERFLOW) {
 			const bool overflow = (protocol_version >= 1)
 					? L != uint256_0 && R > uint256_max / L
 					: D < L && D < R;
@@ -1381,12 +1538,12 @@ void Engine::exec(const instr_t& instr)
 			}
 		}
 		write(dst, uint_t(D));
-		break;
+		VM_NEXT();
 	}
-	case OP_DIV: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_DIV): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		if(R == uint256_0) {
@@ -1400,12 +1557,12 @@ void Engine::exec(const instr_t& instr)
 			gas_used += INSTR_DIV_64_COST;
 		}
 		write(dst, uint_t(L / R));
-		break;
+		VM_NEXT();
 	}
-	case OP_MOD: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_MOD): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		if(R == uint256_0) {
@@ -1419,13 +1576,13 @@ void Engine::exec(const instr_t& instr)
 			gas_used += INSTR_DIV_64_COST;
 		}
 		write(dst, uint_t(L % R));
-		break;
+		VM_NEXT();
 	}
-	case OP_NOT: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto src = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
+	VM_CASE(OP_NOT): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto src = deref_addr(*instr, 1);
 		const auto& var = read_fail(src);
-		if(instr.flags & OPFLAG_BITWISE) {
+		if(instr->flags & OPFLAG_BITWISE) {
 			switch(var.type) {
 				case TYPE_UINT:
 					write(dst, uint_t(~((const uint_t&)var).value));
@@ -1444,15 +1601,15 @@ void Engine::exec(const instr_t& instr)
 		} else {
 			write(dst, var_t(!is_true(var)));
 		}
-		break;
+		VM_NEXT();
 	}
-	case OP_XOR: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_XOR): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail(lhs);
 		const auto& R = read_fail(rhs);
-		if(instr.flags & OPFLAG_BITWISE) {
+		if(instr->flags & OPFLAG_BITWISE) {
 			if(L.type != R.type) {
 				throw std::runtime_error("type mismatch (bitwise XOR)");
 			}
@@ -1479,15 +1636,15 @@ void Engine::exec(const instr_t& instr)
 		} else {
 			write(dst, var_t(is_true(L) ^ is_true(R)));
 		}
-		break;
+		VM_NEXT();
 	}
-	case OP_AND: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_AND): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail(lhs);
 		const auto& R = read_fail(rhs);
-		if(instr.flags & OPFLAG_BITWISE) {
+		if(instr->flags & OPFLAG_BITWISE) {
 			if(L.type != R.type) {
 				throw std::runtime_error("type mismatch (bitwise AND)");
 			}
@@ -1514,15 +1671,15 @@ void Engine::exec(const instr_t& instr)
 		} else {
 			write(dst, var_t(is_true(L) && is_true(R)));
 		}
-		break;
+		VM_NEXT();
 	}
-	case OP_OR: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_OR): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail(lhs);
 		const auto& R = read_fail(rhs);
-		if(instr.flags & OPFLAG_BITWISE) {
+		if(instr->flags & OPFLAG_BITWISE) {
 			if(L.type != R.type) {
 				throw std::runtime_error("type mismatch (bitwise OR)");
 			}
@@ -1549,54 +1706,54 @@ void Engine::exec(const instr_t& instr)
 		} else {
 			write(dst, var_t(is_true(L) || is_true(R)));
 		}
-		break;
+		VM_NEXT();
 	}
-	case OP_MIN: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_MIN): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		write(dst, uint_t(L < R ? L : R));
-		break;
+		VM_NEXT();
 	}
-	case OP_MAX: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_MAX): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail<uint_t>(lhs, TYPE_UINT).value;
 		const auto& R = read_fail<uint_t>(rhs, TYPE_UINT).value;
 		write(dst, uint_t(L > R ? L : R));
-		break;
+		VM_NEXT();
 	}
-	case OP_SHL: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto src = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto count = deref_value(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_SHL): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto src = deref_addr(*instr, 1);
+		const auto count = deref_value(*instr, 2);
 		const auto& value = read_fail<uint_t>(src, TYPE_UINT).value;
 		write(dst, uint_t(value << count));
-		break;
+		VM_NEXT();
 	}
-	case OP_SHR: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto src = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto count = deref_value(instr.c, instr.flags & OPFLAG_REF_C);
+	VM_CASE(OP_SHR): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto src = deref_addr(*instr, 1);
+		const auto count = deref_value(*instr, 2);
 		const auto& value = read_fail<uint_t>(src, TYPE_UINT).value;
 		write(dst, uint_t(value >> count));
-		break;
-	}
-	case OP_CMP_EQ:
-	case OP_CMP_NEQ:
-	case OP_CMP_LT:
-	case OP_CMP_GT:
-	case OP_CMP_LTE:
-	case OP_CMP_GTE: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto lhs = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
-		const auto rhs = deref_addr(instr.c, instr.flags & OPFLAG_REF_C);
+		VM_NEXT();
+	}
+	VM_CASE(OP_CMP_EQ):
+	VM_CASE(OP_CMP_NEQ):
+	VM_CASE(OP_CMP_LT):
+	VM_CASE(OP_CMP_GT):
+	VM_CASE(OP_CMP_LTE):
+	VM_CASE(OP_CMP_GTE): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto lhs = deref_addr(*instr, 1);
+		const auto rhs = deref_addr(*instr, 2);
 		const auto& L = read_fail(lhs);
 		const auto& R = read_fail(rhs);
-		switch(instr.code) {
+		switch(instr->code) {
 			case OP_CMP_EQ:
 			case OP_CMP_NEQ: break;
 			default:
@@ -1606,7 +1763,7 @@ void Engine::exec(const instr_t& instr)
 		}
 		const auto cmp = compare(L, R);
 		bool res = false;
-		switch(instr.code) {
+		switch(instr->code) {
 			case OP_CMP_EQ: res = (cmp == 0); break;
 			case OP_CMP_NEQ: res = (cmp != 0); break;
 			case OP_CMP_LT: res = (cmp < 0); break;
@@ -1616,18 +1773,18 @@ void Engine::exec(const instr_t& instr)
 			default: break;
 		}
 		write(dst, var_t(res));
-		break;
+		VM_NEXT();
 	}
-	case OP_TYPE: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto addr = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
+	VM_CASE(OP_TYPE): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto addr = deref_addr(*instr, 1);
 		const auto& var = read_fail(addr);
 		write(dst, uint_t(uint32_t(var.type)));
-		break;
+		VM_NEXT();
 	}
-	case OP_SIZE: {
-		const auto dst = deref_addr(instr.a, instr.flags & OPFLAG_REF_A);
-		const auto addr = deref_addr(instr.b, instr.flags & OPFLAG_REF_B);
+	VM_CASE(OP_SIZE): {
+		const auto dst = deref_addr(*instr, 0);
+		const auto addr = deref_addr(*instr, 1);
 		const auto& var = read_fail(addr);
 		switch(var.type) {
 			case TYPE_STRING:
@@ -1640,123 +1797,133 @@ void Engine::exec(const instr_t& instr)
 			default:
 				throw invalid_type(var);
 		}
-		break;
-	}
-	case OP_GET:
-		get(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C), instr.flags);
-		break;
-	case OP_SET:
-		set(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C), instr.flags);
-		break;
-	case OP_ERASE:
-		erase(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B), instr.flags);
-		break;
-	case OP_PUSH_BACK:
-		push_back(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-					deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_POP_BACK:
-		pop_back(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-					deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_CONV:
-		conv(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_value(instr.c, instr.flags & OPFLAG_REF_C),
-				deref_value(instr.d, instr.flags & OPFLAG_REF_D));
-		break;
-	case OP_CONCAT:
-		concat(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C));
-		break;
-	case OP_MEMCPY:
-		memcpy(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_value(instr.c, instr.flags & OPFLAG_REF_C),
-				deref_value(instr.d, instr.flags & OPFLAG_REF_D));
-		break;
-	case OP_SHA256:
-		sha256(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_VERIFY:
-		verify(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C),
-				deref_addr(instr.d, instr.flags & OPFLAG_REF_D));
-		break;
-	case OP_LOG:
-		log(	deref_value(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_SEND:
-		send(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C),
-				deref_addr(instr.d, instr.flags & OPFLAG_REF_D));
-		break;
-	case OP_MINT:
-		mint(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C));
-		break;
-	case OP_EVENT:
-		event(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	case OP_FAIL:
-		error_code = deref_value(instr.b, instr.flags & OPFLAG_REF_B);
+		VM_NEXT();
+	}
+	VM_CASE(OP_GET):
+		get(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2), instr->flags);
+		VM_NEXT();
+	VM_CASE(OP_SET):
+		set(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2), instr->flags);
+		VM_NEXT();
+	VM_CASE(OP_ERASE):
+		erase(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1), instr->flags);
+		VM_NEXT();
+	VM_CASE(OP_PUSH_BACK):
+		push_back(	deref_addr(*instr, 0),
+					deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_POP_BACK):
+		pop_back(	deref_addr(*instr, 0),
+					deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_CONV):
+		conv(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_value(*instr, 2),
+				deref_value(*instr, 3));
+		VM_NEXT();
+	VM_CASE(OP_CONCAT):
+		concat(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2));
+		VM_NEXT();
+	VM_CASE(OP_MEMCPY):
+		memcpy(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_value(*instr, 2),
+				deref_value(*instr, 3));
+		VM_NEXT();
+	VM_CASE(OP_SHA256):
+		sha256(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_VERIFY):
+		verify(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2),
+				deref_addr(*instr, 3));
+		VM_NEXT();
+	VM_CASE(OP_LOG):
+		log(	deref_value(*instr, 0),
+				deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_SEND):
+		send(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2),
+				deref_addr(*instr, 3));
+		VM_NEXT();
+	VM_CASE(OP_MINT):
+		mint(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2));
+		VM_NEXT();
+	VM_CASE(OP_EVENT):
+		event(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_CASE(OP_FAIL):
+		error_code = deref_value(*instr, 1);
 		throw std::runtime_error(
-				to_string_value(read(deref_addr(instr.a, instr.flags & OPFLAG_REF_A))));
-	case OP_RCALL:
-		rcall(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_value(instr.c, instr.flags & OPFLAG_REF_C),
-				deref_value(instr.d, instr.flags & OPFLAG_REF_D));
-		break;
-	case OP_CREAD:
-		cread(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-				deref_addr(instr.b, instr.flags & OPFLAG_REF_B),
-				deref_addr(instr.c, instr.flags & OPFLAG_REF_C));
-		break;
-	case OP_BALANCE:
-		read_balance(	deref_addr(instr.a, instr.flags & OPFLAG_REF_A),
-						deref_addr(instr.b, instr.flags & OPFLAG_REF_B));
-		break;
-	default:
-		throw std::logic_error("invalid op_code: " + to_hex(uint32_t(instr.code)));
-	}
-	get_frame().instr_ptr++;
+				to_string_value(read(deref_addr(*instr, 0))));
+	VM_CASE(OP_RCALL):
+		rcall(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_value(*instr, 2),
+				deref_value(*instr, 3));
+		VM_NEXT();
+	VM_CASE(OP_CREAD):
+		cread(	deref_addr(*instr, 0),
+				deref_addr(*instr, 1),
+				deref_addr(*instr, 2));
+		VM_NEXT();
+	VM_CASE(OP_BALANCE):
+		read_balance(	deref_addr(*instr, 0),
+						deref_addr(*instr, 1));
+		VM_NEXT();
+	VM_DEFAULT:
+		throw std::logic_error("invalid op_code: " + to_hex(uint32_t(instr->code)));
+	}
+#ifndef MMX_VM_THREADED_DISPATCH
+next:
+		if(single || !(instr = fetch(p_instr_ptr))) {
+			return;
+		}
+	}
+#endif
+
+#undef VM_CASE
+#undef VM_DEFAULT
+#undef VM_NEXT
+#undef VM_JUMPED
 }
 
 void Engine::clear_stack(const uint64_t offset)
 {
-	for(auto iter = memory.lower_bound(MEM_STACK + offset); iter != memory.lower_bound(MEM_STATIC);) {
-		clear(iter->second.get());
-		iter = memory.erase(iter);
-		check_gas();
-	}
+	memory.for_each(MEM_STACK + offset, MEM_STATIC,
+		[this](const uint64_t addr, std::unique_ptr<var_t>& var) {
+			clear(var.get());
+			var.reset();
+			check_gas();
+		});
 }
 
 void Engine::commit()
 {
 	clear_stack();	// clear references from stack
 
-	for(auto iter = memory.lower_bound(MEM_STATIC); iter != memory.end(); ++iter)
-	{
-		if(auto var = iter->second.get()) {
-			if(var->flags & FLAG_DIRTY) {
-				storage->write(contract, iter->first, *var);
+	memory.for_each(MEM_STATIC, -1,
+		[this](const uint64_t addr, std::unique_ptr<var_t>& var) {
+			if(var && (var->flags & FLAG_DIRTY)) {
+				storage->write(contract, addr, *var);
 				var->flags &= ~FLAG_DIRTY;
 			}
-		}
-	}
+		});
 	for(auto iter = entries.lower_bound(std::make_pair(MEM_STATIC, 0)); iter != entries.end(); ++iter)
 	{
 		if(auto var = iter->second.get()) {
@@ -1786,13 +1953,14 @@ std::map<uint64_t, const var_t*> Engine::find_entries(const uint64_t dst) const
 void Engine::dump_memory(const uint64_t begin, const uint64_t end)
 {
 	std::cout << "-------------------------------------------" << std::endl;
-	for(auto iter = memory.lower_bound(begin); iter != memory.lower_bound(end); ++iter) {
-		std::cout << "[" << to_hex(iter->first) << "] " << to_string(iter->second.get());
-		if(auto var = iter->second.get()) {
-			std::cout << "\t\t(vf: " << to_bin(var->flags) << ") (rc: " << var->ref_count << ")";
-		}
-		std::cout << std::endl;
-	}
+	memory.for_each(begin, end,
+		[](const uint64_t addr, std::unique_ptr<var_t>& var) {
+			std::cout << "[" << to_hex(addr) << "] " << to_string(var.get());
+			if(var) {
+				std::cout << "\t\t(vf: " << to_bin(var->flags) << ") (rc: " << var->ref_count << ")";
+			}
+			std::cout << std::endl;
+		});
 	for(auto iter = entries.lower_bound(std::make_pair(begin, 0)); iter != entries.lower_bound(std::make_pair(end, 0)); ++iter) {
 		std::cout << "[" << to_hex(iter->first.first) << "]"
 				<< "[" << to_hex(iter->first.second) << "] " << to_string(iter->second.get());
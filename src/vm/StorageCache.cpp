@@ -45,22 +45,55 @@ uint64_t StorageCache::lookup(const addr_t& contract, const var_t& value) const
 }
 
 void StorageCache::commit() const
+{
+	commit_to(*backend);
+}
+
+void StorageCache::commit_to(Storage& target) const
 {
 	for(const auto& entry : memory) {
 		if(auto var = entry.second.get()) {
-			backend->write(entry.first.first, entry.first.second, *var);
+			target.write(entry.first.first, entry.first.second, *var);
 		}
 	}
 	for(const auto& entry : entries) {
 		if(auto var = entry.second.get()) {
-			backend->write(std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first), *var);
+			target.write(std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first), *var);
+		}
+	}
+	for(const auto& entry : balance_map) {
+		for(const auto& entry2 : entry.second) {
+			target.set_balance(entry.first, entry2.first, entry2.second);
+		}
+	}
+}
+
+storage_keys_t StorageCache::get_writes() const
+{
+	std::lock_guard lock(mutex);
+
+	storage_keys_t out;
+	for(const auto& entry : memory) {
+		if(entry.second) {
+			out.memory.insert(entry.first);
+		}
+	}
+	for(const auto& entry : entries) {
+		if(entry.second) {
+			out.entries.insert(entry.first);
+		}
+	}
+	for(const auto& entry : key_map) {
+		if(!entry.second.empty()) {
+			out.lookups.insert(entry.first);
 		}
 	}
 	for(const auto& entry : balance_map) {
 		for(const auto& entry2 : entry.second) {
-			backend->set_balance(entry.first, entry2.first, entry2.second);
+			out.balances.emplace(entry.first, entry2.first);
 		}
 	}
+	return out;
 }
 
 std::unique_ptr<uint128> StorageCache::get_balance(const addr_t& contract, const addr_t& currency)
@@ -0,0 +1,96 @@
+#include <mmx/vm/StorageTracker.h>
+
+
+namespace mmx {
+namespace vm {
+
+template<typename T>
+static bool intersects(const std::set<T>& lhs, const std::set<T>& rhs)
+{
+	if(lhs.size() > rhs.size()) {
+		return intersects(rhs, lhs);
+	}
+	for(const auto& entry : lhs) {
+		if(rhs.count(entry)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool storage_keys_t::intersects(const storage_keys_t& other) const
+{
+	return vm::intersects(memory, other.memory)
+		|| vm::intersects(entries, other.entries)
+		|| vm::intersects(lookups, other.lookups)
+		|| vm::intersects(balances, other.balances);
+}
+
+void storage_keys_t::insert(const storage_keys_t& other)
+{
+	memory.insert(other.memory.begin(), other.memory.end());
+	entries.insert(other.entries.begin(), other.entries.end());
+	lookups.insert(other.lookups.begin(), other.lookups.end());
+	balances.insert(other.balances.begin(), other.balances.end());
+}
+
+StorageTracker::StorageTracker(std::shared_ptr<Storage> backend)
+	:	backend(backend)
+{
+}
+
+std::unique_ptr<var_t> StorageTracker::read(const addr_t& contract, const uint64_t src) const
+{
+	{
+		std::lock_guard lock(mutex);
+		reads.memory.emplace(contract, src);
+	}
+	return backend->read(contract, src);
+}
+
+std::unique_ptr<var_t> StorageTracker::read(const addr_t& contract, const uint64_t src, const uint64_t key) const
+{
+	{
+		std::lock_guard lock(mutex);
+		reads.entries.emplace(contract, src, key);
+	}
+	return backend->read(contract, src, key);
+}
+
+void StorageTracker::write(const addr_t& contract, const uint64_t dst, const var_t& value)
+{
+	throw std::logic_error("StorageTracker: read-only");
+}
+
+void StorageTracker::write(const addr_t& contract, const uint64_t dst, const uint64_t key, const var_t& value)
+{
+	throw std::logic_error("StorageTracker: read-only");
+}
+
+uint64_t StorageTracker::lookup(const addr_t& contract, const var_t& value) const
+{
+	{
+		std::lock_guard lock(mutex);
+		reads.lookups.insert(contract);
+	}
+	return backend->lookup(contract, value);
+}
+
+std::unique_ptr<uint128> StorageTracker::get_balance(const addr_t& contract, const addr_t& currency)
+{
+	{
+		std::lock_guard lock(mutex);
+		reads.balances.emplace(contract, currency);
+	}
+	return backend->get_balance(contract, currency);
+}
+
+storage_keys_t StorageTracker::get_reads() const
+{
+	std::lock_guard lock(mutex);
+	return reads;
+}
+
+
+} // vm
+} // mmx
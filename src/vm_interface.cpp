@@ -12,6 +12,10 @@
 
 #include <vnx/vnx.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 
 namespace mmx {
 namespace vm {
@@ -50,19 +54,138 @@ std::vector<std::unique_ptr<vm::var_t>> read_constants(std::shared_ptr<const con
 	return read_constants(binary->constant.data(), binary->constant.size());
 }
 
+std::shared_ptr<const decoded_binary_t> decode(std::shared_ptr<const contract::Binary> binary)
+{
+	auto out = std::make_shared<decoded_binary_t>();
+	out->constants = read_constants(binary);
+	if(out->constants.size() >= vm::MEM_EXTERN) {
+		throw std::runtime_error("constant memory overflow");
+	}
+	std::vector<instr_t> code;
+	vm::deserialize(code, binary->binary.data(), binary->binary.size());
+	out->code = std::make_shared<const std::vector<decoded_instr_t>>(vm::decode(code));
+
+	out->num_bytes = sizeof(decoded_binary_t) + out->code->size() * sizeof(decoded_instr_t);
+	for(const auto& var : out->constants) {
+		out->num_bytes += num_bytes(var.get()) + sizeof(var_t);
+	}
+	return out;
+}
+
+class binary_cache_t {
+public:
+	size_t max_size = 256 << 20;
+
+	std::shared_ptr<const decoded_binary_t> find(const addr_t& address)
+	{
+		std::lock_guard lock(mutex);
+		auto iter = map.find(address);
+		if(iter == map.end()) {
+			num_miss++;
+			return nullptr;
+		}
+		num_hit++;
+		list.splice(list.begin(), list, iter->second);
+		return iter->second->second;
+	}
+
+	void insert(const addr_t& address, std::shared_ptr<const decoded_binary_t> entry)
+	{
+		std::lock_guard lock(mutex);
+		if(entry->num_bytes > max_size / 4 || map.count(address)) {
+			return;
+		}
+		list.emplace_front(address, entry);
+		map[address] = list.begin();
+		size += entry->num_bytes;
+		evict();
+	}
+
+	void set_max_size(const size_t max_bytes)
+	{
+		std::lock_guard lock(mutex);
+		max_size = max_bytes;
+		evict();
+	}
+
+	binary_cache_stats_t get_stats() const
+	{
+		std::lock_guard lock(mutex);
+		binary_cache_stats_t out;
+		out.num_hit = num_hit;
+		out.num_miss = num_miss;
+		out.num_evict = num_evict;
+		out.num_entries = map.size();
+		out.size = size;
+		out.max_size = max_size;
+		return out;
+	}
+
+private:
+	void evict()
+	{
+		while(size > max_size && !list.empty()) {
+			const auto& last = list.back();
+			size -= last.second->num_bytes;
+			map.erase(last.first);
+			list.pop_back();
+			num_evict++;
+		}
+	}
+
+	mutable std::mutex mutex;
+	size_t size = 0;
+	uint64_t num_hit = 0;
+	uint64_t num_miss = 0;
+	uint64_t num_evict = 0;
+	std::list<std::pair<addr_t, std::shared_ptr<const decoded_binary_t>>> list;
+	std::unordered_map<addr_t, std::list<std::pair<addr_t, std::shared_ptr<const decoded_binary_t>>>::iterator> map;
+};
+
+static binary_cache_t& get_binary_cache()
+{
+	static binary_cache_t cache;
+	return cache;
+}
+
+std::shared_ptr<const decoded_binary_t> decode_cached(std::shared_ptr<const contract::Binary> binary, const addr_t& address)
+{
+	auto& cache = get_binary_cache();
+	if(auto entry = cache.find(address)) {
+		return entry;
+	}
+	const auto entry = decode(binary);
+	cache.insert(address, entry);
+	return entry;
+}
+
+void set_binary_cache_size(const size_t max_bytes)
+{
+	get_binary_cache().set_max_size(max_bytes);
+}
+
+binary_cache_stats_t get_binary_cache_stats()
+{
+	return get_binary_cache().get_stats();
+}
+
 void load(	std::shared_ptr<vm::Engine> engine,
 			std::shared_ptr<const contract::Binary> binary)
 {
+	load(engine, decode(binary));
+}
+
+void load(	std::shared_ptr<vm::Engine> engine,
+			std::shared_ptr<const decoded_binary_t> binary)
+{
+	// Constants are cloned on purpose: the engine writes to them (flags in begin(), ref_count when a ref
+	// points to a constant, address of arrays / maps in assign()) and assign() charges gas per constant.
+	// Sharing the cached ones would need copy-on-write slots in vm::Memory across the whole engine.
 	uint64_t dst = 0;
-	for(auto& var : read_constants(binary)) {
-		if(dst < vm::MEM_EXTERN) {
-			engine->assign(dst++, std::move(var));
-		}
-	}
-	if(dst >= vm::MEM_EXTERN) {
-		throw std::runtime_error("constant memory overflow");
+	for(const auto& var : binary->constants) {
+		engine->assign(dst++, clone(*var));
 	}
-	vm::deserialize(engine->code, binary->binary.data(), binary->binary.size());
+	engine->shared_code = binary->code;
 
 	engine->init();
 	engine->check_gas();
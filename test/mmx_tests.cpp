@@ -184,6 +184,18 @@ int main(int argc, char** argv)
 			vnx::test::expect(next != hash, true);
 			hash = next;
 		}
+		for(size_t n : {1, 2, 3, 7, 8, 9, 16, 17, 33, 1000}) {
+			const std::vector<hash_t> input(list.begin(), list.begin() + n);
+			auto tmp = input;
+			while(tmp.size() > 1) {
+				std::vector<hash_t> next;
+				for(size_t i = 0; i < tmp.size(); i += 2) {
+					next.push_back(i + 1 < tmp.size() ? hash_t(tmp[i] + tmp[i + 1]) : tmp[i]);
+				}
+				tmp = next;
+			}
+			vnx::test::expect(mmx::calc_btree_hash(input), tmp[0]);
+		}
 	}
 	VNX_TEST_END()
 
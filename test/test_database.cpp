@@ -144,6 +144,178 @@ int main(int argc, char** argv)
 	}
 	VNX_TEST_END()
 
+	VNX_TEST_BEGIN("test_table_sparse")
+	for(const std::string mode : {"sparse", "prefix", "zstd"})
+	{
+		const uint32_t num_entries = 1000;
+
+		mmx::Table::options_t options;
+		options.fence_interval = 16;
+		options.prefix_keys = mode != "sparse";
+		options.compress_level = mode == "zstd" ? 3 : 0;	// falls back to prefix keys without zstd
+		const std::string path = "tmp/test_table_" + mode;
+		auto table = std::make_shared<mmx::Table>(path, options);
+		table->revert(0);
+
+		for(uint32_t i = 0; i < num_entries; ++i) {
+			table->insert(db_write(uint32_t(i * 2)), db_write(uint64_t(i)));
+		}
+		table->commit(1);
+
+		for(uint32_t i = 0; i < num_entries; i += 3) {
+			table->insert(db_write(uint32_t(i * 2)), db_write(uint64_t(i + 1)));
+		}
+		table->commit(2);
+		table->flush();
+
+		table = nullptr;
+		table = std::make_shared<mmx::Table>(path, options);
+
+		for(uint32_t i = 0; i < num_entries; ++i) {
+			vnx::test::expect(db_read<uint64_t>(table->find(db_write(uint32_t(i * 2)))), i % 3 ? i : i + 1);
+			vnx::test::expect(db_read<uint64_t>(table->find(db_write(uint32_t(i * 2)), 0)), i);
+			vnx::test::expect(bool(table->find(db_write(uint32_t(i * 2 + 1)))), false);
+		}
+		{
+			mmx::Table::Iterator iter(table);
+			iter.seek_begin();
+			uint32_t i = 0;
+			while(iter.is_valid()) {
+				vnx::test::expect(db_read<uint32_t>(iter.key()), i * 2);
+				iter.next();
+				i++;
+			}
+			vnx::test::expect(i, num_entries);
+		}
+		{
+			mmx::Table::Iterator iter(table);
+			iter.seek_last();
+			uint32_t i = num_entries;
+			while(iter.is_valid()) {
+				vnx::test::expect(db_read<uint32_t>(iter.key()), (i - 1) * 2);
+				iter.prev();
+				i--;
+			}
+			vnx::test::expect(i, 0u);
+		}
+		{
+			mmx::Table::Iterator iter(table);
+			iter.seek(db_write(uint32_t(101)));
+			vnx::test::expect(iter.is_valid(), true);
+			vnx::test::expect(db_read<uint32_t>(iter.key()), 102u);
+			iter.seek_prev(db_write(uint32_t(101)));
+			vnx::test::expect(iter.is_valid(), true);
+			vnx::test::expect(db_read<uint32_t>(iter.key()), 100u);
+		}
+		table->revert(1);
+
+		for(uint32_t i = 0; i < num_entries; ++i) {
+			vnx::test::expect(db_read<uint64_t>(table->find(db_write(uint32_t(i * 2)))), i);
+		}
+		for(uint32_t k = 2; k < 10; ++k) {
+			for(uint32_t i = 0; i < num_entries; i += 7) {
+				table->insert(db_write(uint32_t(i * 2)), db_write(uint64_t(i + k * 1000)));
+			}
+			table->commit(k);
+			table->flush();
+		}
+		table->compact();
+
+		for(uint32_t i = 0; i < num_entries; ++i) {
+			vnx::test::expect(db_read<uint64_t>(table->find(db_write(uint32_t(i * 2)))), i % 7 ? i : i + 9000);
+			vnx::test::expect(db_read<uint64_t>(table->find(db_write(uint32_t(i * 2)), 5)), i % 7 ? i : i + 6000);
+		}
+	}
+	VNX_TEST_END()
+
+	VNX_TEST_BEGIN("find_many")
+	for(const size_t fence_interval : {0, 16})
+	{
+		const uint32_t num_entries = 1000;
+
+		mmx::Table::options_t options;
+		options.fence_interval = fence_interval;
+		auto table = std::make_shared<mmx::Table>("tmp/find_many_" + std::to_string(fence_interval), options);
+		table->revert(0);
+
+		for(uint32_t i = 0; i < num_entries; ++i) {
+			table->insert(db_write(uint32_t(i * 2)), db_write(uint64_t(i)));
+		}
+		table->commit(1);
+		table->flush();
+
+		for(uint32_t i = 0; i < num_entries; i += 5) {
+			table->insert(db_write(uint32_t(i * 2)), db_write(uint64_t(i + 1)));
+		}
+		table->commit(2);
+
+		std::vector<std::shared_ptr<mmx::db_val_t>> keys;
+		for(uint32_t i = 0; i < 2 * num_entries + 10; i += 3) {
+			keys.push_back(db_write(uint32_t(2 * num_entries + 10 - i)));
+		}
+		keys.push_back(nullptr);
+
+		vnx::ThreadPool threads(4);
+
+		for(const uint32_t max_version : {0u, uint32_t(-1)})
+		for(auto* pool : {(vnx::ThreadPool*)nullptr, &threads})
+		{
+			const auto values = table->find_many(keys, max_version, pool);
+			vnx::test::expect(values.size(), keys.size());
+			for(size_t i = 0; i < keys.size(); ++i) {
+				const auto& key = keys[i];
+				const auto expect = key ? table->find(key, max_version) : nullptr;
+				vnx::test::expect(bool(values[i]), bool(expect));
+				if(expect) {
+					vnx::test::expect(db_read<uint64_t>(values[i]), db_read<uint64_t>(expect));
+				}
+			}
+		}
+		threads.close();
+	}
+	VNX_TEST_END()
+
+	VNX_TEST_BEGIN("bloom_filter")
+	{
+		const uint32_t num_keys = 10000;
+
+		mmx::bloom_filter_t bloom;
+		bloom.init(num_keys, 10);
+		for(uint32_t i = 0; i < num_keys; ++i) {
+			bloom.add(*db_write(uint64_t(i * 2)));
+		}
+		for(uint32_t i = 0; i < num_keys; ++i) {
+			vnx::test::expect(bloom.may_contain(*db_write(uint64_t(i * 2))), true);
+		}
+		uint32_t num_false = 0;
+		for(uint32_t i = 0; i < num_keys; ++i) {
+			num_false += bloom.may_contain(*db_write(uint64_t(i * 2 + 1)));
+		}
+		vnx::test::expect(num_false < num_keys / 20, true);
+	}
+	VNX_TEST_END()
+
+	VNX_TEST_BEGIN("memtable_overwrite")
+	{
+		mmx::Table::options_t options;
+		options.max_block_size = 1024 * 1024;
+		auto table = std::make_shared<mmx::Table>("tmp/memtable_overwrite", options);
+		table->revert(0);
+
+		// arena memory of overwritten values is only released at flush
+		size_t max_mem_size = 0;
+		for(uint32_t i = 0; i < 1000; ++i) {
+			for(uint32_t k = 0; k < 20; ++k) {
+				table->insert(db_write(uint32_t(1)), std::make_shared<mmx::db_val_t>(std::string(256, 'a' + k)));
+			}
+			table->commit(i + 1);
+			max_mem_size = std::max(table->get_mem_size(), max_mem_size);
+		}
+		vnx::test::expect(max_mem_size < 4 * options.max_block_size, true);
+		vnx::test::expect(table->find(db_write(uint32_t(1)))->to_string(), std::string(256, 'a' + 19));
+	}
+	VNX_TEST_END()
+
 	VNX_TEST_BEGIN("uint_table")
 	{
 		mmx::uint_table<uint32_t, std::string> table("tmp/uint_table");
@@ -278,6 +450,151 @@ int main(int argc, char** argv)
 	}
 	VNX_TEST_END()
 
+	VNX_TEST_BEGIN("background_compaction")
+	{
+		mmx::Table::options_t options;
+		options.level_factor = 2;
+		options.force_flush_threshold = 1;
+		auto table = std::make_shared<mmx::Table>("tmp/background_compaction", options);
+		table->revert(0);
+
+		const uint32_t num_iter = 200;
+		for(uint32_t i = 0; i < num_iter; ++i)
+		{
+			table->insert(db_write(uint64_t(i)), db_write(i));
+			table->commit(i + 1);
+
+			// blocks are being merged concurrently
+			for(uint32_t k = 0; k <= i; k += 7) {
+				vnx::test::expect(db_read<uint32_t>(table->find(db_write(uint64_t(k)))), k);
+			}
+		}
+		{
+			mmx::Table::Iterator iter(table);
+			iter.seek_begin();
+			uint32_t count = 0;
+			while(iter.is_valid()) {
+				vnx::test::expect(db_read<uint32_t>(iter.value()), count++);
+				iter.next();
+			}
+			vnx::test::expect(count, num_iter);
+		}
+		table = nullptr;
+		table = std::make_shared<mmx::Table>("tmp/background_compaction", options);
+
+		for(uint32_t i = 0; i < num_iter; ++i) {
+			vnx::test::expect(db_read<uint32_t>(table->find(db_write(uint64_t(i)))), i);
+		}
+		table->revert(num_iter / 2);
+
+		for(uint32_t i = 0; i < num_iter; ++i) {
+			vnx::test::expect(bool(table->find(db_write(uint64_t(i)))), i < num_iter / 2);
+		}
+	}
+	VNX_TEST_END()
+
+	VNX_TEST_BEGIN("compaction_bench")
+	{
+		const uint32_t num_blocks = 8;
+		const uint32_t num_keys = 50000;
+
+		mmx::Table::options_t options;
+		options.level_factor = 1;
+		{
+			mmx::Table table("tmp/compaction_bench", options);
+			table.revert(0);
+			for(uint32_t k = 0; k <= num_blocks; ++k) {
+				for(uint32_t i = 0; i < num_keys; ++i) {
+					const uint64_t value[4] = {i, k, 0, 0};
+					table.insert(db_write(uint64_t(i * 7919 + k)), std::make_shared<mmx::db_val_t>(value, sizeof(value)));
+				}
+				table.commit(k + 1);
+				table.flush();
+			}
+		}
+		options.level_factor = num_blocks;
+		options.auto_compact = false;
+
+		mmx::Table table("tmp/compaction_bench", options);
+
+		// compaction merges the first num_blocks blocks
+		const double block_mb = num_keys * (4 + 4 + 8 + 4 + 32) / double(1 << 20);
+		{
+			const double total_mb = num_blocks * block_mb;
+			const auto time_begin = vnx::get_time_micros();
+			table.compact();
+			const auto elapsed = (vnx::get_time_micros() - time_begin) / 1e6;
+			std::cout << "compaction: " << total_mb / elapsed << " MB/s (" << total_mb << " MB in " << elapsed << " sec)" << std::endl;
+		}
+
+		for(uint32_t k = 0; k <= num_blocks; k += 4) {
+			for(uint32_t i = 0; i < num_keys; i += 101) {
+				const auto value = table.find(db_write(uint64_t(i * 7919 + k)));
+				vnx::test::expect(bool(value), true);
+				vnx::test::expect(value->size, 32u);
+				vnx::test::expect(((const uint64_t*)value->data)[0], uint64_t(i));
+			}
+		}
+	}
+	VNX_TEST_END()
+
+	VNX_TEST_BEGIN("group_commit")
+	for(const bool pipelined : {false, true})
+	{
+		const uint32_t num_tables = 3;
+		const uint32_t num_iter = 100;
+		const std::string prefix = pipelined ? "tmp/pipelined_commit_" : "tmp/group_commit_";
+
+		mmx::Table::options_t options;
+		options.force_flush_threshold = 10;
+		{
+			mmx::DataBase db(2);
+			std::vector<std::shared_ptr<mmx::Table>> tables;
+			for(uint32_t i = 0; i < num_tables; ++i) {
+				auto table = std::make_shared<mmx::Table>(prefix + std::to_string(i), options);
+				table->revert(0);
+				tables.push_back(table);
+				db.add(table);
+			}
+			db.set_durability(16, 3600 * 1000);
+			db.set_pipelined(pipelined);
+
+			for(uint32_t i = 0; i < num_iter; ++i) {
+				for(const auto& table : tables) {
+					if(i) {
+						// may be flushing right now
+						vnx::test::expect(db_read<uint32_t>(table->find(db_write(i - 1))), i - 1);
+					}
+					table->insert(db_write(i), db_write(i));
+				}
+				db.commit(i + 1);
+			}
+			db.set_pipelined(false);
+
+			const auto stats = db.get_commit_stats();
+			vnx::test::expect(stats.size(), size_t(num_tables));
+			for(const auto& entry : stats) {
+				vnx::test::expect(entry.num_commit, uint64_t(num_iter));
+				vnx::test::expect(entry.num_flush, uint64_t(num_iter / options.force_flush_threshold));
+			}
+		}
+		mmx::DataBase db(2);
+		std::vector<std::shared_ptr<mmx::Table>> tables;
+		for(uint32_t i = 0; i < num_tables; ++i) {
+			auto table = std::make_shared<mmx::Table>(prefix + std::to_string(i), options);
+			tables.push_back(table);
+			db.add(table);
+		}
+		vnx::test::expect(db.recover(), num_iter);
+
+		for(const auto& table : tables) {
+			for(uint32_t i = 0; i < num_iter; ++i) {
+				vnx::test::expect(db_read<uint32_t>(table->find(db_write(i))), i);
+			}
+		}
+	}
+	VNX_TEST_END()
+
 	VNX_TEST_BEGIN("empty_force_flush")
 	{
 		mmx::Table::options_t options;
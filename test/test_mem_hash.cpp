@@ -12,6 +12,7 @@
 #include <vnx/vnx.h>
 
 #include <map>
+#include <vector>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -101,6 +102,61 @@ int main(int argc, char** argv)
 
 	delete [] mem;
 
+	// compare multi-lane kernels against scalar version
+	const int num_lanes = get_mem_hash_lanes();
+	std::cout << "lanes = " << num_lanes << std::endl;
+
+	for(const int lanes : {1, 8, 16})
+	{
+		if(lanes > num_lanes) {
+			continue;
+		}
+		std::vector<uint8_t> keys(lanes * 64);
+		std::vector<uint8_t> hash(lanes * 128);
+		std::vector<uint32_t> mem_x(mem_size * lanes);
+
+		int64_t time_sum = 0;
+		size_t num_fail = 0;
+		for(int iter = 0; iter < count; iter += lanes)
+		{
+			for(int k = 0; k < lanes; ++k) {
+				uint32_t msg[9] = {};
+				msg[0] = iter + k;
+				const mmx::hash_512_t key(&msg, sizeof(msg));
+				::memcpy(keys.data() + k * 64, key.data(), 64);
+			}
+			const auto time_begin = vnx::get_wall_time_micros();
+			switch(lanes) {
+				case 16:
+					gen_mem_array_avx512_x16(mem_x.data(), keys.data(), mem_size);
+					calc_mem_hash_avx512_x16(mem_x.data(), hash.data(), num_iter);
+					break;
+				case 8:
+					gen_mem_array_avx2_x8(mem_x.data(), keys.data(), mem_size);
+					calc_mem_hash_avx2_x8(mem_x.data(), hash.data(), num_iter);
+					break;
+				default:
+					gen_mem_array(mem_x.data(), keys.data(), mem_size);
+					calc_mem_hash(mem_x.data(), hash.data(), num_iter);
+			}
+			time_sum += vnx::get_wall_time_micros() - time_begin;
+
+			for(int k = 0; k < lanes && iter + k < count; ++k) {
+				std::vector<uint32_t> mem_ref(mem_size);
+				mmx::bytes_t<128> hash_ref;
+				gen_mem_array(mem_ref.data(), keys.data() + k * 64, mem_size);
+				calc_mem_hash(mem_ref.data(), hash_ref.data(), num_iter);
+				if(::memcmp(hash_ref.data(), hash.data() + k * 128, 128)) {
+					num_fail++;
+				}
+			}
+		}
+		std::cout << "x" << lanes << ": " << (num_fail ? "FAILED" : "OK") << ", " << count / (std::max<int64_t>(time_sum, 1) / 1e6) << " hashes / sec" << std::endl;
+		if(num_fail) {
+			return -1;
+		}
+	}
+
 	return 0;
 }
 
@@ -13,6 +13,9 @@
 #include <mmx/solution/PubKey.hxx>
 
 #include <vnx/vnx.h>
+#include <tuple>
+#include <atomic>
+#include <thread>
 #include <unordered_map>
 
 using namespace mmx;
@@ -251,6 +254,46 @@ int main(int argc, char** argv)
 	std::cout << "total_process_time = " << total_process_time / 1000 << " ms" << std::endl;
 	std::cout << "tps = " << 1e6 / (total_process_time / total_tx_count) << std::endl;
 
+	// multi-threaded signature verify: first pass misses the signature cache, then all hits
+	{
+		int num_sigs = 10000;
+		int num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+		vnx::read_config("nsigs", num_sigs);
+		vnx::read_config("nthreads", num_threads);
+
+		std::vector<std::tuple<pubkey_t, hash_t, signature_t>> sigs;
+		for(int i = 0; i < num_sigs; ++i) {
+			const hash_t msg(std::to_string(i));
+			const auto& skey = skeys[i % skeys.size()];
+			sigs.emplace_back(pubkey_t::from_skey(skey), msg, signature_t::sign(skey, msg));
+		}
+		for(int pass = 0; pass < 2; ++pass)
+		{
+			std::atomic<int64_t> num_fail {0};
+			std::vector<std::thread> threads;
+			const auto time_begin = vnx::get_wall_time_micros();
+			for(int t = 0; t < num_threads; ++t) {
+				threads.emplace_back([t, num_threads, &sigs, &num_fail]() {
+					for(size_t i = t; i < sigs.size(); i += num_threads) {
+						const auto& entry = sigs[i];
+						if(!std::get<2>(entry).verify(std::get<0>(entry), std::get<1>(entry))) {
+							num_fail++;
+						}
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+			const auto elapsed = std::max<int64_t>(vnx::get_wall_time_micros() - time_begin, 1);
+			std::cout << "verify (" << (pass ? "cached" : "uncached") << ", " << num_threads << " threads): "
+					<< int64_t(num_sigs * 1e6 / elapsed) << " / sec, " << int64_t(num_sigs * 1e6 / elapsed / num_threads) << " / sec per thread" << std::endl;
+			if(num_fail) {
+				throw std::logic_error("signature verify failed");
+			}
+		}
+	}
+
 	vnx::close();
 
 	mmx::secp256k1_free();
@@ -9,6 +9,7 @@
 #include <mmx/vm/StorageDB.h>
 #include <mmx/vm/StorageRAM.h>
 #include <mmx/vm/StorageCache.h>
+#include <mmx/vm/StorageTracker.h>
 #include <mmx/vm_interface.h>
 
 #include <vnx/vnx.h>
@@ -41,6 +42,59 @@ std::shared_ptr<vm::Engine> new_engine(std::shared_ptr<vm::Storage> storage, boo
 	return engine;
 }
 
+// increments a counter and a balance of the contract, returns the previous counter value
+uint64_t execute_increment(const addr_t& contract, std::shared_ptr<vm::StorageCache> cache)
+{
+	auto engine = std::make_shared<vm::Engine>(contract, cache, false, 1);
+	engine->gas_limit = 1000000;
+	engine->init();
+	const uint64_t prev = vm::to_uint(engine->read(vm::MEM_STATIC)).lower().lower();
+	engine->write(vm::MEM_STATIC, vm::uint_t(prev + 1));
+	engine->commit();
+
+	uint128 amount = 1;
+	if(auto value = cache->get_balance(contract, addr_t())) {
+		amount += *value;
+	}
+	cache->set_balance(contract, addr_t(), amount);
+	return prev;
+}
+
+std::vector<uint64_t> execute_serial(const std::vector<addr_t>& tx_list, std::shared_ptr<vm::StorageCache> storage)
+{
+	std::vector<uint64_t> result;
+	for(const auto& contract : tx_list) {
+		auto cache = std::make_shared<vm::StorageCache>(storage);
+		result.push_back(execute_increment(contract, cache));
+		cache->commit();
+	}
+	return result;
+}
+
+// same protocol as Node::validate_optimistic()
+std::vector<uint64_t> execute_optimistic(const std::vector<addr_t>& tx_list, std::shared_ptr<vm::StorageCache> storage)
+{
+	std::vector<uint64_t> result(tx_list.size());
+	std::vector<std::shared_ptr<vm::StorageTracker>> reads(tx_list.size());
+	std::vector<std::shared_ptr<vm::StorageCache>> pending(tx_list.size());
+
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		reads[i] = std::make_shared<vm::StorageTracker>(storage);
+		pending[i] = std::make_shared<vm::StorageCache>(reads[i]);
+		result[i] = execute_increment(tx_list[i], pending[i]);
+	}
+	vm::storage_keys_t written;
+	for(size_t i = 0; i < tx_list.size(); ++i) {
+		if(written.intersects(reads[i]->get_reads())) {
+			pending[i] = std::make_shared<vm::StorageCache>(storage);
+			result[i] = execute_increment(tx_list[i], pending[i]);
+		}
+		written.insert(pending[i]->get_writes());
+		pending[i]->commit_to(*storage);
+	}
+	return result;
+}
+
 
 int main(int argc, char** argv)
 {
@@ -404,6 +458,36 @@ int main(int argc, char** argv)
 	}
 	VNX_TEST_END()
 
+	VNX_TEST_BEGIN("optimistic_commit")
+	{
+		db->revert(0);
+		const addr_t A(hash_t("A"));
+		const addr_t B(hash_t("B"));
+		const addr_t C(hash_t("C"));
+		const std::vector<std::vector<addr_t>> batches = {
+			{A, B, C},			// no conflicts
+			{A, A, B, A, C},	// conflicts
+			{C, C, C},
+		};
+		auto serial = std::make_shared<vm::StorageCache>(storage);
+		auto optimistic = std::make_shared<vm::StorageCache>(storage);
+
+		for(const auto& tx_list : batches) {
+			vnx::test::expect(execute_optimistic(tx_list, optimistic), execute_serial(tx_list, serial));
+		}
+		for(const auto& contract : {A, B, C}) {
+			const auto count = serial->read(contract, vm::MEM_STATIC);
+			expect(optimistic->read(contract, vm::MEM_STATIC).get(), count.get());
+			vnx::test::expect(vm::to_uint(count.get()).lower().lower(), uint64_t(contract == C ? 5 : contract == A ? 4 : 2));
+
+			const auto balance = serial->get_balance(contract, addr_t());
+			const auto balance2 = optimistic->get_balance(contract, addr_t());
+			vnx::test::expect(balance && balance2, true);
+			vnx::test::expect(*balance2 == *balance, true);
+		}
+	}
+	VNX_TEST_END()
+
 	return vnx::test::done();
 }
 
@@ -7,6 +7,7 @@
 
 #include <mmx/utils.h>
 #include <mmx/pos/verify.h>
+#include <mmx/pos/mem_hash.h>
 #include <vnx/vnx.h>
 #include <thread>
 
@@ -70,6 +71,41 @@ int main(int argc, char** argv)
 	std::cout << "CUDA available: no" << std::endl;
 #endif
 
+	{
+		// single threaded mem_hash speed for each kernel
+		const int max_lanes = mmx::pos::get_mem_hash_lanes();
+		for(const int lanes : {1, 8, 16})
+		{
+			if(lanes > max_lanes) {
+				continue;
+			}
+			const int count = 4096;
+			std::vector<uint8_t> key(lanes * 64);
+			std::vector<uint8_t> hash(lanes * 128);
+			std::vector<uint32_t> mem(32 * 32 * lanes);
+
+			const auto time_begin = mmx::get_time_us();
+			for(int i = 0; i < count; i += lanes) {
+				switch(lanes) {
+					case 16:
+						mmx::pos::gen_mem_array_avx512_x16(mem.data(), key.data(), 32 * 32);
+						mmx::pos::calc_mem_hash_avx512_x16(mem.data(), hash.data(), mmx::pos::MEM_HASH_ITER);
+						break;
+					case 8:
+						mmx::pos::gen_mem_array_avx2_x8(mem.data(), key.data(), 32 * 32);
+						mmx::pos::calc_mem_hash_avx2_x8(mem.data(), hash.data(), mmx::pos::MEM_HASH_ITER);
+						break;
+					default:
+						mmx::pos::gen_mem_array(mem.data(), key.data(), 32 * 32);
+						mmx::pos::calc_mem_hash(mem.data(), hash.data(), mmx::pos::MEM_HASH_ITER);
+				}
+				::memcpy(key.data(), hash.data(), key.size());
+			}
+			const auto elapsed = std::max<int64_t>(mmx::get_time_us() - time_begin, 1) / 1e6;
+			std::cout << "F1 mem_hash x" << lanes << ": " << int64_t(count / elapsed) << " / sec" << (lanes == max_lanes ? " (active)" : "") << std::endl;
+		}
+	}
+
 	vnx::ThreadPool threads(num_threads, 1000);
 
 	mmx::hash_t plot_id;
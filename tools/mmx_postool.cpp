@@ -117,6 +117,7 @@ int main(int argc, char** argv)
 		try {
 			auto prover = std::make_shared<pos::Prover>(file_name);
 			prover->debug = debug;
+			prover->load_index();
 
 			std::cout << "--------------------------------------------------------------------------------" << std::endl;
 			std::cout << "Checking '" << file_name << "'" << std::endl;
@@ -128,6 +129,7 @@ int main(int argc, char** argv)
 				std::cout << "Plot ID: " << prover->get_plot_id().to_string() << std::endl;
 				std::cout << "Farmer Key: " << header->farmer_key.to_string() << std::endl;
 				std::cout << "Contract: " << (header->contract ? header->contract->to_string() : std::string("N/A")) << std::endl;
+				std::cout << "Y index: " << prover->get_index_size() / 1024. << " KiB" << std::endl;
 			}
 			out->valid = true;
 
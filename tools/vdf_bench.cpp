@@ -0,0 +1,94 @@
+#include <mmx/hash_t.hpp>
+#include <sha256_ni.h>
+#include <sha256_arm.h>
+#include <sha256_avx2.h>
+#include <sha256_avx512.h>
+#include <vnx/vnx.h>
+
+#include <functional>
+
+
+int main(int argc, char** argv)
+{
+	std::map<std::string, std::string> options;
+	options["n"] = "iters";
+	options["s"] = "segments";
+	options["iters"] = "iterations per segment";
+	options["segments"] = "number of segments";
+
+	vnx::write_config("log_level", 2);
+
+	vnx::init("vdf_bench", argc, argv, options);
+
+	int num_iters = 250000;
+	int num_segments = 64;
+
+	vnx::read_config("iters", num_iters);
+	vnx::read_config("segments", num_segments);
+
+	num_segments = ((std::max(num_segments, 16) + 15) / 16) * 16;
+
+	std::cout << "Iterations: " << num_iters << std::endl;
+	std::cout << "Segments: " << num_segments << std::endl;
+
+	std::vector<mmx::hash_t> input(num_segments);
+	for(int i = 0; i < num_segments; ++i) {
+		input[i] = mmx::hash_t(std::to_string(i));
+	}
+
+	// reference outputs for some lanes
+	std::map<int, mmx::hash_t> expected;
+	for(const int i : {0, 1, 3, 7, 15, num_segments - 1}) {
+		auto hash = input[i];
+		for(int k = 0; k < num_iters; ++k) {
+			hash = mmx::hash_t(hash.bytes);
+		}
+		expected[i] = hash;
+	}
+
+	struct kernel_t {
+		std::string name;
+		int lanes = 0;
+		bool available = false;
+		std::function<void(uint8_t*, uint64_t)> func;
+	};
+	const std::vector<kernel_t> kernels = {
+		{"sha-ni x1", 1, sha256_ni_available(), recursive_sha256_ni},
+		{"sha-ni x2", 2, sha256_ni_available(), recursive_sha256_ni_x2},
+		{"sha-ni x4", 4, sha256_ni_available(), recursive_sha256_ni_x4},
+		{"arm x1", 1, sha256_arm_available(), recursive_sha256_arm},
+		{"arm x2", 2, sha256_arm_available(), recursive_sha256_arm_x2},
+		{"avx2 x8", 8, avx2_available(), recursive_sha256_avx2_x8},
+		{"avx512 x16", 16, avx512_available(), recursive_sha256_avx512_x16},
+	};
+
+	for(const auto& kernel : kernels)
+	{
+		if(!kernel.available) {
+			std::cout << kernel.name << ": not available" << std::endl;
+			continue;
+		}
+		std::vector<uint8_t> data(num_segments * 32);
+		for(int i = 0; i < num_segments; ++i) {
+			::memcpy(data.data() + i * 32, input[i].data(), 32);
+		}
+		const auto time_begin = vnx::get_wall_time_micros();
+
+		for(int i = 0; i < num_segments; i += kernel.lanes) {
+			kernel.func(data.data() + i * 32, num_iters);
+		}
+		const auto elapsed = (vnx::get_wall_time_micros() - time_begin) / 1e6;
+
+		bool valid = true;
+		for(const auto& entry : expected) {
+			valid = valid && ::memcmp(data.data() + entry.first * 32, entry.second.data(), 32) == 0;
+		}
+		std::cout << kernel.name << ": " << num_segments / elapsed << " segments/s, "
+				<< (uint64_t(num_segments) * num_iters / elapsed) / 1e6 << " MH/s"
+				<< (valid ? "" : " (INVALID OUTPUT)") << std::endl;
+	}
+
+	vnx::close();
+
+	return 0;
+}
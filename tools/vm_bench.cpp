@@ -0,0 +1,57 @@
+#include <mmx/vm/Engine.h>
+#include <mmx/vm/StorageRAM.h>
+#include <mmx/addr_t.hpp>
+
+#include <vnx/vnx.h>
+
+#include <iostream>
+
+using namespace mmx;
+
+
+int main(int argc, char** argv)
+{
+	std::map<std::string, std::string> options;
+	options["n"] = "iters";
+	options["iters"] = "loop iterations";
+
+	vnx::write_config("log_level", 2);
+
+	vnx::init("vm_bench", argc, argv, options);
+
+	uint64_t num_iter = 1000000;
+	vnx::read_config("iters", num_iter);
+
+	auto backend = std::make_shared<vm::StorageRAM>();
+	auto engine = std::make_shared<vm::Engine>(addr_t(), backend, false, 1);
+	engine->gas_limit = uint64_t(1) << 40;
+	engine->write(vm::MEM_CONST + 1, vm::uint_t(1));
+	engine->write(vm::MEM_CONST + 2, vm::uint_t(num_iter));
+	engine->write(vm::MEM_CONST + 3, vm::uint_t(0));
+
+	auto& code = engine->code;
+	code.emplace_back(vm::OP_COPY, 0, vm::MEM_STACK + 1, vm::MEM_CONST + 3);
+	code.emplace_back(vm::OP_ADD, 0, vm::MEM_STACK + 1, vm::MEM_STACK + 1, vm::MEM_CONST + 1);
+	code.emplace_back(vm::OP_XOR, 0, vm::MEM_STACK + 2, vm::MEM_STACK + 1, vm::MEM_CONST + 2);
+	code.emplace_back(vm::OP_CMP_LT, 0, vm::MEM_STACK + 3, vm::MEM_STACK + 1, vm::MEM_CONST + 2);
+	code.emplace_back(vm::OP_JUMPI, 0, 1, vm::MEM_STACK + 3);
+	code.emplace_back(vm::OP_COPY, 0, vm::MEM_STATIC + 1, vm::MEM_STACK + 1);
+	code.emplace_back(vm::OP_RET);
+	engine->init();
+	engine->begin(0);
+
+	const auto time_begin = vnx::get_time_micros();
+	engine->run();
+	const auto elapsed = (vnx::get_time_micros() - time_begin) / 1e6;
+
+	const vm::uint_t result(num_iter);
+	if(vm::compare(engine->read(vm::MEM_STATIC + 1), &result)) {
+		std::cout << "Wrong result: " << vm::to_string(engine->read(vm::MEM_STATIC + 1)) << std::endl;
+		return -1;
+	}
+	const auto num_instr = 3 + 4 * num_iter;
+	std::cout << "exec: " << num_instr / elapsed / 1e6 << " M instr/s (" << num_instr << " in " << elapsed << " sec)" << std::endl;
+
+	vnx::close();
+	return 0;
+}